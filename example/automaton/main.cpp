@@ -206,8 +206,8 @@ void load_automaton(std::istream& is, Automaton& a)
  * \param pattern The pattern to check.
  * \param a The automaton.
  */
-bool valid_pattern(const std::string& pattern,
-                   const claw::automaton<int, char>& a)
+template <typename Automaton>
+bool valid_pattern(const std::string& pattern, const Automaton& a)
 {
   return a.match(pattern.begin(), pattern.end());
 }
@@ -226,15 +226,37 @@ int main(int argc, char* argv[])
       else
         {
           claw::automaton<int, char> a;
+          claw::automaton<int, char>::determinized_type minimal;
+          claw::compiled_automaton<char> compiled;
 
           load_automaton(f, a);
           print_automaton(std::cout, a) << std::endl;
 
+          a.minimize(minimal);
+          std::cout << "Minimal deterministic automaton:" << std::endl;
+          print_automaton(std::cout, minimal) << std::endl;
+
+          a.compile(compiled);
+
           for(int i = 2; i != argc; ++i)
-            if(valid_pattern(argv[i], a))
-              std::cout << argv[i] << ": valid" << std::endl;
-            else
-              std::cout << argv[i] << ": not valid" << std::endl;
+            {
+              const bool valid(valid_pattern(argv[i], a));
+
+              if(valid)
+                std::cout << argv[i] << ": valid" << std::endl;
+              else
+                std::cout << argv[i] << ": not valid" << std::endl;
+
+              if(valid != valid_pattern(argv[i], minimal))
+                std::cout << argv[i]
+                          << ": the minimal automaton does not agree"
+                          << std::endl;
+
+              if(valid != valid_pattern(argv[i], compiled))
+                std::cout << argv[i]
+                          << ": the compiled automaton does not agree"
+                          << std::endl;
+            }
         }
     }
 
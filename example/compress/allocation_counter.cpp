@@ -0,0 +1,125 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file allocation_counter.cpp
+ * \brief Replacement of the global operators new and delete counting the
+ *        allocations.
+ *
+ * All the forms of the operators using the default alignment are replaced,
+ * such that every memory block allocated with malloc() is released with
+ * free().
+ */
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/** \brief The number of calls to operator new since the program started. */
+static std::atomic<std::size_t> g_allocations(0);
+
+/**
+ * \brief Allocate a block of memory and count it.
+ * \param size The size of the block.
+ * \return The block, or NULL if there is not enough memory.
+ */
+static void* counted_allocate(std::size_t size) noexcept
+{
+  ++g_allocations;
+
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+/**
+ * \brief Allocate a block of memory and count it, or throw std::bad_alloc.
+ * \param size The size of the block.
+ */
+static void* counted_allocate_or_throw(std::size_t size)
+{
+  void* const result = counted_allocate(size);
+
+  if(result == NULL)
+    throw std::bad_alloc();
+
+  return result;
+}
+
+/**
+ * \brief Get the number of calls to operator new since the program started.
+ */
+std::size_t allocation_count()
+{
+  return g_allocations;
+}
+
+void* operator new(std::size_t size)
+{
+  return counted_allocate_or_throw(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return counted_allocate_or_throw(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counted_allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
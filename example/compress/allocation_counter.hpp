@@ -0,0 +1,39 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file allocation_counter.hpp
+ * \brief Count the calls to the global operator new.
+ *
+ * The replacements of the operators are defined in their own compilation
+ * unit, such that they are never inlined in the code calling them.
+ */
+#ifndef __CLAW_EXAMPLE_ALLOCATION_COUNTER_HPP__
+#define __CLAW_EXAMPLE_ALLOCATION_COUNTER_HPP__
+
+#include <cstddef>
+
+std::size_t allocation_count();
+
+#endif // __CLAW_EXAMPLE_ALLOCATION_COUNTER_HPP__
@@ -0,0 +1,551 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file benchmark.cpp
+ * \brief Measure the throughput, the compression ratio and the number of
+ *        allocations of the codecs of claw on several kinds of data.
+ *
+ * Usage: ex-compress-benchmark [--tsv] [--size MiB]
+ *
+ * With --tsv, the results are printed as tab separated values with a header
+ * line, to be compared from a run to the other.
+ */
+#include <claw/bit_istream.hpp>
+#include <claw/bit_ostream.hpp>
+#include <claw/block_codec.hpp>
+#include <claw/block_compressor.hpp>
+#include <claw/block_decompressor.hpp>
+#include <claw/buffered_istream.hpp>
+#include <claw/buffered_ostream.hpp>
+#include <claw/huffman_decoder.hpp>
+#include <claw/huffman_encoder.hpp>
+
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Some data on which the codecs are measured.
+ */
+struct corpus
+{
+  /** \brief The name of the corpus in the results. */
+  std::string name;
+
+  /** \brief The bytes of the corpus. */
+  std::vector<char> data;
+};
+
+/**
+ * \brief The measures of an operation on a corpus.
+ */
+struct measure
+{
+  /** \brief The name of the measured codec. */
+  std::string codec;
+
+  /** \brief The name of the corpus. */
+  std::string corpus;
+
+  /** \brief The name of the operation. */
+  std::string operation;
+
+  /** \brief The number of uncompressed megabytes processed per second. */
+  double throughput;
+
+  /** \brief The size of the uncompressed data divided by the size of the
+      compressed data. */
+  double ratio;
+
+  /** \brief The number of allocations per uncompressed megabyte. */
+  double allocations;
+};
+
+/**
+ * \brief Bytes uniformly distributed.
+ * \param size The size of the corpus.
+ */
+corpus make_random(std::size_t size)
+{
+  corpus result;
+  result.name = "random";
+  result.data.resize(size);
+
+  for(std::size_t i = 0; i != size; ++i)
+    result.data[i] = std::rand() & 0xFF;
+
+  return result;
+}
+
+/**
+ * \brief Words picked in a small vocabulary, the first ones being more
+ *        frequent, separated with spaces and line breaks.
+ * \param size The size of the corpus.
+ */
+corpus make_text(std::size_t size)
+{
+  static const char* const words[] = {
+    "the",   "of",       "and",     "a",      "to",      "in",
+    "is",    "that",     "for",     "it",     "with",    "as",
+    "was",   "on",       "data",    "stream", "buffer",  "library",
+    "image", "compress", "decoder", "symbol", "pattern", "dictionary"
+  };
+  const std::size_t count = sizeof(words) / sizeof(words[0]);
+
+  corpus result;
+  result.name = "text";
+  result.data.reserve(size + 16);
+
+  while(result.data.size() < size)
+    {
+      const std::size_t i = (std::rand() % count) * (std::rand() % count);
+      const char* const w = words[i / count];
+
+      result.data.insert(result.data.end(), w, w + std::strlen(w));
+      result.data.push_back((std::rand() % 12 == 0) ? '\n' : ' ');
+    }
+
+  result.data.resize(size);
+  return result;
+}
+
+/**
+ * \brief Runs of 1 to 64 copies of one of sixteen bytes.
+ * \param size The size of the corpus.
+ */
+corpus make_runs(std::size_t size)
+{
+  corpus result;
+  result.name = "runs";
+  result.data.reserve(size);
+
+  while(result.data.size() != size)
+    {
+      const char s = std::rand() % 16;
+      const std::size_t length =
+          std::min<std::size_t>(1 + std::rand() % 64, size - result.data.size());
+
+      result.data.insert(result.data.end(), length, s);
+    }
+
+  return result;
+}
+
+/**
+ * \brief The RGBA pixels of a picture made of smooth gradients with some
+ *        noise and flat areas.
+ * \param size The size of the corpus.
+ */
+corpus make_image(std::size_t size)
+{
+  const std::size_t width = 1024;
+
+  corpus result;
+  result.name = "image";
+  result.data.resize(size);
+
+  for(std::size_t i = 0; i + 4 <= size; i += 4)
+    {
+      const std::size_t x = (i / 4) % width;
+      const std::size_t y = (i / 4) / width;
+      const bool flat = ((x / 128 + y / 128) % 3) == 0;
+      const int noise = flat ? 0 : std::rand() % 4;
+
+      result.data[i] = (x / 4 + noise) & 0xFF;
+      result.data[i + 1] = (y / 4 + noise) & 0xFF;
+      result.data[i + 2] = flat ? 128 : ((x + y) / 8) & 0xFF;
+      result.data[i + 3] = (char)255;
+    }
+
+  return result;
+}
+
+/**
+ * \brief Run an operation several times and measure the best run.
+ * \param f The operation.
+ * \param bytes The number of uncompressed bytes processed by the operation.
+ * \param m (out) The throughput and the allocations of the operation.
+ */
+template <typename F>
+void time_operation(F f, std::size_t bytes, measure& m)
+{
+  const unsigned int runs = 3;
+  double best = 0;
+  std::size_t allocations = 0;
+
+  for(unsigned int i = 0; i != runs; ++i)
+    {
+      const std::size_t allocations_before = allocation_count();
+      const std::chrono::steady_clock::time_point begin =
+          std::chrono::steady_clock::now();
+
+      f();
+
+      const std::chrono::duration<double> d(std::chrono::steady_clock::now()
+                                            - begin);
+
+      if((i == 0) || (d.count() < best))
+        best = d.count();
+
+      if(i == 0)
+        allocations = allocation_count() - allocations_before;
+    }
+
+  const double megabytes = (double)bytes / (1024 * 1024);
+
+  m.throughput = megabytes / best;
+  m.allocations = allocations / megabytes;
+}
+
+/**
+ * \brief Measure the compression and the decompression of a corpus with a
+ *        block codec.
+ * \param name The name of the codec.
+ * \param c The corpus.
+ * \param result (out) The measures are added at the end of this vector.
+ */
+template <typename Codec>
+void run_codec(const std::string& name, const corpus& c,
+               std::vector<measure>& result)
+{
+  const char* const first = c.data.data();
+  const char* const last = first + c.data.size();
+  std::vector<char> compressed;
+  std::vector<char> uncompressed(c.data.size());
+  Codec codec;
+
+  measure m;
+  m.codec = name;
+  m.corpus = c.name;
+
+  m.operation = "encode";
+  time_operation(
+      [&]() -> void
+      {
+        compressed.clear();
+        codec.encode(first, last, compressed);
+      },
+      c.data.size(), m);
+  m.ratio = (double)c.data.size() / compressed.size();
+  result.push_back(m);
+
+  std::size_t size = 0;
+
+  m.operation = "decode";
+  time_operation(
+      [&]() -> void
+      {
+        size = codec.decode(compressed.data(),
+                            compressed.data() + compressed.size(),
+                            uncompressed.data(), uncompressed.size());
+      },
+      c.data.size(), m);
+  result.push_back(m);
+
+  if((size != c.data.size()) || (uncompressed != c.data))
+    std::cerr << name << ": the decoded " << c.name
+              << " corpus differs from the original." << std::endl;
+}
+
+/**
+ * \brief Measure the compression and the decompression of a corpus with a
+ *        canonical Huffman code of its bytes.
+ * \param name The name of the codec.
+ * \param c The corpus.
+ * \param result (out) The measures are added at the end of this vector.
+ *
+ * The compressed size includes the lengths of the codes, stored on one byte
+ * per symbol.
+ */
+template <claw::bit_order Order>
+void run_huffman(const std::string& name, const corpus& c,
+                 std::vector<measure>& result)
+{
+  std::string bytes;
+  claw::huffman_code code;
+
+  measure m;
+  m.codec = name;
+  m.corpus = c.name;
+
+  m.operation = "encode";
+  time_operation(
+      [&]() -> void
+      {
+        std::vector<std::size_t> frequencies(256, 0);
+
+        for(std::size_t i = 0; i != c.data.size(); ++i)
+          ++frequencies[(unsigned char)c.data[i]];
+
+        code.build(frequencies);
+
+        std::ostringstream os;
+
+        {
+          claw::buffered_ostream<std::ostream> buffer(os);
+          claw::bit_ostream<claw::buffered_ostream<std::ostream>, Order>
+              stream(buffer);
+          claw::huffman_encoder<Order> encoder(code);
+
+          encoder.encode(c.data.begin(), c.data.end(), stream);
+        }
+
+        bytes = os.str();
+      },
+      c.data.size(), m);
+  m.ratio = (double)c.data.size() / (bytes.size() + code.symbols_count());
+  result.push_back(m);
+
+  std::vector<char> uncompressed(c.data.size());
+
+  m.operation = "decode";
+  time_operation(
+      [&]() -> void
+      {
+        std::istringstream is(bytes);
+        claw::buffered_istream<std::istream> buffer(is);
+        claw::bit_istream<claw::buffered_istream<std::istream>, Order> stream(
+            buffer);
+        const claw::huffman_decoder<Order> decoder(
+            claw::huffman_code(code.get_lengths()));
+
+        decoder.decode(stream, uncompressed.size(), uncompressed.begin());
+      },
+      c.data.size(), m);
+  result.push_back(m);
+
+  if(uncompressed != c.data)
+    std::cerr << name << ": the decoded " << c.name
+              << " corpus differs from the original." << std::endl;
+}
+
+/**
+ * \brief Measure the compression and the decompression of a corpus in
+ *        blocks, with one thread per core.
+ * \param name The name of the codec.
+ * \param c The corpus.
+ * \param result (out) The measures are added at the end of this vector.
+ */
+template <typename Codec>
+void run_blocks(const std::string& name, const corpus& c,
+                std::vector<measure>& result)
+{
+  claw::thread_pool pool;
+  std::string file;
+  std::vector<char> uncompressed;
+
+  measure m;
+  m.codec = name;
+  m.corpus = c.name;
+
+  m.operation = "encode";
+  time_operation(
+      [&]() -> void
+      {
+        std::ostringstream os;
+
+        {
+          claw::block_compressor<Codec> compressor(os, pool);
+          compressor.write(c.data.data(), c.data.size());
+        }
+
+        file = os.str();
+      },
+      c.data.size(), m);
+  m.ratio = (double)c.data.size() / file.size();
+  result.push_back(m);
+
+  m.operation = "decode";
+  time_operation(
+      [&]() -> void
+      {
+        std::istringstream is(file);
+        claw::block_decompressor<Codec> decompressor(is);
+        decompressor.read(uncompressed, pool);
+      },
+      c.data.size(), m);
+  result.push_back(m);
+
+  if(uncompressed != c.data)
+    std::cerr << name << ": the decoded " << c.name
+              << " corpus differs from the original." << std::endl;
+}
+
+/**
+ * \brief Write then read codes of 9 to 12 bits with a bit_ostream and a
+ *        bit_istream.
+ * \param name The name of the bit order.
+ * \param c The corpus from which the codes are built.
+ * \param result (out) The measures are added at the end of this vector.
+ */
+template <claw::bit_order Order>
+void run_bits(const std::string& name, const corpus& c,
+              std::vector<measure>& result)
+{
+  const std::size_t count = c.data.size() / 2;
+  std::vector<unsigned int> codes(count);
+
+  for(std::size_t i = 0; i != count; ++i)
+    codes[i] = ((unsigned char)c.data[2 * i] << 4 | c.data[2 * i + 1])
+               & ((1 << (9 + i % 4)) - 1);
+
+  std::string bytes;
+  measure m;
+  m.codec = name;
+  m.corpus = c.name;
+  m.ratio = 1;
+
+  m.operation = "write";
+  time_operation(
+      [&]() -> void
+      {
+        std::ostringstream os;
+
+        {
+          claw::buffered_ostream<std::ostream> buffer(os);
+          claw::bit_ostream<claw::buffered_ostream<std::ostream>, Order>
+              stream(buffer);
+
+          for(std::size_t i = 0; i != count; ++i)
+            stream.write_bits(codes[i], 9 + i % 4);
+        }
+
+        bytes = os.str();
+      },
+      (count / 4) * (9 + 10 + 11 + 12) / 8, m);
+  result.push_back(m);
+
+  bool valid = true;
+
+  m.operation = "read";
+  time_operation(
+      [&]() -> void
+      {
+        std::istringstream is(bytes);
+        claw::buffered_istream<std::istream> buffer(is);
+        claw::bit_istream<claw::buffered_istream<std::istream>, Order> stream(
+            buffer);
+
+        for(std::size_t i = 0; i != count; ++i)
+          valid &= (stream.read_bits(9 + i % 4) == codes[i]);
+      },
+      (count / 4) * (9 + 10 + 11 + 12) / 8, m);
+  result.push_back(m);
+
+  if(!valid)
+    std::cerr << name << ": the codes read from the " << c.name
+              << " corpus differ from the written ones." << std::endl;
+}
+
+/**
+ * \brief Print the measures in a table.
+ * \param measures The measures to print.
+ */
+void print_table(const std::vector<measure>& measures)
+{
+  std::printf("%-12s %-8s %-10s %12s %8s %12s\n", "codec", "corpus",
+              "operation", "MB/s", "ratio", "allocs/MB");
+
+  for(std::size_t i = 0; i != measures.size(); ++i)
+    {
+      const measure& m = measures[i];
+      std::printf("%-12s %-8s %-10s %12.2f %8.3f %12.2f\n", m.codec.c_str(),
+                  m.corpus.c_str(), m.operation.c_str(), m.throughput,
+                  m.ratio, m.allocations);
+    }
+}
+
+/**
+ * \brief Print the measures as tab separated values.
+ * \param measures The measures to print.
+ */
+void print_tsv(const std::vector<measure>& measures)
+{
+  std::printf("codec\tcorpus\toperation\tmb_per_s\tratio\tallocs_per_mb\n");
+
+  for(std::size_t i = 0; i != measures.size(); ++i)
+    {
+      const measure& m = measures[i];
+      std::printf("%s\t%s\t%s\t%.3f\t%.4f\t%.3f\n", m.codec.c_str(),
+                  m.corpus.c_str(), m.operation.c_str(), m.throughput,
+                  m.ratio, m.allocations);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+  bool tsv = false;
+  std::size_t size = 16;
+
+  for(int i = 1; i != argc; ++i)
+    if(std::strcmp(argv[i], "--tsv") == 0)
+      tsv = true;
+    else if((std::strcmp(argv[i], "--size") == 0) && (i + 1 != argc))
+      size = std::strtoul(argv[++i], NULL, 10);
+    else
+      {
+        std::cerr << "Usage: " << argv[0] << " [--tsv] [--size MiB]"
+                  << std::endl;
+        return 1;
+      }
+
+  size *= 1024 * 1024;
+
+  std::srand(0);
+
+  std::vector<corpus> corpora;
+  corpora.push_back(make_random(size));
+  corpora.push_back(make_text(size));
+  corpora.push_back(make_runs(size));
+  corpora.push_back(make_image(size));
+
+  std::vector<measure> measures;
+
+  for(std::size_t i = 0; i != corpora.size(); ++i)
+    {
+      run_codec<claw::lzw_block_codec>("lzw", corpora[i], measures);
+      run_codec<claw::rle_block_codec>("rle", corpora[i], measures);
+      run_huffman<claw::lsb_first>("huffman-lsb", corpora[i], measures);
+      run_huffman<claw::msb_first>("huffman-msb", corpora[i], measures);
+      run_blocks<claw::lzw_block_codec>("lzw-blocks", corpora[i], measures);
+      run_bits<claw::lsb_first>("bits-lsb", corpora[i], measures);
+      run_bits<claw::msb_first>("bits-msb", corpora[i], measures);
+    }
+
+  if(tsv)
+    print_tsv(measures);
+  else
+    print_table(measures);
+
+  return 0;
+}
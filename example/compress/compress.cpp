@@ -22,53 +22,12 @@
 
   contact: julien.jorge@stuff-o-matic.com
 */
-#include <cassert>
 #include <claw/bit_ostream.hpp>
-#include <claw/buffered_istream.hpp>
 #include <claw/buffered_ostream.hpp>
-#include <claw/lzw_encoder.hpp>
-#include <fstream>
+#include <claw/lzw_push_encoder.hpp>
 #include <iostream>
 #include <limits>
 
-/**
- * \brief The input_buffer is the stream where raw data is read by the LZW
- *        encoder.
- */
-class input_buffer
-{
-public:
-  input_buffer(std::istream& is)
-    : stream(is)
-  {
-    stream.read_more(1024);
-  }
-
-  bool end_of_data() const
-  {
-    return !stream;
-  }
-  unsigned int symbols_count() const
-  {
-    return (unsigned int)std::numeric_limits<unsigned char>::max() + 2;
-  }
-
-  unsigned int get_next()
-  {
-    assert(stream.remaining() > 0);
-
-    unsigned int result = (unsigned char)stream.get_next();
-
-    if(stream.remaining() == 0)
-      stream.read_more(1024);
-
-    return result;
-  }
-
-private:
-  claw::buffered_istream<std::istream> stream;
-};
-
 /**
  * \brief The output_buffer is an interface between the LZW encoder and the
  *        stream where the encoded data is written.
@@ -106,7 +65,13 @@ public:
 
   void write(unsigned int code)
   {
-    stream.write((char*)&code, m_code_size);
+    stream.write_bits(code, m_code_size);
+  }
+
+  void end_of_dictionary()
+  {
+    write(256);
+    reset();
   }
 
 private:
@@ -129,16 +94,20 @@ int main(int argc, char* argv[])
     }
   else
     {
-      claw::lzw_encoder<input_buffer, output_buffer> encoder;
-      input_buffer input(std::cin);
       output_buffer output(std::cout, 4096);
+      claw::lzw_push_encoder<output_buffer> encoder(
+          output, (unsigned int)std::numeric_limits<unsigned char>::max() + 2);
+      char buffer[4096];
 
-      while(!input.end_of_data())
+      // The data is given to the encoder as it is read.
+      while(std::cin.read(buffer, sizeof(buffer)) || (std::cin.gcount() != 0))
         {
-          output.reset();
-          encoder.encode(input, output);
-          output.write(256);
+          const unsigned char* first =
+              reinterpret_cast<const unsigned char*>(buffer);
+          encoder.push(first, first + std::cin.gcount());
         }
+
+      encoder.finish();
     }
 
   return 0;
@@ -1,100 +1,105 @@
-#include <cassert>
-#include <claw/bit_istream.hpp>
-#include <claw/buffered_istream.hpp>
 #include <claw/buffered_ostream.hpp>
-#include <claw/lzw_decoder.hpp>
+#include <claw/lzw_push_decoder.hpp>
 #include <iostream>
 #include <limits>
 
-class input_buffer
+class output_buffer
 {
 public:
-  input_buffer(std::istream& is)
-    : val(0)
-    , buffer(is)
-    , stream(buffer)
-    , m_code_size(9)
-    , m_code_limit(1 << m_code_size)
+  output_buffer(std::ostream& os)
+    : stream(os)
   {}
 
-  bool end_of_data() const
+  void write(unsigned int code)
   {
-    return !stream || (val == 256);
+    const char v(code);
+    stream.write(v);
   }
 
-  unsigned int symbols_count() const
+private:
+  claw::buffered_ostream<std::ostream> stream;
+};
+
+/**
+ * \brief The code_reader cuts the bytes it receives in codes of variable
+ *        length and passes them to the decoder.
+ */
+class code_reader
+{
+public:
+  explicit code_reader(claw::lzw_push_decoder<output_buffer>& decoder)
+    : m_decoder(decoder)
+    , m_bits(0)
+    , m_length(0)
   {
-    return (unsigned int)std::numeric_limits<unsigned char>::max() + 2;
+    reset();
   }
 
-  unsigned int get_next()
+  void push(const char* first, const char* last)
   {
-    val = 0;
-    stream.read(reinterpret_cast<char*>(&val), m_code_size);
-    return val;
+    for(; first != last; ++first)
+      {
+        m_bits |= (unsigned long long)(unsigned char)*first << m_length;
+        m_length += 8;
+
+        while(m_length >= m_code_size)
+          {
+            const unsigned int code = m_bits & ((1 << m_code_size) - 1);
+            m_bits >>= m_code_size;
+            m_length -= m_code_size;
+
+            decode(code);
+          }
+      }
   }
 
+private:
   void reset()
   {
-    val = 0;
     m_code_size = 9;
     m_code_limit = 1 << m_code_size;
   }
 
-  void new_code(unsigned int code)
+  void decode(unsigned int code)
   {
-    if((code == m_code_limit) && (m_code_size != 12))
+    if(code == 256)
       {
-        ++m_code_size;
-        m_code_limit = 1 << m_code_size;
+        m_decoder.reset();
+        reset();
+      }
+    else
+      {
+        m_decoder.push(code);
+
+        if((m_decoder.code_count() == m_code_limit) && (m_code_size != 12))
+          {
+            ++m_code_size;
+            m_code_limit = 1 << m_code_size;
+          }
       }
   }
 
 private:
-  unsigned int val;
-  claw::buffered_istream<std::istream> buffer;
-  claw::bit_istream<claw::buffered_istream<std::istream> > stream;
+  claw::lzw_push_decoder<output_buffer>& m_decoder;
+
+  unsigned long long m_bits;
+  unsigned int m_length;
 
   unsigned int m_code_size;
   unsigned int m_code_limit;
 };
 
-class output_buffer
-{
-public:
-  output_buffer(std::ostream& os, unsigned int max)
-    : stream(os)
-    , m_max_code(max)
-  {}
-
-  unsigned int max_code() const
-  {
-    return m_max_code;
-  }
-
-  void write(unsigned int code)
-  {
-    assert(code < 256);
-    const char v(code);
-    stream.write(v);
-  }
-
-private:
-  claw::buffered_ostream<std::ostream> stream;
-  const unsigned int m_max_code;
-};
-
 int main()
 {
-  claw::lzw_decoder<input_buffer, output_buffer> decoder;
-  input_buffer input(std::cin);
-  output_buffer output(std::cout, 4096);
-
-  while(std::cin)
-    {
-      input.reset();
-      decoder.decode(input, output);
-    }
+  output_buffer output(std::cout);
+  claw::lzw_push_decoder<output_buffer> decoder(
+      output, (unsigned int)std::numeric_limits<unsigned char>::max() + 2);
+  code_reader reader(decoder);
+  char buffer[4096];
+
+  // The codes are decoded as the data is read.
+  while(std::cin.read(buffer, sizeof(buffer)) || (std::cin.gcount() != 0))
+    reader.push(buffer, buffer + std::cin.gcount());
 
   return 0;
 }
@@ -0,0 +1,1213 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file benchmark.cpp
+ * \brief Measure the throughput of the pixel operations of claw::graphic.
+ *
+ * Usage: ex-image-benchmark [--tsv] [--threads]
+ *
+ * With --tsv, the results are printed as tab separated values with a header
+ * line, to be compared from a run to the other. With --threads, the scaling
+ * of the row-parallel operations is measured on 8K images, and the one of the
+ * loading of a batch of sprites, from one thread to twice the number of
+ * cores.
+ */
+#include <claw/graphic/batch_loader.hpp>
+#include <claw/graphic/bitmap.hpp>
+#include <claw/graphic/gif.hpp>
+#include <claw/graphic/image.hpp>
+#include <claw/graphic/image_view.hpp>
+#include <claw/graphic/pcx.hpp>
+#include <claw/graphic/pixel_kernels.hpp>
+#include <claw/graphic/premultiplied_image.hpp>
+#include <claw/graphic/resampler.hpp>
+#include <claw/graphic/targa.hpp>
+#include <claw/graphic/xbm.hpp>
+#include <claw/imemory_stream.hpp>
+#include <claw/thread_pool.hpp>
+
+/* The png.h file must be included before any other file that includes setjmp.h
+   (as jpeg.hpp). */
+#include <claw/graphic/png.hpp>
+
+#include <claw/graphic/jpeg.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief The measures of an operation.
+ */
+struct measure
+{
+  /** \brief The name of the operation. */
+  std::string operation;
+
+  /** \brief The name of the implementation. */
+  std::string implementation;
+
+  /** \brief The number of millions of pixels processed per second. */
+  double throughput;
+};
+
+/**
+ * \brief A picture to draw on a frame, and its position.
+ */
+struct sprite
+{
+  /** \brief The picture. */
+  claw::graphic::image picture;
+
+  /** \brief The position of the top left corner of the picture in the
+      frame. */
+  claw::math::coordinate_2d<int> position;
+};
+
+/**
+ * \brief Create an image of random pixels.
+ * \param w The width of the image.
+ * \param h The height of the image.
+ *
+ * A third of the pixels are opaque, a third are fully transparent and the
+ * other ones are translucent, as in the sprites of a game.
+ */
+claw::graphic::image make_image(unsigned int w, unsigned int h)
+{
+  claw::graphic::image result(w, h);
+
+  for(claw::graphic::image::iterator it = result.begin(); it != result.end();
+      ++it)
+    {
+      it->components.red = std::rand() & 0xFF;
+      it->components.green = std::rand() & 0xFF;
+      it->components.blue = std::rand() & 0xFF;
+
+      switch(std::rand() % 3)
+        {
+        case 0:
+          it->components.alpha = 0;
+          break;
+        case 1:
+          it->components.alpha = 255;
+          break;
+        default:
+          it->components.alpha = std::rand() & 0xFF;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * \brief Create some sprites placed randomly on a frame, some of them being
+ *        partially out of the frame.
+ * \param count The number of sprites.
+ * \param frame_width The width of the frame.
+ * \param frame_height The height of the frame.
+ */
+std::vector<sprite> make_sprites(unsigned int count, unsigned int frame_width,
+                                 unsigned int frame_height)
+{
+  std::vector<sprite> result(count);
+
+  for(unsigned int i = 0; i != count; ++i)
+    {
+      result[i].picture = make_image(16 + std::rand() % 240,
+                                     16 + std::rand() % 240);
+      result[i].position.x = std::rand() % (frame_width + 64) - 32;
+      result[i].position.y = std::rand() % (frame_height + 64) - 32;
+    }
+
+  return result;
+}
+
+/**
+ * \brief Merge an image on an other one with the computation done by
+ *        image::merge() before it used the pixel kernels.
+ * \param dest The image on which the merge is done.
+ * \param that The image to merge.
+ * \param pos The position of the top left corner of \a that in \a dest.
+ */
+void merge_double(claw::graphic::image& dest, const claw::graphic::image& that,
+                  const claw::math::coordinate_2d<int>& pos)
+{
+  const claw::math::rectangle<int> my_box(0, 0, dest.width(), dest.height());
+  const claw::math::rectangle<int> his_box(pos.x, pos.y, that.width(),
+                                           that.height());
+
+  if(!my_box.intersects(his_box))
+    return;
+
+  const claw::math::rectangle<int> intersection(
+      my_box.intersection(his_box));
+  const unsigned int that_y = pos.y < 0 ? -pos.y : 0;
+  const unsigned int that_x = pos.x < 0 ? -pos.x : 0;
+  const double max_comp(255);
+
+  for(int y = 0; y != intersection.height; ++y)
+    {
+      const claw::graphic::rgba_pixel* first =
+          that[y + that_y].begin() + that_x;
+      const claw::graphic::rgba_pixel* last = first + intersection.width;
+      claw::graphic::rgba_pixel* d =
+          dest[y + intersection.position.y].begin() + intersection.position.x;
+
+      for(; first != last; ++first, ++d)
+        {
+          const double src_alpha(first->components.alpha);
+          const double dest_alpha(d->components.alpha
+                                  * (max_comp - src_alpha));
+
+          const double red = (double)first->components.red * src_alpha
+                             + (double)d->components.red * dest_alpha;
+          const double green = (double)first->components.green * src_alpha
+                               + (double)d->components.green * dest_alpha;
+          const double blue = (double)first->components.blue * src_alpha
+                              + (double)d->components.blue * dest_alpha;
+          const double alpha = src_alpha + dest_alpha;
+
+          d->components.red = std::min(red, max_comp);
+          d->components.green = std::min(green, max_comp);
+          d->components.blue = std::min(blue, max_comp);
+          d->components.alpha = std::min(alpha, max_comp);
+        }
+    }
+}
+
+/**
+ * \brief Merge an image on an other one with a given implementation of the
+ *        pixel kernels.
+ * \param dest The image on which the merge is done.
+ * \param that The image to merge.
+ * \param pos The position of the top left corner of \a that in \a dest.
+ * \param impl The implementation of the kernels.
+ */
+void merge_kernel(claw::graphic::image& dest, const claw::graphic::image& that,
+                  const claw::math::coordinate_2d<int>& pos,
+                  claw::graphic::pixel_kernels::implementation impl)
+{
+  const claw::math::rectangle<int> my_box(0, 0, dest.width(), dest.height());
+  const claw::math::rectangle<int> his_box(pos.x, pos.y, that.width(),
+                                           that.height());
+
+  if(!my_box.intersects(his_box))
+    return;
+
+  const claw::math::rectangle<int> intersection(
+      my_box.intersection(his_box));
+  const unsigned int that_y = pos.y < 0 ? -pos.y : 0;
+  const unsigned int that_x = pos.x < 0 ? -pos.x : 0;
+
+  for(int y = 0; y != intersection.height; ++y)
+    claw::graphic::pixel_kernels::merge(
+        dest[y + intersection.position.y].begin() + intersection.position.x,
+        that[y + that_y].begin() + that_x, intersection.width, impl);
+}
+
+/**
+ * \brief Fill a rectangle of an image with the computation done by
+ *        image::fill() before it used the pixel kernels.
+ * \param dest The image to fill.
+ * \param r The rectangle to fill.
+ * \param c The color to fill with.
+ */
+void fill_double(claw::graphic::image& dest,
+                 const claw::math::rectangle<int>& r,
+                 const claw::graphic::rgba_pixel& c)
+{
+  const claw::math::rectangle<int> my_box(0, 0, dest.width(), dest.height());
+
+  if(!my_box.intersects(r))
+    return;
+
+  const claw::math::rectangle<int> intersection(my_box.intersection(r));
+  const double max_comp(255);
+
+  for(int y = 0; y != intersection.height; ++y)
+    {
+      claw::graphic::rgba_pixel* first =
+          dest[intersection.position.y + y].begin() + intersection.position.x;
+      claw::graphic::rgba_pixel* const last = first + intersection.width;
+
+      for(; first != last; ++first)
+        {
+          const double src_alpha(c.components.alpha);
+
+          const double red = (double)first->components.red
+                             + src_alpha * (double)c.components.red / max_comp;
+          const double green =
+              (double)first->components.green
+              + src_alpha * (double)c.components.green / max_comp;
+          const double blue =
+              (double)first->components.blue
+              + src_alpha * (double)c.components.blue / max_comp;
+          const double alpha = (double)first->components.alpha
+                               + (max_comp - src_alpha) / max_comp;
+
+          first->components.red = std::min(red, max_comp);
+          first->components.green = std::min(green, max_comp);
+          first->components.blue = std::min(blue, max_comp);
+          first->components.alpha = std::min(alpha, max_comp);
+        }
+    }
+}
+
+/**
+ * \brief Fill a rectangle of an image as image::fill() does, with a given
+ *        implementation of the pixel kernels.
+ * \param dest The image to fill.
+ * \param r The rectangle to fill.
+ * \param c The color to fill with.
+ * \param impl The implementation of the kernels.
+ */
+void fill_kernel(claw::graphic::image& dest,
+                 const claw::math::rectangle<int>& r,
+                 const claw::graphic::rgba_pixel& c,
+                 claw::graphic::pixel_kernels::implementation impl)
+{
+  const claw::math::rectangle<int> my_box(0, 0, dest.width(), dest.height());
+
+  if(!my_box.intersects(r))
+    return;
+
+  const claw::math::rectangle<int> intersection(my_box.intersection(r));
+  const unsigned int src_alpha(c.components.alpha);
+
+  claw::graphic::rgba_pixel increment;
+  increment.components.red = src_alpha * c.components.red / 255;
+  increment.components.green = src_alpha * c.components.green / 255;
+  increment.components.blue = src_alpha * c.components.blue / 255;
+  increment.components.alpha = (src_alpha == 0) ? 1 : 0;
+
+  for(int y = 0; y != intersection.height; ++y)
+    claw::graphic::pixel_kernels::add(
+        dest[intersection.position.y + y].begin() + intersection.position.x,
+        intersection.width, increment, impl);
+}
+
+/**
+ * \brief Run an operation several times and measure the best run.
+ * \param f The operation.
+ * \param pixels The number of pixels processed by the operation.
+ * \param m (out) The throughput of the operation.
+ */
+template <typename F>
+void time_operation(F f, std::size_t pixels, measure& m)
+{
+  const unsigned int runs = 5;
+  double best = 0;
+
+  for(unsigned int i = 0; i != runs; ++i)
+    {
+      const std::chrono::steady_clock::time_point begin =
+          std::chrono::steady_clock::now();
+
+      f();
+
+      const std::chrono::duration<double> d(std::chrono::steady_clock::now()
+                                            - begin);
+
+      if((i == 0) || (d.count() < best))
+        best = d.count();
+    }
+
+  m.throughput = (double)pixels / 1000000 / best;
+}
+
+/**
+ * \brief Count the pixels covered by some sprites in a frame.
+ * \param sprites The sprites.
+ * \param frame The frame.
+ */
+std::size_t covered_pixels(const std::vector<sprite>& sprites,
+                           const claw::graphic::image& frame)
+{
+  const claw::math::rectangle<int> box(0, 0, frame.width(), frame.height());
+  std::size_t result = 0;
+
+  for(std::size_t i = 0; i != sprites.size(); ++i)
+    {
+      const claw::math::rectangle<int> r(
+          sprites[i].position.x, sprites[i].position.y,
+          sprites[i].picture.width(), sprites[i].picture.height());
+
+      if(box.intersects(r))
+        result += box.intersection(r).area();
+    }
+
+  return result;
+}
+
+/**
+ * \brief Measure the composition of sprites on a 1080p frame.
+ * \param result (out) The measures are added at the end of this vector.
+ */
+void run_merge(std::vector<measure>& result)
+{
+  const claw::graphic::image background(make_image(1920, 1080));
+  const std::vector<sprite> sprites(
+      make_sprites(500, background.width(), background.height()));
+  const std::size_t pixels = covered_pixels(sprites, background);
+
+  claw::graphic::image reference;
+  claw::graphic::image frame;
+  measure m;
+  m.operation = "merge";
+
+  m.implementation = "double";
+  time_operation(
+      [&]() -> void
+      {
+        reference = background;
+
+        for(std::size_t i = 0; i != sprites.size(); ++i)
+          merge_double(reference, sprites[i].picture, sprites[i].position);
+      },
+      pixels, m);
+  result.push_back(m);
+
+  const char* const names[] = { "scalar", "sse2", "avx2" };
+  const claw::graphic::pixel_kernels::implementation best =
+      claw::graphic::pixel_kernels::best_implementation();
+
+  for(int impl = claw::graphic::pixel_kernels::scalar; impl <= best; ++impl)
+    {
+      m.implementation = names[impl];
+      time_operation(
+          [&]() -> void
+          {
+            frame = background;
+
+            for(std::size_t i = 0; i != sprites.size(); ++i)
+              merge_kernel(
+                  frame, sprites[i].picture, sprites[i].position,
+                  (claw::graphic::pixel_kernels::implementation)impl);
+          },
+          pixels, m);
+      result.push_back(m);
+
+      if(!std::equal(frame.begin(), frame.end(), reference.begin()))
+        std::cerr << "merge: the " << names[impl]
+                  << " implementation differs from the reference."
+                  << std::endl;
+    }
+
+  m.implementation = "image::merge";
+  time_operation(
+      [&]() -> void
+      {
+        frame = background;
+
+        for(std::size_t i = 0; i != sprites.size(); ++i)
+          frame.merge(sprites[i].picture, sprites[i].position);
+      },
+      pixels, m);
+  result.push_back(m);
+
+  // The pixels are premultiplied once, as when they are loaded, and the
+  // frame is composed with the source-over operator, whose result differs
+  // from the one of image::merge().
+  const claw::graphic::premultiplied_image premultiplied_background(
+      background);
+  std::vector<claw::graphic::premultiplied_image> premultiplied_sprites;
+  claw::graphic::premultiplied_image premultiplied_frame;
+
+  for(std::size_t i = 0; i != sprites.size(); ++i)
+    premultiplied_sprites.push_back(
+        claw::graphic::premultiplied_image(sprites[i].picture));
+
+  m.implementation = "premultiplied";
+  time_operation(
+      [&]() -> void
+      {
+        premultiplied_frame = premultiplied_background;
+
+        for(std::size_t i = 0; i != sprites.size(); ++i)
+          premultiplied_frame.merge(premultiplied_sprites[i],
+                                    sprites[i].position);
+      },
+      pixels, m);
+  result.push_back(m);
+}
+
+/**
+ * \brief Measure the filling of large rectangles of a 1080p frame.
+ * \param name The name of the operation.
+ * \param opaque Tell if the colors of the rectangles are opaque.
+ * \param result (out) The measures are added at the end of this vector.
+ */
+void run_fill(const std::string& name, bool opaque,
+              std::vector<measure>& result)
+{
+  const claw::graphic::image background(make_image(1920, 1080));
+  std::vector<claw::math::rectangle<int> > rectangles(100);
+  std::vector<claw::graphic::rgba_pixel> colors(rectangles.size());
+  std::size_t pixels = 0;
+
+  for(std::size_t i = 0; i != rectangles.size(); ++i)
+    {
+      rectangles[i].position.x = std::rand() % background.width() - 100;
+      rectangles[i].position.y = std::rand() % background.height() - 100;
+      rectangles[i].width = 200 + std::rand() % 1000;
+      rectangles[i].height = 100 + std::rand() % 700;
+
+      colors[i] = claw::graphic::rgba_pixel(std::rand() % 64, std::rand() % 64,
+                                            std::rand() % 64,
+                                            opaque ? 255 : std::rand() % 256);
+
+      const claw::math::rectangle<int> box(0, 0, background.width(),
+                                           background.height());
+      pixels += box.intersection(rectangles[i]).area();
+    }
+
+  claw::graphic::image reference;
+  claw::graphic::image frame;
+  measure m;
+  m.operation = name;
+
+  m.implementation = "double";
+  time_operation(
+      [&]() -> void
+      {
+        reference = background;
+
+        for(std::size_t i = 0; i != rectangles.size(); ++i)
+          fill_double(reference, rectangles[i], colors[i]);
+      },
+      pixels, m);
+  result.push_back(m);
+
+  const char* const names[] = { "scalar", "sse2", "avx2" };
+  const claw::graphic::pixel_kernels::implementation best =
+      claw::graphic::pixel_kernels::best_implementation();
+
+  for(int impl = claw::graphic::pixel_kernels::scalar; impl <= best; ++impl)
+    {
+      m.implementation = names[impl];
+      time_operation(
+          [&]() -> void
+          {
+            frame = background;
+
+            for(std::size_t i = 0; i != rectangles.size(); ++i)
+              fill_kernel(
+                  frame, rectangles[i], colors[i],
+                  (claw::graphic::pixel_kernels::implementation)impl);
+          },
+          pixels, m);
+      result.push_back(m);
+
+      if(!std::equal(frame.begin(), frame.end(), reference.begin()))
+        std::cerr << name << ": the " << names[impl]
+                  << " implementation differs from the reference."
+                  << std::endl;
+    }
+
+  m.implementation = "image::fill";
+  time_operation(
+      [&]() -> void
+      {
+        frame = background;
+
+        for(std::size_t i = 0; i != rectangles.size(); ++i)
+          frame.fill(rectangles[i], colors[i]);
+      },
+      pixels, m);
+  result.push_back(m);
+
+  if(!std::equal(frame.begin(), frame.end(), reference.begin()))
+    std::cerr << name << ": image::fill differs from the reference."
+              << std::endl;
+
+  // The colors are drawn over the pixels, whose result differs from the one
+  // of image::fill().
+  const claw::graphic::premultiplied_image premultiplied_background(
+      background);
+  claw::graphic::premultiplied_image premultiplied_frame;
+
+  m.implementation = "premultiplied";
+  time_operation(
+      [&]() -> void
+      {
+        premultiplied_frame = premultiplied_background;
+
+        for(std::size_t i = 0; i != rectangles.size(); ++i)
+          premultiplied_frame.fill(rectangles[i], colors[i]);
+      },
+      pixels, m);
+  result.push_back(m);
+}
+
+/**
+ * \brief Measure the composition of sprites on the tiles of a 1080p frame,
+ *        the tiles being processed one after the other as in a tiled
+ *        renderer.
+ * \param result (out) The measures are added at the end of this vector.
+ *
+ * The sprites are merged in each tile either through a view on the tile in
+ * the frame, or in a copy of the tile which is then copied back.
+ */
+void run_tiles(std::vector<measure>& result)
+{
+  const claw::graphic::image background(make_image(1920, 1080));
+  const std::vector<sprite> sprites(
+      make_sprites(500, background.width(), background.height()));
+  const std::size_t pixels = covered_pixels(sprites, background);
+  const int tile_size = 256;
+
+  claw::graphic::image reference(background);
+
+  for(std::size_t i = 0; i != sprites.size(); ++i)
+    reference.merge(sprites[i].picture, sprites[i].position);
+
+  claw::graphic::image frame;
+  claw::graphic::image tile;
+  measure m;
+  m.operation = "tile-merge";
+
+  m.implementation = "image copy";
+  time_operation(
+      [&]() -> void
+      {
+        frame = background;
+
+        for(int y = 0; y < (int)frame.height(); y += tile_size)
+          for(int x = 0; x < (int)frame.width(); x += tile_size)
+            {
+              const claw::math::coordinate_2d<int> origin(x, y);
+              const claw::graphic::const_image_view area(
+                  frame, claw::math::rectangle<int>(origin, tile_size,
+                                                    tile_size));
+
+              tile.set_size(area.width(), area.height());
+              tile.partial_copy(area, claw::math::coordinate_2d<int>(0, 0));
+
+              for(std::size_t i = 0; i != sprites.size(); ++i)
+                tile.merge(sprites[i].picture, sprites[i].position - origin);
+
+              frame.partial_copy(tile, origin);
+            }
+      },
+      pixels, m);
+  result.push_back(m);
+
+  if(!std::equal(frame.begin(), frame.end(), reference.begin()))
+    std::cerr << "tile-merge: the copied tiles differ from the reference."
+              << std::endl;
+
+  m.implementation = "image_view";
+  time_operation(
+      [&]() -> void
+      {
+        frame = background;
+
+        for(int y = 0; y < (int)frame.height(); y += tile_size)
+          for(int x = 0; x < (int)frame.width(); x += tile_size)
+            {
+              const claw::math::coordinate_2d<int> origin(x, y);
+              const claw::graphic::image_view area(
+                  frame, claw::math::rectangle<int>(origin, tile_size,
+                                                    tile_size));
+
+              for(std::size_t i = 0; i != sprites.size(); ++i)
+                area.merge(sprites[i].picture, sprites[i].position - origin);
+            }
+      },
+      pixels, m);
+  result.push_back(m);
+
+  if(!std::equal(frame.begin(), frame.end(), reference.begin()))
+    std::cerr << "tile-merge: the views differ from the reference."
+              << std::endl;
+}
+
+/**
+ * \brief Measure the resizing of images with each filter.
+ * \param result (out) The measures are added at the end of this vector.
+ *
+ * A 1080p frame is reduced to a thumbnail and a small picture is enlarged to
+ * 1080p. The throughput is given in pixels of the largest image per second.
+ * The results of the SIMD implementations are compared with the scalar one.
+ */
+void run_resample(std::vector<measure>& result)
+{
+  const claw::graphic::image frame(make_image(1920, 1080));
+  const claw::graphic::image picture(make_image(480, 270));
+
+  const char* const filter_names[] = { "box", "bilinear", "bicubic",
+                                       "lanczos" };
+  const char* const names[] = { "scalar", "sse2", "avx2" };
+  const claw::graphic::pixel_kernels::implementation best =
+      claw::graphic::pixel_kernels::best_implementation();
+
+  claw::graphic::image reduced;
+  claw::graphic::image enlarged;
+  claw::graphic::image reduced_reference;
+  claw::graphic::image enlarged_reference;
+  measure m;
+
+  for(int f = claw::graphic::resampler::box;
+      f <= claw::graphic::resampler::lanczos; ++f)
+    for(int impl = claw::graphic::pixel_kernels::scalar; impl <= best; ++impl)
+      {
+        const claw::graphic::resampler resampler(
+            (claw::graphic::resampler::filter_type)f,
+            (claw::graphic::pixel_kernels::implementation)impl);
+
+        m.implementation = std::string(filter_names[f]) + '/' + names[impl];
+
+        m.operation = "downscale";
+        time_operation(
+            [&]() -> void
+            {
+              reduced = resampler.scale(frame, 320, 180);
+            },
+            frame.width() * frame.height(), m);
+        result.push_back(m);
+
+        m.operation = "upscale";
+        time_operation(
+            [&]() -> void
+            {
+              enlarged = resampler.scale(picture, 1920, 1080);
+            },
+            1920 * 1080, m);
+        result.push_back(m);
+
+        if(impl == claw::graphic::pixel_kernels::scalar)
+          {
+            reduced_reference = reduced;
+            enlarged_reference = enlarged;
+          }
+        else if(!std::equal(reduced.begin(), reduced.end(),
+                            reduced_reference.begin())
+                || !std::equal(enlarged.begin(), enlarged.end(),
+                               enlarged_reference.begin()))
+          std::cerr << "resample: the " << m.implementation
+                    << " implementation differs from the reference."
+                    << std::endl;
+      }
+}
+
+/**
+ * \brief Measure the conversions of the colors of a 1080p frame, with each
+ *        implementation of the kernels.
+ * \param result (out) The measures are added at the end of this vector.
+ *
+ * The results of the SIMD implementations are compared with the scalar one.
+ */
+void run_convert(std::vector<measure>& result)
+{
+  typedef claw::graphic::pixel_kernels kernels;
+
+  const claw::graphic::image frame(make_image(1920, 1080));
+  const std::size_t n = frame.width() * frame.height();
+
+  const char* const names[] = { "scalar", "sse2", "avx2" };
+  const kernels::implementation best = kernels::best_implementation();
+
+  claw::graphic::image pixels(frame.width(), frame.height());
+  std::vector<unsigned char> bytes(n * 4);
+
+  // The result of each operation with the scalar implementation.
+  std::vector<std::string> reference;
+  measure m;
+
+  // Each operation reads the frame and stores its result in pixels or
+  // bytes.
+  const char* const operations[] = { "grayscale", "premultiply",
+                                     "unpremultiply", "to-bgra32",
+                                     "from-bgra32", "to-argb32", "to-rgb24",
+                                     "from-rgb24", "to-bgr24" };
+  const std::size_t count = sizeof(operations) / sizeof(operations[0]);
+
+  for(int impl = kernels::scalar; impl <= best; ++impl)
+    for(std::size_t op = 0; op != count; ++op)
+      {
+        const kernels::implementation i = (kernels::implementation)impl;
+        const claw::graphic::rgba_pixel* const src = frame.data();
+        const unsigned char* const src_bytes =
+            reinterpret_cast<const unsigned char*>(frame.data());
+        claw::graphic::rgba_pixel* const dest = pixels.data();
+
+        // The buffers are cleared such that only the output of the
+        // operation is compared with the reference.
+        std::fill(bytes.begin(), bytes.end(), 0);
+        std::fill(dest, dest + n, claw::graphic::rgba_pixel(0, 0, 0, 0));
+
+        m.operation = operations[op];
+        m.implementation = names[impl];
+        time_operation(
+            [&]() -> void
+            {
+              switch(op)
+                {
+                case 0:
+                  kernels::grayscale(dest, src, n, i);
+                  break;
+                case 1:
+                  kernels::premultiply(dest, src, n, i);
+                  break;
+                case 2:
+                  kernels::unpremultiply(dest, src, n, i);
+                  break;
+                case 3:
+                  kernels::convert_to(bytes.data(), kernels::bgra32, src, n,
+                                      i);
+                  break;
+                case 4:
+                  kernels::convert_from(dest, src_bytes, kernels::bgra32, n,
+                                        i);
+                  break;
+                case 5:
+                  kernels::convert_to(bytes.data(), kernels::argb32, src, n,
+                                      i);
+                  break;
+                case 6:
+                  kernels::convert_to(bytes.data(), kernels::rgb24, src, n, i);
+                  break;
+                case 7:
+                  kernels::convert_from(dest, src_bytes, kernels::rgb24, n, i);
+                  break;
+                case 8:
+                  kernels::convert_to(bytes.data(), kernels::bgr24, src, n, i);
+                  break;
+                }
+            },
+            n, m);
+        result.push_back(m);
+
+        const std::string output(
+            std::string(bytes.begin(), bytes.end())
+            + std::string(reinterpret_cast<const char*>(pixels.data()),
+                          n * sizeof(claw::graphic::rgba_pixel)));
+
+        if(impl == kernels::scalar)
+          reference.push_back(output);
+        else if(output != reference[op])
+          std::cerr << operations[op] << ": the " << names[impl]
+                    << " implementation differs from the reference."
+                    << std::endl;
+      }
+}
+
+/**
+ * \brief Read an image from a stream by trying each reader in turn, as
+ *        image::load() did before the formats were detected from the first
+ *        bytes of the stream.
+ * \param img The image in which the data will be stored.
+ * \param f The stream from which we read the data.
+ */
+void load_trying_readers(claw::graphic::image& img, std::istream& f)
+{
+  try
+    {
+      claw::graphic::jpeg::reader(img, f);
+      return;
+    }
+  catch(...)
+    {}
+
+  try
+    {
+      claw::graphic::png::reader(img, f);
+      return;
+    }
+  catch(...)
+    {}
+
+  try
+    {
+      claw::graphic::bitmap::reader(img, f);
+      return;
+    }
+  catch(...)
+    {}
+
+  try
+    {
+      claw::graphic::targa::reader(img, f);
+      return;
+    }
+  catch(...)
+    {}
+
+  try
+    {
+      claw::graphic::gif::reader(img, f);
+      return;
+    }
+  catch(...)
+    {}
+
+  try
+    {
+      claw::graphic::pcx::reader(img, f);
+      return;
+    }
+  catch(...)
+    {}
+
+  claw::graphic::xbm::reader(img, f);
+}
+
+/**
+ * \brief Measure the loading of small images saved in each format, with the
+ *        formats detected from the first bytes of the files and by trying
+ *        each reader in turn.
+ * \param result (out) The measures are added at the end of this vector.
+ *
+ * The images are as small as icons, such that the throughput is the inverse
+ * of the latency of the loading. The images loaded in both ways are
+ * compared.
+ */
+void run_load(std::vector<measure>& result)
+{
+  const claw::graphic::image picture(make_image(32, 32));
+  const unsigned int loads = 200;
+
+  const char* const formats[] = { "load-jpeg", "load-png",  "load-bitmap",
+                                  "load-targa", "load-pcx", "load-xbm" };
+  const std::size_t count = sizeof(formats) / sizeof(formats[0]);
+
+  claw::graphic::image sniffed;
+  claw::graphic::image tried;
+  measure m;
+
+  for(std::size_t i = 0; i != count; ++i)
+    {
+      std::ostringstream os;
+
+      switch(i)
+        {
+        case 0:
+          claw::graphic::jpeg::writer(picture, os);
+          break;
+        case 1:
+          claw::graphic::png::writer(picture, os);
+          break;
+        case 2:
+          claw::graphic::bitmap::writer(picture, os);
+          break;
+        case 3:
+          claw::graphic::targa::writer(picture, os, false);
+          break;
+        case 4:
+          claw::graphic::pcx::writer(picture, os);
+          break;
+        case 5:
+          claw::graphic::xbm::writer(picture, os);
+          break;
+        }
+
+      const std::string file(os.str());
+
+      m.operation = formats[i];
+
+      m.implementation = "try-readers";
+      time_operation(
+          [&]() -> void
+          {
+            for(unsigned int j = 0; j != loads; ++j)
+              {
+                std::istringstream is(file);
+                load_trying_readers(tried, is);
+              }
+          },
+          loads * picture.width() * picture.height(), m);
+      result.push_back(m);
+
+      m.implementation = "sniffed";
+      time_operation(
+          [&]() -> void
+          {
+            for(unsigned int j = 0; j != loads; ++j)
+              {
+                std::istringstream is(file);
+                sniffed.load(is);
+              }
+          },
+          loads * picture.width() * picture.height(), m);
+      result.push_back(m);
+
+      if(!std::equal(sniffed.begin(), sniffed.end(), tried.begin()))
+        std::cerr << formats[i] << ": the detected format differs from the "
+                  << "one found by trying the readers." << std::endl;
+    }
+}
+
+/**
+ * \brief Create the streams reading some files stored in memory.
+ * \param files The content of the files.
+ * \param streams (out) The streams reading the files.
+ * \param sources (out) The addresses of the streams, in the order of
+ *        \a files.
+ */
+void open_files(const std::vector<std::string>& files,
+                std::deque<claw::imemory_stream>& streams,
+                std::vector<std::istream*>& sources)
+{
+  for(std::size_t i = 0; i != files.size(); ++i)
+    {
+      streams.emplace_back(files[i].data(), files[i].size());
+      sources.push_back(&streams.back());
+    }
+}
+
+/**
+ * \brief Measure the operations of claw::graphic::image processing the lines
+ *        on a thread pool, on 8K images, and the loading of a batch of
+ *        sprites, with an increasing number of threads.
+ * \param result (out) The measures are added at the end of this vector.
+ *
+ * The images produced with each number of threads are compared with the ones
+ * produced without thread pool.
+ */
+void run_threads(std::vector<measure>& result)
+{
+  const claw::graphic::image background(make_image(7680, 4320));
+  const claw::graphic::image picture(make_image(7000, 4000));
+  const claw::math::coordinate_2d<int> position(300, 200);
+  const claw::math::rectangle<int> area(100, 100, 7400, 4100);
+  const claw::graphic::rgba_pixel color(20, 40, 60, 128);
+  const std::size_t pixels = picture.width() * picture.height();
+  const std::size_t area_pixels = area.area();
+
+  claw::graphic::image reference(background);
+  reference.merge(picture, position);
+  reference.fill(area, color);
+  reference.partial_copy(picture, position);
+
+  const claw::graphic::resampler resampler(claw::graphic::resampler::bicubic);
+  const claw::graphic::image thumbnail_reference(
+      resampler.scale(background, 1920, 1080));
+  claw::graphic::image thumbnail;
+
+  // Small sprites saved in various formats, as loaded by a game.
+  std::vector<std::string> sprite_files(512);
+  std::size_t sprite_pixels = 0;
+
+  for(std::size_t i = 0; i != sprite_files.size(); ++i)
+    {
+      const claw::graphic::image sprite(make_image(16 + std::rand() % 112,
+                                                   16 + std::rand() % 112));
+      std::ostringstream os;
+
+      switch(i % 4)
+        {
+        case 0:
+          claw::graphic::png::writer(sprite, os);
+          break;
+        case 1:
+          claw::graphic::bitmap::writer(sprite, os);
+          break;
+        case 2:
+          claw::graphic::targa::writer(sprite, os, true);
+          break;
+        default:
+          claw::graphic::pcx::writer(sprite, os);
+        }
+
+      sprite_files[i] = os.str();
+      sprite_pixels += sprite.width() * sprite.height();
+    }
+
+  const claw::graphic::batch_loader loader;
+  std::vector<claw::graphic::batch_loader::item> sprites;
+  std::vector<claw::graphic::batch_loader::item> sprites_reference;
+
+  {
+    std::deque<claw::imemory_stream> streams;
+    std::vector<std::istream*> sources;
+
+    open_files(sprite_files, streams, sources);
+    loader.load(sources, sprites_reference);
+  }
+
+  const unsigned int max_threads =
+      2 * std::max(1u, std::thread::hardware_concurrency());
+
+  claw::graphic::image frame;
+  measure m;
+
+  for(unsigned int threads = 1; threads <= max_threads; threads *= 2)
+    {
+      claw::thread_pool pool(threads);
+      std::ostringstream name;
+      name << threads << (threads == 1 ? " thread" : " threads");
+      m.implementation = name.str();
+
+      frame = background;
+
+      m.operation = "mt-merge";
+      time_operation(
+          [&]() -> void
+          {
+            frame.merge(picture, position, pool);
+          },
+          pixels, m);
+      result.push_back(m);
+
+      m.operation = "mt-fill";
+      time_operation(
+          [&]() -> void
+          {
+            frame.fill(area, color, pool);
+          },
+          area_pixels, m);
+      result.push_back(m);
+
+      m.operation = "mt-copy";
+      time_operation(
+          [&]() -> void
+          {
+            frame.partial_copy(picture, position, pool);
+          },
+          pixels, m);
+      result.push_back(m);
+
+      m.operation = "mt-resize";
+      time_operation(
+          [&]() -> void
+          {
+            thumbnail = resampler.scale(background, 1920, 1080, pool);
+          },
+          background.width() * background.height(), m);
+      result.push_back(m);
+
+      m.operation = "mt-load";
+      time_operation(
+          [&]() -> void
+          {
+            std::deque<claw::imemory_stream> streams;
+            std::vector<std::istream*> sources;
+
+            open_files(sprite_files, streams, sources);
+            loader.load(sources, sprites, pool);
+          },
+          sprite_pixels, m);
+      result.push_back(m);
+
+      for(std::size_t i = 0; i != sprites.size(); ++i)
+        if(!sprites[i].loaded
+           || !std::equal(sprites[i].picture.begin(), sprites[i].picture.end(),
+                          sprites_reference[i].picture.begin()))
+          std::cerr << "The sprite " << i << " loaded with " << threads
+                    << " threads differs from the sequential one."
+                    << std::endl;
+
+      if(!std::equal(thumbnail.begin(), thumbnail.end(),
+                     thumbnail_reference.begin()))
+        std::cerr << "The resized image with " << threads
+                  << " threads differs from the sequential one." << std::endl;
+
+      // The same operations on the same pixels, independently of the
+      // number of times they are repeated, must give the same result.
+      frame = background;
+      frame.merge(picture, position, pool);
+      frame.fill(area, color, pool);
+      frame.partial_copy(picture, position, pool);
+
+      if(!std::equal(frame.begin(), frame.end(), reference.begin()))
+        std::cerr << "The result with " << threads
+                  << " threads differs from the sequential one." << std::endl;
+    }
+}
+
+/**
+ * \brief Print the measures in a table.
+ * \param measures The measures to print.
+ */
+void print_table(const std::vector<measure>& measures)
+{
+  std::printf("%-14s %-16s %12s\n", "operation", "implementation",
+              "Mpixels/s");
+
+  for(std::size_t i = 0; i != measures.size(); ++i)
+    std::printf("%-14s %-16s %12.2f\n", measures[i].operation.c_str(),
+                measures[i].implementation.c_str(), measures[i].throughput);
+}
+
+/**
+ * \brief Print the measures as tab separated values.
+ * \param measures The measures to print.
+ */
+void print_tsv(const std::vector<measure>& measures)
+{
+  std::printf("operation\timplementation\tmpixels_per_s\n");
+
+  for(std::size_t i = 0; i != measures.size(); ++i)
+    std::printf("%s\t%s\t%.3f\n", measures[i].operation.c_str(),
+                measures[i].implementation.c_str(), measures[i].throughput);
+}
+
+int main(int argc, char* argv[])
+{
+  bool tsv = false;
+  bool threads = false;
+
+  for(int i = 1; i != argc; ++i)
+    if(std::strcmp(argv[i], "--tsv") == 0)
+      tsv = true;
+    else if(std::strcmp(argv[i], "--threads") == 0)
+      threads = true;
+    else
+      {
+        std::cerr << "Usage: " << argv[0] << " [--tsv] [--threads]"
+                  << std::endl;
+        return 1;
+      }
+
+  std::srand(0);
+
+  std::vector<measure> measures;
+
+  run_merge(measures);
+  run_fill("fill-opaque", true, measures);
+  run_fill("fill-blend", false, measures);
+  run_tiles(measures);
+  run_resample(measures);
+  run_convert(measures);
+  run_load(measures);
+
+  if(threads)
+    run_threads(measures);
+
+  if(tsv)
+    print_tsv(measures);
+  else
+    print_table(measures);
+
+  return 0;
+}
@@ -8,6 +8,7 @@
 #include <claw/graphic/png.hpp>
 #include <claw/graphic/targa.hpp>
 #include <claw/graphic/xbm.hpp>
+#include <claw/memory_mapped_file.hpp>
 
 void save_bitmap(const claw::graphic::image& img, const std::string& filename)
 {
@@ -235,22 +236,18 @@ int main(int argc, char* argv[])
   else
     for(int i = 1; i != argc; ++i)
       {
-        std::ifstream f(argv[i], std::ios::binary);
+        try
+          {
+            const claw::memory_mapped_file f(argv[i]);
+            claw::graphic::image img;
 
-        if(f)
+            img.load(f.data(), f.size());
+            save(img, get_base_name(argv[i]));
+          }
+        catch(std::exception& e)
           {
-            try
-              {
-                claw::graphic::image img(f);
-                save(img, get_base_name(argv[i]));
-              }
-            catch(std::exception& e)
-              {
-                std::cerr << "Exception: " << e.what() << std::endl;
-              }
+            std::cerr << "Exception: " << e.what() << std::endl;
           }
-        else
-          std::cerr << "can't open '" << argv[i] << "'" << std::endl;
       }
 
   return 0;
@@ -0,0 +1,225 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file benchmark.cpp
+ * \brief Compare the speed of the generic string algorithms with the ones
+ *        specialized for std::string, on a log-like text.
+ * \author Julien Jorge
+ */
+#include <claw/byte_set.hpp>
+#include <claw/string_algorithm.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Build a text looking like a log file.
+ * \param size The minimum size of the text.
+ */
+std::string make_log(std::size_t size)
+{
+  static const char* const levels[] = { "info", "warning", "error", "debug" };
+  static const char* const paths[]
+      = { "/index.html", "/api/v1/users", "/static/app.js",
+          "/images/logo.png", "/api/v1/sessions" };
+
+  std::ostringstream oss;
+  std::size_t line(0);
+
+  while(oss.tellp() < (std::streamoff)size)
+    {
+      oss << "2026-10-18 12:" << (line / 60) % 60 << ':' << line % 60 << "  ["
+          << levels[std::rand() % 4] << "]  request id=" << std::rand()
+          << " path=" << paths[std::rand() % 5] << "  status=200";
+
+      if(line % 8 == 0)
+        oss << " message=\"value\\tescaped\\n\"";
+
+      oss << "\\n\n";
+      ++line;
+    }
+
+  return oss.str();
+}
+
+/**
+ * \brief Print the throughput of an algorithm.
+ * \param name The name of the algorithm.
+ * \param bytes The number of processed bytes.
+ * \param begin The date at which the processing started.
+ */
+void report(const std::string& name, std::size_t bytes,
+            std::chrono::steady_clock::time_point begin)
+{
+  const std::chrono::duration<double> d(std::chrono::steady_clock::now()
+                                        - begin);
+
+  std::cout << name << ": " << bytes / d.count() / (1024 * 1024) << " MB/s"
+            << std::endl;
+}
+
+/**
+ * \brief Check that the specialized algorithms give the same results than the
+ *        generic ones, whatever the instructions used by the processor.
+ * \param log The text on which the algorithms are run.
+ * \return true if all the results are the same.
+ */
+bool check_results(const std::string& log)
+{
+  bool result(true);
+
+  std::vector<char> generic(log.size());
+  std::vector<char> specialized(log.size());
+  const std::vector<char>::iterator generic_end(
+      claw::text::c_escape<std::string::const_iterator>(
+          log.begin(), log.end(), generic.begin()));
+  const std::vector<char>::iterator specialized_end(
+      claw::text::c_escape(log.begin(), log.end(), specialized.begin()));
+
+  if((generic_end - generic.begin() != specialized_end - specialized.begin())
+     || !std::equal(generic.begin(), generic_end, specialized.begin()))
+    {
+      std::cerr << "c_escape: the results differ." << std::endl;
+      result = false;
+    }
+
+  std::string generic_string(log);
+  std::string specialized_string(log);
+  claw::text::squeeze<std::string>(generic_string, " =");
+  claw::text::squeeze(specialized_string, " =");
+
+  if(generic_string != specialized_string)
+    {
+      std::cerr << "squeeze: the results differ." << std::endl;
+      result = false;
+    }
+
+  const std::string e1("\"[]"), e2("'()");
+  generic_string = log;
+  specialized_string = log;
+  claw::text::replace<std::string>(generic_string, e1, e2);
+  claw::text::replace(specialized_string, e1, e2);
+
+  if(generic_string != specialized_string)
+    {
+      std::cerr << "replace: the results differ." << std::endl;
+      result = false;
+    }
+
+  // The sets of one byte, of up to max_vector_size bytes and of more bytes
+  // are searched with different instructions, from every alignment.
+  const std::string bytes("=\"[]\\/xyz");
+
+  for(std::size_t n = 1; n <= bytes.size(); ++n)
+    {
+      const claw::text::byte_set set(bytes.data(), bytes.data() + n);
+
+      for(std::size_t first = 0; first != 64; ++first)
+        {
+          const char* const begin(log.data() + first);
+          const char* const end(log.data() + log.size());
+
+          if(set.find_first_of(begin, end)
+             != std::find_first_of(begin, end, bytes.data(),
+                                   bytes.data() + n))
+            {
+              std::cerr << "byte_set: the results differ for " << n
+                        << " bytes." << std::endl;
+              result = false;
+            }
+        }
+    }
+
+  return result;
+}
+
+int main()
+{
+  const std::string log(make_log(16 * 1024 * 1024));
+
+  if(!check_results(log.substr(0, 256 * 1024)))
+    return 1;
+
+  const unsigned int runs(8);
+  const std::size_t bytes(log.size() * runs);
+  std::chrono::steady_clock::time_point begin;
+
+  std::vector<char> escaped(log.size());
+
+  begin = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i != runs; ++i)
+    claw::text::c_escape<std::string::const_iterator>(log.begin(), log.end(),
+                                                      &escaped[0]);
+  report("c_escape (generic)", bytes, begin);
+
+  begin = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i != runs; ++i)
+    claw::text::c_escape(log.begin(), log.end(), &escaped[0]);
+  report("c_escape (std::string)", bytes, begin);
+
+  // The generic squeeze is quadratic, thus it is run on a smaller text.
+  const std::string small_log(log.substr(0, 64 * 1024));
+
+  begin = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i != runs; ++i)
+    {
+      std::string s(small_log);
+      claw::text::squeeze<std::string>(s, " =");
+    }
+  report("squeeze (generic)", small_log.size() * runs, begin);
+
+  begin = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i != runs; ++i)
+    {
+      std::string s(log);
+      claw::text::squeeze(s, " =");
+    }
+  report("squeeze (std::string)", bytes, begin);
+
+  const std::string e1("\"[]"), e2("'()");
+
+  begin = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i != runs; ++i)
+    {
+      std::string s(log);
+      claw::text::replace<std::string>(s, e1, e2);
+    }
+  report("replace (generic)", bytes, begin);
+
+  begin = std::chrono::steady_clock::now();
+  for(unsigned int i = 0; i != runs; ++i)
+    {
+      std::string s(log);
+      claw::text::replace(s, e1, e2);
+    }
+  report("replace (std::string)", bytes, begin);
+
+  return 0;
+}
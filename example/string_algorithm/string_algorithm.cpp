@@ -1,6 +1,8 @@
+#include <claw/glob.hpp>
 #include <claw/string_algorithm.hpp>
 #include <iostream>
 #include <string>
+#include <vector>
 
 int main()
 {
@@ -30,5 +32,24 @@ int main()
   claw::text::replace(s4, std::string("ab"), std::string("C"));
   std::cout << "replace '" << s << "' = '" << s4 << "'" << std::endl;
 
+  std::vector<std::string> patterns;
+  patterns.push_back("*.cpp");
+  patterns.push_back("src/*");
+  patterns.push_back("*/main.???");
+
+  const claw::glob_set<char> globs(patterns.begin(), patterns.end(), '*', '?',
+                                   '.');
+  const std::string path("src/main.cpp");
+  std::vector<std::size_t> matched;
+
+  globs.match_all(path.begin(), path.end(), std::back_inserter(matched));
+
+  std::cout << "'" << path << "' matches";
+
+  for(std::size_t i = 0; i != matched.size(); ++i)
+    std::cout << " '" << patterns[matched[i]] << "'";
+
+  std::cout << std::endl;
+
   return 0;
 }
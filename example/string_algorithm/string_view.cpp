@@ -0,0 +1,48 @@
+#include <claw/string_algorithm.hpp>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+int main()
+{
+  const std::string line("  name, value ,, last,");
+  std::vector<std::string> copies;
+
+  claw::text::split(copies, line, ',');
+
+  std::size_t i = 0;
+  bool same = true;
+
+  // The fields are views in line, no string is allocated.
+  for(std::string_view field : claw::text::split(line, ','))
+    {
+      std::cout << "field '" << field << "' trimmed '"
+                << claw::text::trim_view(field, " ") << "'" << std::endl;
+
+      same = same && (i != copies.size()) && (field == copies[i]);
+      ++i;
+    }
+
+  same = same && (i == copies.size());
+
+  std::string trimmed(line);
+  claw::text::trim(trimmed, " ,");
+
+  const std::string_view trimmed_view(claw::text::trim_view(line, " ,"));
+  std::cout << "trim_view '" << line << "' = '" << trimmed_view << "'"
+            << std::endl;
+
+  same = same && (trimmed_view == trimmed)
+         && (claw::text::trim_left_view(line) == "name, value ,, last,")
+         && (claw::text::trim_right_view(std::string_view(line), ",")
+             == "  name, value ,, last");
+
+  if(!same)
+    {
+      std::cerr << "The views differ from the copied strings." << std::endl;
+      return 1;
+    }
+
+  return 0;
+}
@@ -31,6 +31,7 @@
 #define __CLAW_AUTOMATON_HPP__
 
 #include <claw/avl.hpp>
+#include <claw/compiled_automaton.hpp>
 #include <map>
 #include <vector>
 
@@ -82,6 +83,12 @@ namespace claw
     /** \brief The return type of the methods returning edges. */
     typedef std::vector<edge_type> result_edge_list;
 
+    /** \brief The type of the automata built by determinize() and
+        minimize(), whose states are numbered from zero. */
+    typedef automaton<unsigned int, edge_type, std::less<unsigned int>,
+                      edge_compare>
+        determinized_type;
+
   public:
     void add_edge(const state_type& s1, const state_type& s2,
                   const edge_type& e);
@@ -104,6 +111,11 @@ namespace claw
     template <class InputIterator>
     bool match(InputIterator first, InputIterator last) const;
 
+    bool is_deterministic() const;
+    void determinize(determinized_type& result) const;
+    void minimize(determinized_type& result) const;
+    void compile(compiled_automaton<edge_type, edge_compare>& result) const;
+
     unsigned int states_count() const;
 
     void reachables(const state_type& s, const edge_type& e,
@@ -116,11 +128,24 @@ namespace claw
                result_edge_list& l) const;
 
   private:
-    template <class InputIterator>
-    bool match_aux(const state_type& s, InputIterator first,
-                   InputIterator last) const;
+    void build_dfa_table(result_edge_list& symbols,
+                         std::vector<unsigned int>& transitions,
+                         std::vector<bool>& finals) const;
+
+    void minimize_dfa_table(std::size_t symbols_count,
+                            std::vector<unsigned int>& transitions,
+                            std::vector<bool>& finals) const;
+
+    void table_to_automaton(const result_edge_list& symbols,
+                            const std::vector<unsigned int>& transitions,
+                            const std::vector<bool>& finals,
+                            determinized_type& result) const;
 
   private:
+    /** \brief The value used in the transition tables for the missing
+        transitions. */
+    static const unsigned int no_state = (unsigned int)(-1);
+
     /** \brief The predicate used to compare states. */
     static state_compare s_state_compare;
 
@@ -30,6 +30,8 @@
 #include <algorithm>
 #include <claw/assert.hpp>
 #include <claw/functional.hpp>
+#include <list>
+#include <set>
 
 //***************************** automate **************************************
 
@@ -37,6 +39,9 @@ template <class State, class Edge, class StateComp, class EdgeComp>
 typename claw::automaton<State, Edge, StateComp, EdgeComp>::state_compare
     claw::automaton<State, Edge, StateComp, EdgeComp>::s_state_compare;
 
+template <class State, class Edge, class StateComp, class EdgeComp>
+const unsigned int claw::automaton<State, Edge, StateComp, EdgeComp>::no_state;
+
 /**
  * \brief Add an edge in the automaton.
  * \param s1 Source state.
@@ -218,22 +223,137 @@ void claw::automaton<State, Edge, StateComp, EdgeComp>::alphabet(
  * \brief Tell if the automaton recognizes a given pattern.
  * \param first Iterator on the first symbol in the pattern.
  * \param last Iterator after the last symbol in the pattern.
+ *
+ * The pattern is read once, following all the nondeterministic transitions
+ * simultaneously, thus the cost is linear in the length of the pattern.
  */
 template <class State, class Edge, class StateComp, class EdgeComp>
 template <class InputIterator>
 bool claw::automaton<State, Edge, StateComp, EdgeComp>::match(
     InputIterator first, InputIterator last) const
 {
+  std::set<state_type, state_compare> current(m_initial_states.begin(),
+                                              m_initial_states.end());
+  std::set<state_type, state_compare> next;
+  typename std::set<state_type, state_compare>::const_iterator it;
+
+  for(; (first != last) && !current.empty(); ++first)
+    {
+      for(it = current.begin(); it != current.end(); ++it)
+        {
+          const neighbours_list& neighbours = m_states.find(*it)->second;
+          typename neighbours_list::const_iterator candidate
+              = neighbours.lower_bound(*first);
+          const typename neighbours_list::const_iterator last_candidate
+              = neighbours.upper_bound(*first);
+
+          for(; candidate != last_candidate; ++candidate)
+            next.insert(candidate->second);
+        }
+
+      current.swap(next);
+      next.clear();
+    }
+
   bool ok = false;
-  typename claw::avl<state_type>::const_iterator it;
 
-  for(it = m_initial_states.begin(); (it != m_initial_states.end()) && !ok;
-      ++it)
-    ok = match_aux(*it, first, last);
+  for(it = current.begin(); (it != current.end()) && !ok; ++it)
+    ok = state_is_final(*it);
 
   return ok;
 }
 
+/**
+ * \brief Tell if the automaton is deterministic, i.e. if it has at most one
+ *        initial state and if no state has two out-edges labeled with the
+ *        same symbol.
+ */
+template <class State, class Edge, class StateComp, class EdgeComp>
+bool claw::automaton<State, Edge, StateComp, EdgeComp>::is_deterministic()
+    const
+{
+  if(m_initial_states.size() > 1)
+    return false;
+
+  const edge_compare comp;
+  typename adjacent_list::const_iterator it_s;
+
+  for(it_s = m_states.begin(); it_s != m_states.end(); ++it_s)
+    {
+      typename neighbours_list::const_iterator it = it_s->second.begin();
+      typename neighbours_list::const_iterator prev = it;
+
+      if(it != it_s->second.end())
+        for(++it; it != it_s->second.end(); prev = it, ++it)
+          if(!comp(prev->first, it->first))
+            return false;
+    }
+
+  return true;
+}
+
+/**
+ * \brief Build a deterministic automaton recognizing the same patterns than
+ *        this one, with the subset construction.
+ * \param result (out) The deterministic automaton. Its states are numbered
+ *        from zero, zero being the initial state.
+ *
+ * Only the states reachable from the initial state are created. There is no
+ * state from which no final state can be reached, thus some transitions may
+ * be missing.
+ */
+template <class State, class Edge, class StateComp, class EdgeComp>
+void claw::automaton<State, Edge, StateComp, EdgeComp>::determinize(
+    determinized_type& result) const
+{
+  result_edge_list symbols;
+  std::vector<unsigned int> transitions;
+  std::vector<bool> finals;
+
+  build_dfa_table(symbols, transitions, finals);
+  table_to_automaton(symbols, transitions, finals, result);
+}
+
+/**
+ * \brief Build the minimal deterministic automaton recognizing the same
+ *        patterns than this one, with Hopcroft's algorithm.
+ * \param result (out) The minimal automaton. Its states are numbered from
+ *        zero, zero being the initial state.
+ *
+ * The result has no state from which no final state can be reached, thus
+ * some transitions may be missing.
+ */
+template <class State, class Edge, class StateComp, class EdgeComp>
+void claw::automaton<State, Edge, StateComp, EdgeComp>::minimize(
+    determinized_type& result) const
+{
+  result_edge_list symbols;
+  std::vector<unsigned int> transitions;
+  std::vector<bool> finals;
+
+  build_dfa_table(symbols, transitions, finals);
+  minimize_dfa_table(symbols.size(), transitions, finals);
+  table_to_automaton(symbols, transitions, finals, result);
+}
+
+/**
+ * \brief Build a transition table of the minimal deterministic automaton
+ *        recognizing the same patterns than this one, for fast matching.
+ * \param result (out) The compiled automaton.
+ */
+template <class State, class Edge, class StateComp, class EdgeComp>
+void claw::automaton<State, Edge, StateComp, EdgeComp>::compile(
+    compiled_automaton<edge_type, edge_compare>& result) const
+{
+  result_edge_list symbols;
+  std::vector<unsigned int> transitions;
+  std::vector<bool> finals;
+
+  build_dfa_table(symbols, transitions, finals);
+  minimize_dfa_table(symbols.size(), transitions, finals);
+  result.assign(symbols, transitions, finals);
+}
+
 /**
  * \brief Get the number of states.
  */
@@ -348,34 +468,343 @@ void claw::automaton<State, Edge, StateComp, EdgeComp>::edges(
  * =================================*/
 
 /**
- * \brief Recognize a pattern (recursive and auxiliary method).
- * \param s The state on which we start the search.
- * \param first Iterator on the first symbol to recognize.
- * \param last Iterator past the last symbol to recognize.
+ * \brief Build the transition table of a deterministic automaton recognizing
+ *        the same patterns than this one, with the subset construction.
+ * \param symbols (out) The symbols of the alphabet. The index of a symbol in
+ *        this list is the index of its column in the table.
+ * \param transitions (out) The transition table. The target of the
+ *        transition from state s with symbols[c] is
+ *        transitions[s * symbols.size() + c], or no_state if there is no such
+ *        transition.
+ * \param finals (out) Tell for each state if it is final.
+ *
+ * The states are numbered from zero, zero being the initial state. The table
+ * is empty if there is no initial state.
  */
 template <class State, class Edge, class StateComp, class EdgeComp>
-template <class InputIterator>
-bool claw::automaton<State, Edge, StateComp, EdgeComp>::match_aux(
-    const state_type& s, InputIterator first, InputIterator last) const
+void claw::automaton<State, Edge, StateComp, EdgeComp>::build_dfa_table(
+    result_edge_list& symbols, std::vector<unsigned int>& transitions,
+    std::vector<bool>& finals) const
 {
-  CLAW_PRECOND(state_exists(s));
+  typedef std::vector<unsigned int> state_set;
 
-  bool ok = false;
+  const edge_compare comp;
+  std::map<state_type, unsigned int, state_compare> index;
+  std::vector<const neighbours_list*> neighbours;
+  std::vector<bool> is_final;
+  typename adjacent_list::const_iterator it_s;
 
-  if(first == last)
-    ok = state_is_final(s);
-  else
+  for(it_s = m_states.begin(); it_s != m_states.end(); ++it_s)
     {
-      typename neighbours_list::const_iterator candidate, last_candidate;
-      InputIterator next_symbol = first;
-      ++next_symbol;
+      index[it_s->first] = neighbours.size();
+      neighbours.push_back(&it_s->second);
+      is_final.push_back(state_is_final(it_s->first));
+    }
+
+  alphabet(symbols);
+  transitions.clear();
+  finals.clear();
+
+  state_set initial;
+  typename avl<state_type, state_compare>::const_iterator it_i;
 
-      candidate = m_states.find(s)->second.lower_bound(*first);
-      last_candidate = m_states.find(s)->second.upper_bound(*first);
+  for(it_i = m_initial_states.begin(); it_i != m_initial_states.end(); ++it_i)
+    initial.push_back(index[*it_i]);
 
-      for(; (candidate != last_candidate) && !ok; ++candidate)
-        ok = match_aux(candidate->second, next_symbol, last);
+  if(initial.empty())
+    return;
+
+  std::sort(initial.begin(), initial.end());
+
+  std::map<state_set, unsigned int> subsets;
+  std::vector<state_set> sets;
+
+  subsets[initial] = 0;
+  sets.push_back(initial);
+
+  // sets grows while we are iterating on the new subsets.
+  for(std::size_t i = 0; i != sets.size(); ++i)
+    {
+      const state_set current(sets[i]);
+      std::vector<state_set> next(symbols.size());
+      bool final = false;
+
+      for(std::size_t j = 0; j != current.size(); ++j)
+        {
+          const neighbours_list& n = *neighbours[current[j]];
+          typename neighbours_list::const_iterator it;
+
+          final = final || is_final[current[j]];
+
+          for(it = n.begin(); it != n.end(); ++it)
+            {
+              const std::size_t c
+                  = std::lower_bound(symbols.begin(), symbols.end(),
+                                     it->first, comp)
+                    - symbols.begin();
+              next[c].push_back(index.find(it->second)->second);
+            }
+        }
+
+      finals.push_back(final);
+
+      for(std::size_t c = 0; c != next.size(); ++c)
+        if(next[c].empty())
+          transitions.push_back(no_state);
+        else
+          {
+            std::sort(next[c].begin(), next[c].end());
+            next[c].erase(std::unique(next[c].begin(), next[c].end()),
+                          next[c].end());
+
+            const typename std::map<state_set, unsigned int>::const_iterator
+                it = subsets.find(next[c]);
+
+            if(it != subsets.end())
+              transitions.push_back(it->second);
+            else
+              {
+                transitions.push_back(sets.size());
+                subsets[next[c]] = sets.size();
+                sets.push_back(next[c]);
+              }
+          }
     }
+}
 
-  return ok;
+/**
+ * \brief Minimize the transition table of a deterministic automaton with
+ *        Hopcroft's algorithm.
+ * \param symbols_count The number of symbols in the alphabet.
+ * \param transitions (in/out) The transition table, as built by
+ *        build_dfa_table().
+ * \param finals (in/out) Tell for each state if it is final.
+ *
+ * The states of the resulting table are numbered in the order in which they
+ * are reached by a breadth-first traversal from the initial state, which is
+ * zero. The states from which no final state can be reached are removed.
+ */
+template <class State, class Edge, class StateComp, class EdgeComp>
+void claw::automaton<State, Edge, StateComp, EdgeComp>::minimize_dfa_table(
+    std::size_t symbols_count, std::vector<unsigned int>& transitions,
+    std::vector<bool>& finals) const
+{
+  const std::size_t n(finals.size());
+
+  if(n == 0)
+    return;
+
+  // The table is completed with a dead state numbered n.
+  const std::size_t dead(n);
+  std::vector<std::vector<std::vector<unsigned int> > > inverse(
+      symbols_count, std::vector<std::vector<unsigned int> >(n + 1));
+
+  for(std::size_t s = 0; s != n + 1; ++s)
+    for(std::size_t c = 0; c != symbols_count; ++c)
+      {
+        std::size_t t(dead);
+
+        if((s != dead) && (transitions[s * symbols_count + c] != no_state))
+          t = transitions[s * symbols_count + c];
+
+        inverse[c][t].push_back(s);
+      }
+
+  // The initial partition separates the final states from the others.
+  std::vector<std::vector<unsigned int> > blocks(1);
+  std::vector<unsigned int> block_of(n + 1, 0);
+
+  for(std::size_t s = 0; s != n + 1; ++s)
+    if((s != dead) && finals[s])
+      block_of[s] = 1;
+
+  for(std::size_t s = 0; s != n + 1; ++s)
+    {
+      if(block_of[s] == blocks.size())
+        blocks.resize(blocks.size() + 1);
+
+      blocks[block_of[s]].push_back(s);
+    }
+
+  // The pairs (block, symbol) with which the blocks must be split.
+  std::list<std::pair<unsigned int, unsigned int> > pending;
+  std::vector<bool> is_pending;
+
+  if(blocks.size() == 2)
+    {
+      const unsigned int smallest(blocks[0].size() <= blocks[1].size() ? 0
+                                                                       : 1);
+      is_pending.resize(2 * symbols_count, false);
+
+      for(std::size_t c = 0; c != symbols_count; ++c)
+        {
+          pending.push_back(std::make_pair(smallest, c));
+          is_pending[smallest * symbols_count + c] = true;
+        }
+    }
+
+  std::vector<unsigned int> marked_count;
+  std::vector<bool> marked(n + 1, false);
+
+  while(!pending.empty())
+    {
+      const unsigned int splitter(pending.front().first);
+      const unsigned int c(pending.front().second);
+      pending.pop_front();
+      is_pending[splitter * symbols_count + c] = false;
+
+      // Find the states going in the splitter block with the symbol c.
+      std::vector<unsigned int> predecessors;
+
+      for(std::size_t i = 0; i != blocks[splitter].size(); ++i)
+        {
+          const std::vector<unsigned int>& p(inverse[c][blocks[splitter][i]]);
+          predecessors.insert(predecessors.end(), p.begin(), p.end());
+        }
+
+      marked_count.assign(blocks.size(), 0);
+      std::vector<unsigned int> touched;
+
+      for(std::size_t i = 0; i != predecessors.size(); ++i)
+        {
+          const unsigned int s(predecessors[i]);
+          marked[s] = true;
+
+          if(marked_count[block_of[s]] == 0)
+            touched.push_back(block_of[s]);
+
+          ++marked_count[block_of[s]];
+        }
+
+      // Split the blocks partially reached by the predecessors.
+      for(std::size_t i = 0; i != touched.size(); ++i)
+        {
+          const unsigned int b(touched[i]);
+
+          if(marked_count[b] != blocks[b].size())
+            {
+              const unsigned int new_block(blocks.size());
+              std::vector<unsigned int> kept;
+
+              blocks.resize(blocks.size() + 1);
+              is_pending.resize(blocks.size() * symbols_count, false);
+
+              for(std::size_t j = 0; j != blocks[b].size(); ++j)
+                if(marked[blocks[b][j]])
+                  kept.push_back(blocks[b][j]);
+                else
+                  {
+                    blocks[new_block].push_back(blocks[b][j]);
+                    block_of[blocks[b][j]] = new_block;
+                  }
+
+              blocks[b].swap(kept);
+
+              for(std::size_t d = 0; d != symbols_count; ++d)
+                {
+                  unsigned int added(new_block);
+
+                  if(!is_pending[b * symbols_count + d]
+                     && (blocks[b].size() < blocks[new_block].size()))
+                    added = b;
+
+                  pending.push_back(std::make_pair(added, d));
+                  is_pending[added * symbols_count + d] = true;
+                }
+            }
+        }
+
+      for(std::size_t i = 0; i != predecessors.size(); ++i)
+        marked[predecessors[i]] = false;
+    }
+
+  // Number the blocks in a breadth-first order, skipping the dead one.
+  const unsigned int dead_block(block_of[dead]);
+  std::vector<unsigned int> number(blocks.size(), no_state);
+  std::vector<unsigned int> order;
+
+  if(block_of[0] != dead_block)
+    {
+      number[block_of[0]] = 0;
+      order.push_back(block_of[0]);
+    }
+
+  for(std::size_t i = 0; i != order.size(); ++i)
+    {
+      const unsigned int s(blocks[order[i]][0]);
+
+      for(std::size_t c = 0; c != symbols_count; ++c)
+        {
+          const unsigned int t(transitions[s * symbols_count + c]);
+
+          if((t != no_state) && (block_of[t] != dead_block)
+             && (number[block_of[t]] == no_state))
+            {
+              number[block_of[t]] = order.size();
+              order.push_back(block_of[t]);
+            }
+        }
+    }
+
+  std::vector<unsigned int> minimal_transitions;
+  std::vector<bool> minimal_finals;
+
+  for(std::size_t i = 0; i != order.size(); ++i)
+    {
+      const unsigned int s(blocks[order[i]][0]);
+      minimal_finals.push_back(finals[s]);
+
+      for(std::size_t c = 0; c != symbols_count; ++c)
+        {
+          const unsigned int t(transitions[s * symbols_count + c]);
+
+          if((t == no_state) || (block_of[t] == dead_block))
+            minimal_transitions.push_back(no_state);
+          else
+            minimal_transitions.push_back(number[block_of[t]]);
+        }
+    }
+
+  // The language is empty, only the initial state is kept.
+  if(order.empty())
+    {
+      minimal_finals.push_back(false);
+      minimal_transitions.resize(symbols_count, no_state);
+    }
+
+  transitions.swap(minimal_transitions);
+  finals.swap(minimal_finals);
+}
+
+/**
+ * \brief Build an automaton from a transition table.
+ * \param symbols The symbols of the alphabet.
+ * \param transitions The transition table, as built by build_dfa_table().
+ * \param finals Tell for each state if it is final.
+ * \param result (out) The automaton.
+ */
+template <class State, class Edge, class StateComp, class EdgeComp>
+void claw::automaton<State, Edge, StateComp, EdgeComp>::table_to_automaton(
+    const result_edge_list& symbols,
+    const std::vector<unsigned int>& transitions,
+    const std::vector<bool>& finals, determinized_type& result) const
+{
+  result = determinized_type();
+
+  if(finals.empty())
+    return;
+
+  result.add_initial_state(0);
+
+  for(std::size_t s = 0; s != finals.size(); ++s)
+    {
+      if(finals[s])
+        result.add_final_state(s);
+      else
+        result.add_state(s);
+
+      for(std::size_t c = 0; c != symbols.size(); ++c)
+        if(transitions[s * symbols.size() + c] != no_state)
+          result.add_edge(s, transitions[s * symbols.size() + c], symbols[c]);
+    }
 }
@@ -30,35 +30,69 @@
 #ifndef __CLAW_BIT_ISTREAM_HPP__
 #define __CLAW_BIT_ISTREAM_HPP__
 
+#include <claw/bit_order.hpp>
+#include <claw/buffered_istream.hpp>
+
 namespace claw
 {
   /**
    * \brief This class is made to help reading datas of custom bit length.
+   *
+   * The bits are kept in a 64 bits buffer, refilled with several bytes at
+   * once. When the stream is a claw::buffered_istream, the bytes are taken
+   * directly from its buffer.
+   *
+   * \b Template \b parameters:
+   * - \a Stream The type of the stream from which we read the bytes,
+   * - \a Order The order of the bits in the bytes.
+   *
    * \author Julien Jorge
    */
-  template <typename Stream>
+  template <typename Stream, bit_order Order = lsb_first>
   class bit_istream
   {
   private:
     /** \brief The type of the stream we will read. */
     typedef Stream stream_type;
 
+  public:
+    /** \brief The maximum number of bits that can be read with a single call
+        to peek() or read_bits(). */
+    static const unsigned int max_bits = 32;
+
   public:
     bit_istream(stream_type& f);
 
     void read(char* buf, unsigned int n);
 
+    unsigned int peek(unsigned int n);
+    void consume(unsigned int n);
+    unsigned int read_bits(unsigned int n);
+
     operator bool() const;
 
+  private:
+    void refill();
+
+    template <typename S>
+    void refill_from(S& s);
+
+    template <typename S>
+    void refill_from(buffered_istream<S>& s);
+
+    void push_byte(unsigned char b);
+
   private:
     /** \brief The stream we're reading. */
     stream_type& m_stream;
 
-    /** \brief Some bits available for reading. */
-    unsigned char m_pending;
+    /** \brief Some bits available for reading. With lsb_first, the next bit
+        is the least significant one; with msb_first, it is the most
+        significant one. */
+    unsigned long long m_pending;
 
     /** \brief The number of valid bits in m_pending. */
-    unsigned char m_pending_length;
+    unsigned int m_pending_length;
 
   }; // class bit_istream
 }
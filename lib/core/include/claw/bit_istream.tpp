@@ -27,16 +27,20 @@
  * \brief Implementation of the claw::bit_istream class.
  * \author Julien Jorge
  */
+#include <cassert>
 #include <climits>
 
 #include <algorithm>
 
+template <typename Stream, claw::bit_order Order>
+const unsigned int claw::bit_istream<Stream, Order>::max_bits;
+
 /**
  * \brief Constructor.
  * \param f The stream in which we read.
  */
-template <typename Stream>
-claw::bit_istream<Stream>::bit_istream(stream_type& f)
+template <typename Stream, claw::bit_order Order>
+claw::bit_istream<Stream, Order>::bit_istream(stream_type& f)
   : m_stream(f)
   , m_pending(0)
   , m_pending_length(0)
@@ -46,50 +50,153 @@ claw::bit_istream<Stream>::bit_istream(stream_type& f)
  * \brief Read some bits.
  * \param buf A buffer in which we write the bits.
  * \param n The number of bits to read.
+ *
+ * The bits are added to the bytes of \a buf, eight bits per byte, the last
+ * byte receiving the n % 8 remaining bits in its least significant bits.
  */
-template <typename Stream>
-void claw::bit_istream<Stream>::read(char* buf, unsigned int n)
+template <typename Stream, claw::bit_order Order>
+void claw::bit_istream<Stream, Order>::read(char* buf, unsigned int n)
 {
-  if(n == 0)
-    return;
+  for(; n >= CHAR_BIT; n -= CHAR_BIT, ++buf)
+    *buf |= read_bits(CHAR_BIT);
 
-  unsigned int cur_size = 0;
+  if(n != 0)
+    *buf |= read_bits(n);
+}
 
-  while((n != 0) && !!(*this))
-    {
-      while((m_pending_length != 0) && (n != 0) && !!(*this))
-        {
-          unsigned int bits = std::min((unsigned int)m_pending_length, n);
+/**
+ * \brief Get the value of the next bits, without moving forward in the
+ *        stream.
+ * \param n The number of bits to get.
+ * \pre n <= max_bits
+ *
+ * The bits after the end of the stream are zeros.
+ */
+template <typename Stream, claw::bit_order Order>
+unsigned int claw::bit_istream<Stream, Order>::peek(unsigned int n)
+{
+  assert(n <= max_bits);
 
-          if(CHAR_BIT - cur_size < bits)
-            bits = CHAR_BIT - cur_size;
+  if(m_pending_length < n)
+    refill();
 
-          unsigned int mask = (1 << bits) - 1;
+  if(Order == lsb_first)
+    return (unsigned int)(m_pending & ((1ULL << n) - 1));
+  else if(n == 0)
+    return 0;
+  else
+    return (unsigned int)(m_pending >> (64 - n));
+}
 
-          *buf |= (m_pending & mask) << cur_size;
-          cur_size += bits;
-          m_pending_length -= bits;
-          m_pending >>= bits;
-          n -= bits;
+/**
+ * \brief Move forward in the stream.
+ * \param n The number of bits to skip.
+ * \pre n <= max_bits
+ *
+ * This method is meant to be called after peek(n).
+ */
+template <typename Stream, claw::bit_order Order>
+void claw::bit_istream<Stream, Order>::consume(unsigned int n)
+{
+  assert(n <= max_bits);
 
-          if(cur_size == CHAR_BIT)
-            {
-              ++buf;
-              cur_size = 0;
-            }
-        }
+  if(m_pending_length < n)
+    refill();
 
-      if(m_pending_length == 0)
-        if(m_stream.read((char*)&m_pending, sizeof(m_pending)))
-          m_pending_length = CHAR_BIT;
-    }
+  if(Order == lsb_first)
+    m_pending >>= n;
+  else
+    m_pending <<= n;
+
+  m_pending_length -= std::min(n, m_pending_length);
+}
+
+/**
+ * \brief Read the value of the next bits.
+ * \param n The number of bits to read.
+ * \pre n <= max_bits
+ */
+template <typename Stream, claw::bit_order Order>
+unsigned int claw::bit_istream<Stream, Order>::read_bits(unsigned int n)
+{
+  const unsigned int result = peek(n);
+  consume(n);
+  return result;
 }
 
 /**
  * \brief Tell if the input stream is still valid.
  */
-template <typename Stream>
-claw::bit_istream<Stream>::operator bool() const
+template <typename Stream, claw::bit_order Order>
+claw::bit_istream<Stream, Order>::operator bool() const
 {
   return m_stream || (m_pending_length > 0);
 }
+
+/**
+ * \brief Read as many whole bytes as possible in the pending bits.
+ */
+template <typename Stream, claw::bit_order Order>
+void claw::bit_istream<Stream, Order>::refill()
+{
+  refill_from(m_stream);
+}
+
+/**
+ * \brief Read bytes from a generic stream in the pending bits.
+ * \param s The stream to read.
+ */
+template <typename Stream, claw::bit_order Order>
+template <typename S>
+void claw::bit_istream<Stream, Order>::refill_from(S& s)
+{
+  char c;
+
+  while((m_pending_length <= 64 - CHAR_BIT) && s.read(&c, 1))
+    push_byte(c);
+}
+
+/**
+ * \brief Read bytes from the buffer of a buffered_istream in the pending
+ *        bits.
+ * \param s The stream to read.
+ */
+template <typename Stream, claw::bit_order Order>
+template <typename S>
+void claw::bit_istream<Stream, Order>::refill_from(buffered_istream<S>& s)
+{
+  while(m_pending_length <= 64 - CHAR_BIT)
+    {
+      if(s.remaining() == 0)
+        {
+          s.read_more(1024);
+
+          if(s.remaining() == 0)
+            return;
+        }
+
+      const unsigned int n =
+          std::min((64 - m_pending_length) / CHAR_BIT, s.remaining());
+      const char* p = s.get_buffer();
+
+      for(unsigned int i = 0; i != n; ++i)
+        push_byte(p[i]);
+
+      s.move(n);
+    }
+}
+
+/**
+ * \brief Append a byte after the pending bits.
+ * \param b The byte to append.
+ */
+template <typename Stream, claw::bit_order Order>
+void claw::bit_istream<Stream, Order>::push_byte(unsigned char b)
+{
+  if(Order == lsb_first)
+    m_pending |= (unsigned long long)b << m_pending_length;
+  else
+    m_pending |= (unsigned long long)b << (64 - CHAR_BIT - m_pending_length);
+
+  m_pending_length += CHAR_BIT;
+}
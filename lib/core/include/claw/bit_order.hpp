@@ -0,0 +1,51 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file bit_order.hpp
+ * \brief The order in which the bits are packed in the bytes of a stream.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BIT_ORDER_HPP__
+#define __CLAW_BIT_ORDER_HPP__
+
+namespace claw
+{
+  /**
+   * \brief The order in which the bits are packed in the bytes of a stream.
+   */
+  enum bit_order
+  {
+    /** \brief The first bit of the stream is the least significant bit of the
+        first byte, as in GIF and LZW files. */
+    lsb_first,
+
+    /** \brief The first bit of the stream is the most significant bit of the
+        first byte, as in JPEG files. */
+    msb_first
+
+  }; // enum bit_order
+}
+
+#endif // __CLAW_BIT_ORDER_HPP__
@@ -30,34 +30,68 @@
 #ifndef __CLAW_BIT_OSTREAM_HPP__
 #define __CLAW_BIT_OSTREAM_HPP__
 
+#include <claw/bit_order.hpp>
+
 namespace claw
 {
   /**
    * \brief This class is made to help writing datas of custom bit length.
+   *
+   * The bits are accumulated in a 64 bits buffer, then in a block of bytes
+   * which is written in the stream when it is full, when flush() is called
+   * and when the bit_ostream is destroyed.
+   *
+   * \b Template \b parameters:
+   * - \a Stream The type of the stream in which we write the bytes,
+   * - \a Order The order of the bits in the bytes.
+   *
    * \author Julien Jorge
    */
-  template <typename Stream>
+  template <typename Stream, bit_order Order = lsb_first>
   class bit_ostream
   {
   private:
     /** \brief The type of the stream we will write. */
     typedef Stream stream_type;
 
+  public:
+    /** \brief The maximum number of bits that can be written with a single
+        call to write_bits(). */
+    static const unsigned int max_bits = 32;
+
   public:
     bit_ostream(stream_type& f);
     ~bit_ostream();
 
     void write(const char* buf, unsigned int n);
+    void write_bits(unsigned int v, unsigned int n);
+
+    void flush();
 
   private:
-    /** \brief The stream we're reading. */
+    void store_bytes();
+
+  private:
+    /** \brief The size of the block of bytes written at once in the
+        stream. */
+    static const unsigned int block_size = 256;
+
+    /** \brief The stream we're writing. */
     stream_type& m_stream;
 
-    /** \brief Some bits available for writing. */
-    unsigned char m_pending;
+    /** \brief Some bits available for writing. With lsb_first, the next bit
+        to write is the least significant one; with msb_first, it is the
+        most significant one. */
+    unsigned long long m_pending;
 
     /** \brief The number of valid bits in m_pending. */
-    unsigned char m_pending_length;
+    unsigned int m_pending_length;
+
+    /** \brief The bytes not written in the stream yet. */
+    char m_block[block_size];
+
+    /** \brief The number of valid bytes in m_block. */
+    unsigned int m_block_length;
 
   }; // class bit_ostream
 }
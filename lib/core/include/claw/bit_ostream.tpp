@@ -27,76 +27,130 @@
  * \brief Implementation of the claw::bit_ostream class.
  * \author Julien Jorge
  */
+#include <cassert>
 #include <climits>
 
-#include <algorithm>
+template <typename Stream, claw::bit_order Order>
+const unsigned int claw::bit_ostream<Stream, Order>::max_bits;
+
+template <typename Stream, claw::bit_order Order>
+const unsigned int claw::bit_ostream<Stream, Order>::block_size;
 
 /**
  * \brief Constructor.
  * \param f The stream in which we write.
  */
-template <typename Stream>
-claw::bit_ostream<Stream>::bit_ostream(stream_type& f)
+template <typename Stream, claw::bit_order Order>
+claw::bit_ostream<Stream, Order>::bit_ostream(stream_type& f)
   : m_stream(f)
   , m_pending(0)
   , m_pending_length(0)
+  , m_block_length(0)
 {}
 
 /**
  * \brief Destructor.
  */
-template <typename Stream>
-claw::bit_ostream<Stream>::~bit_ostream()
+template <typename Stream, claw::bit_order Order>
+claw::bit_ostream<Stream, Order>::~bit_ostream()
 {
-  if(m_pending_length != 0)
-    m_stream.write((char*)&m_pending, sizeof(m_pending));
+  flush();
 }
 
 /**
  * \brief Write some bits.
  * \param buf A buffer from which we read the bits.
  * \param n The number of bits to write.
+ *
+ * The bits are taken eight by eight from the bytes of \a buf, then from the
+ * n % 8 least significant bits of the last byte.
+ */
+template <typename Stream, claw::bit_order Order>
+void claw::bit_ostream<Stream, Order>::write(const char* buf, unsigned int n)
+{
+  for(; n >= CHAR_BIT; n -= CHAR_BIT, ++buf)
+    write_bits((unsigned char)*buf, CHAR_BIT);
+
+  if(n != 0)
+    write_bits((unsigned char)*buf, n);
+}
+
+/**
+ * \brief Write the least significant bits of a value.
+ * \param v The value to write.
+ * \param n The number of bits to write.
+ * \pre n <= max_bits
  */
-template <typename Stream>
-void claw::bit_ostream<Stream>::write(const char* buf, unsigned int n)
+template <typename Stream, claw::bit_order Order>
+void claw::bit_ostream<Stream, Order>::write_bits(unsigned int v,
+                                                  unsigned int n)
 {
-  if(n == 0)
-    return;
+  assert(n <= max_bits);
 
-  unsigned int cur_size = 0;
-  unsigned char data = *buf;
+  const unsigned long long bits = v & ((1ULL << n) - 1);
+
+  if(Order == lsb_first)
+    m_pending |= bits << m_pending_length;
+  else if(n != 0)
+    m_pending |= bits << (64 - m_pending_length - n);
+
+  m_pending_length += n;
+
+  if(m_pending_length >= 32)
+    store_bytes();
+}
+
+/**
+ * \brief Write all the pending bits in the stream. The last byte is padded
+ *        with zeros, thus the next bits will start a new byte.
+ */
+template <typename Stream, claw::bit_order Order>
+void claw::bit_ostream<Stream, Order>::flush()
+{
+  store_bytes();
 
-  while(n != 0)
+  if(m_pending_length != 0)
+    {
+      // Pad the last byte with zeros.
+      m_pending_length = CHAR_BIT;
+      store_bytes();
+    }
+
+  if(m_block_length != 0)
+    {
+      m_stream.write(m_block, m_block_length);
+      m_block_length = 0;
+    }
+}
+
+/**
+ * \brief Move the complete bytes of the pending bits in the block, after
+ *        writing the block in the stream if there is not enough room for
+ *        them.
+ */
+template <typename Stream, claw::bit_order Order>
+void claw::bit_ostream<Stream, Order>::store_bytes()
+{
+  if(m_block_length + sizeof(m_pending) > block_size)
+    {
+      m_stream.write(m_block, m_block_length);
+      m_block_length = 0;
+    }
+
+  for(; m_pending_length >= CHAR_BIT; m_pending_length -= CHAR_BIT)
     {
-      while((m_pending_length != CHAR_BIT) && (n != 0))
+      if(Order == lsb_first)
         {
-          unsigned int bits
-              = std::min(CHAR_BIT - (unsigned int)m_pending_length, n);
-
-          if(CHAR_BIT - cur_size < bits)
-            bits = CHAR_BIT - cur_size;
-
-          unsigned int mask = (1 << bits) - 1;
-
-          m_pending |= (data & mask) << m_pending_length;
-          cur_size += bits;
-          m_pending_length += bits;
-          data >>= bits;
-          n -= bits;
-
-          if((cur_size == CHAR_BIT) && (n != 0))
-            {
-              ++buf;
-              cur_size = 0;
-              data = *buf;
-            }
+          m_block[m_block_length] = (unsigned char)m_pending;
+          m_pending >>= CHAR_BIT;
         }
-
-      if(m_pending_length == CHAR_BIT)
+      else
         {
-          m_stream.write((char*)&m_pending, sizeof(m_pending));
-          m_pending = 0;
-          m_pending_length = 0;
+          m_block[m_block_length] =
+              (unsigned char)(m_pending >> (64 - CHAR_BIT));
+          m_pending <<= CHAR_BIT;
         }
+
+      ++m_block_length;
     }
 }
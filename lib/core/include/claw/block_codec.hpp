@@ -0,0 +1,329 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_codec.hpp
+ * \brief Codecs compressing independent blocks of bytes in memory, for
+ *        claw::block_compressor and claw::block_decompressor.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BLOCK_CODEC_HPP__
+#define __CLAW_BLOCK_CODEC_HPP__
+
+#include <claw/bit_istream.hpp>
+#include <claw/bit_ostream.hpp>
+#include <claw/lzw_decoder.hpp>
+#include <claw/lzw_encoder.hpp>
+#include <claw/rle_decoder.hpp>
+#include <claw/rle_encoder.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A block codec using the Lempel-Ziv-Welch algorithm of
+   *        claw::lzw_encoder and claw::lzw_decoder.
+   *
+   * The codes are written with a variable length from 9 to 12 bits, the
+   * code 256 marking the end of a dictionary.
+   *
+   * A block codec must have the following members:
+   * - static const unsigned char id, the identifier of the codec stored in
+   *   the compressed files,
+   * - encode( const char* first, const char* last, std::vector<char>& out ),
+   *   append the compressed range to out,
+   * - std::size_t decode( const char* first, const char* last, char* out,
+   *   std::size_t size ), uncompress a range in a buffer of a given size and
+   *   return the number of bytes produced by the compressed data. The buffer
+   *   is never written past its size, but the returned value may be larger
+   *   if the data is corrupted.
+   *
+   * \author Julien Jorge
+   */
+  class lzw_block_codec
+  {
+  private:
+    /** \brief The stream in which the bit stream of the codes is written. */
+    class byte_sink
+    {
+    public:
+      inline explicit byte_sink(std::vector<char>& out);
+
+      inline void write(const char* p, unsigned int n);
+
+    private:
+      /** \brief The buffer receiving the bytes. */
+      std::vector<char>& m_out;
+
+    }; // class byte_sink
+
+    /** \brief The stream from which the bit stream of the codes is read. */
+    class byte_source
+    {
+    public:
+      inline byte_source(const char* first, const char* last);
+
+      inline bool read(char* p, unsigned int n);
+      inline operator bool() const;
+
+    private:
+      /** \brief The next byte to read. */
+      const char* m_current;
+
+      /** \brief The end of the data. */
+      const char* const m_end;
+
+    }; // class byte_source
+
+    /** \brief The input buffer of the encoder. */
+    class symbol_input
+    {
+    public:
+      inline symbol_input(const char* first, const char* last);
+
+      inline bool end_of_data() const;
+      inline unsigned int symbols_count() const;
+      inline unsigned int get_next();
+
+    private:
+      /** \brief The next byte to encode. */
+      const unsigned char* m_current;
+
+      /** \brief The end of the data. */
+      const unsigned char* const m_end;
+
+    }; // class symbol_input
+
+    /** \brief The output buffer of the encoder. */
+    class code_output
+    {
+    public:
+      inline explicit code_output(std::vector<char>& out);
+
+      inline unsigned int max_code() const;
+      inline void reset();
+      inline void new_code(unsigned int code);
+      inline void write(unsigned int code);
+      inline void flush();
+
+    private:
+      /** \brief The stream receiving the bytes of the codes. */
+      byte_sink m_sink;
+
+      /** \brief The stream in which the codes are written. */
+      bit_ostream<byte_sink> m_stream;
+
+      /** \brief The number of bits of the next code. */
+      unsigned int m_code_size;
+
+      /** \brief The code from which the codes need one more bit. */
+      unsigned int m_code_limit;
+
+    }; // class code_output
+
+    /** \brief The input buffer of the decoder. */
+    class code_input
+    {
+    public:
+      inline code_input(const char* first, const char* last);
+
+      inline bool has_data() const;
+
+      inline bool end_of_data() const;
+      inline unsigned int symbols_count() const;
+      inline unsigned int get_next();
+      inline void reset();
+      inline void new_code(unsigned int code);
+
+    private:
+      /** \brief The stream providing the bytes of the codes. */
+      byte_source m_source;
+
+      /** \brief The stream from which the codes are read. */
+      bit_istream<byte_source> m_stream;
+
+      /** \brief The last code read. */
+      unsigned int m_code;
+
+      /** \brief The highest code that the next code can be. */
+      unsigned int m_max_code;
+
+      /** \brief The number of bits of the next code. */
+      unsigned int m_code_size;
+
+      /** \brief The code from which the codes need one more bit. */
+      unsigned int m_code_limit;
+
+    }; // class code_input
+
+    /** \brief The output buffer of the decoder. */
+    class symbol_output
+    {
+    public:
+      inline symbol_output(char* out, std::size_t size);
+
+      inline std::size_t count() const;
+      inline void write(unsigned int symbol);
+
+    private:
+      /** \brief The beginning of the output buffer. */
+      char* const m_out;
+
+      /** \brief The size of the output buffer. */
+      const std::size_t m_size;
+
+      /** \brief The number of symbols written. */
+      std::size_t m_count;
+
+    }; // class symbol_output
+
+  public:
+    /** \brief The identifier of the codec in the compressed files. */
+    static const unsigned char id = 1;
+
+  public:
+    inline void encode(const char* first, const char* last,
+                       std::vector<char>& out) const;
+    inline std::size_t decode(const char* first, const char* last, char* out,
+                              std::size_t size);
+
+  private:
+    /** \brief The decoder, kept to reuse its tables from a block to the
+        other. */
+    lzw_decoder<code_input, symbol_output> m_decoder;
+
+  }; // class lzw_block_codec
+
+  /**
+   * \brief A block codec using the run-length encoding of
+   *        claw::rle_encoder and claw::rle_decoder.
+   *
+   * Each packet starts with a byte whose high bit tells if the packet is a
+   * run. The seven low bits are the length of the packet minus one. A run
+   * packet is followed by the repeated byte, a raw packet by its bytes.
+   *
+   * See claw::lzw_block_codec for the requirements of a block codec.
+   *
+   * \author Julien Jorge
+   */
+  class rle_block_codec
+  {
+  private:
+    /** \brief The output buffer of the encoder. */
+    class packet_output
+    {
+    public:
+      /** \brief The type of the encoded values. */
+      typedef char pattern_type;
+
+    public:
+      inline explicit packet_output(std::vector<char>& out);
+
+      inline unsigned int min_interesting() const;
+      inline unsigned int max_encodable() const;
+
+      inline void encode(unsigned int n, pattern_type pattern);
+
+      template <typename Iterator>
+      void raw(Iterator first, Iterator last);
+
+    private:
+      /** \brief The buffer receiving the packets. */
+      std::vector<char>& m_out;
+
+    }; // class packet_output
+
+    /** \brief The input buffer of the decoder. */
+    class packet_input
+    {
+    public:
+      inline packet_input(const char* first, const char* last);
+
+      inline std::size_t remaining() const;
+      inline char get_next();
+      inline const char* read(std::size_t n);
+
+    private:
+      /** \brief The next byte to read. */
+      const char* m_current;
+
+      /** \brief The end of the data. */
+      const char* const m_end;
+
+    }; // class packet_input
+
+    /** \brief The output buffer of the decoder. */
+    class byte_output
+    {
+    public:
+      inline byte_output(char* out, std::size_t size);
+
+      inline std::size_t count() const;
+
+      inline void fill(unsigned int n, char pattern);
+      inline void copy(unsigned int n, packet_input& input);
+
+    private:
+      /** \brief The beginning of the output buffer. */
+      char* const m_out;
+
+      /** \brief The size of the output buffer. */
+      const std::size_t m_size;
+
+      /** \brief The number of bytes written. */
+      std::size_t m_count;
+
+    }; // class byte_output
+
+    /** \brief The reader of the headers of the packets. */
+    class packet_mode_reader
+    {
+    public:
+      inline void read_mode(packet_input& input, byte_output& output,
+                            rle_packet<char>& packet) const;
+
+    }; // class packet_mode_reader
+
+    /** \brief The decoder of the packets. */
+    typedef rle_decoder<char, packet_input, byte_output, packet_mode_reader>
+        packet_decoder;
+
+  public:
+    /** \brief The identifier of the codec in the compressed files. */
+    static const unsigned char id = 2;
+
+  public:
+    inline void encode(const char* first, const char* last,
+                       std::vector<char>& out) const;
+    inline std::size_t decode(const char* first, const char* last, char* out,
+                              std::size_t size) const;
+
+  }; // class rle_block_codec
+}
+
+#include <claw/block_codec.ipp>
+
+#endif // __CLAW_BLOCK_CODEC_HPP__
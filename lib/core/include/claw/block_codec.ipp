@@ -0,0 +1,560 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_codec.ipp
+ * \brief Implementation of the claw::lzw_block_codec and
+ *        claw::rle_block_codec classes.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+
+#include <algorithm>
+
+/**
+ * \brief Constructor.
+ * \param out The buffer receiving the bytes.
+ */
+inline claw::lzw_block_codec::byte_sink::byte_sink(std::vector<char>& out)
+  : m_out(out)
+{}
+
+/**
+ * \brief Append some bytes to the buffer.
+ * \param p The bytes to write.
+ * \param n The number of bytes to write.
+ */
+inline void claw::lzw_block_codec::byte_sink::write(const char* p,
+                                                    unsigned int n)
+{
+  m_out.insert(m_out.end(), p, p + n);
+}
+
+/**
+ * \brief Constructor.
+ * \param first The first byte to read.
+ * \param last The end of the data.
+ */
+inline claw::lzw_block_codec::byte_source::byte_source(const char* first,
+                                                       const char* last)
+  : m_current(first)
+  , m_end(last)
+{}
+
+/**
+ * \brief Read some bytes.
+ * \param p (out) The bytes read.
+ * \param n The number of bytes to read.
+ */
+inline bool claw::lzw_block_codec::byte_source::read(char* p, unsigned int n)
+{
+  if((std::size_t)(m_end - m_current) < n)
+    {
+      m_current = m_end;
+      return false;
+    }
+
+  std::copy(m_current, m_current + n, p);
+  m_current += n;
+
+  return true;
+}
+
+/**
+ * \brief Tell if there are bytes to read.
+ */
+inline claw::lzw_block_codec::byte_source::operator bool() const
+{
+  return m_current != m_end;
+}
+
+/**
+ * \brief Constructor.
+ * \param first The first byte to encode.
+ * \param last The end of the data.
+ */
+inline claw::lzw_block_codec::symbol_input::symbol_input(const char* first,
+                                                         const char* last)
+  : m_current(reinterpret_cast<const unsigned char*>(first))
+  , m_end(reinterpret_cast<const unsigned char*>(last))
+{}
+
+/**
+ * \brief Tell if all the bytes have been read.
+ */
+inline bool claw::lzw_block_codec::symbol_input::end_of_data() const
+{
+  return m_current == m_end;
+}
+
+/**
+ * \brief Get the number of symbols, including the end of dictionary code.
+ */
+inline unsigned int claw::lzw_block_codec::symbol_input::symbols_count() const
+{
+  return 257;
+}
+
+/**
+ * \brief Get the next byte to encode.
+ */
+inline unsigned int claw::lzw_block_codec::symbol_input::get_next()
+{
+  return *(m_current++);
+}
+
+/**
+ * \brief Constructor.
+ * \param out The buffer receiving the codes.
+ */
+inline claw::lzw_block_codec::code_output::code_output(std::vector<char>& out)
+  : m_sink(out)
+  , m_stream(m_sink)
+  , m_code_size(9)
+  , m_code_limit(1 << m_code_size)
+{}
+
+/**
+ * \brief Get the highest code the encoder may produce.
+ */
+inline unsigned int claw::lzw_block_codec::code_output::max_code() const
+{
+  return 4096;
+}
+
+/**
+ * \brief Start a new dictionary.
+ */
+inline void claw::lzw_block_codec::code_output::reset()
+{
+  m_code_size = 9;
+  m_code_limit = 1 << m_code_size;
+}
+
+/**
+ * \brief Notify the creation of a code in the dictionary.
+ * \param code The new code.
+ */
+inline void claw::lzw_block_codec::code_output::new_code(unsigned int code)
+{
+  if(code == m_code_limit)
+    {
+      ++m_code_size;
+      m_code_limit = 1 << m_code_size;
+    }
+}
+
+/**
+ * \brief Write a code.
+ * \param code The code to write.
+ */
+inline void claw::lzw_block_codec::code_output::write(unsigned int code)
+{
+  m_stream.write_bits(code, m_code_size);
+}
+
+/**
+ * \brief Write the pending bits in the buffer.
+ */
+inline void claw::lzw_block_codec::code_output::flush()
+{
+  m_stream.flush();
+}
+
+/**
+ * \brief Constructor.
+ * \param first The first byte of the codes.
+ * \param last The end of the data.
+ */
+inline claw::lzw_block_codec::code_input::code_input(const char* first,
+                                                     const char* last)
+  : m_source(first, last)
+  , m_stream(m_source)
+  , m_code(0)
+  , m_max_code(256)
+  , m_code_size(9)
+  , m_code_limit(1 << m_code_size)
+{}
+
+/**
+ * \brief Tell if there are codes left.
+ */
+inline bool claw::lzw_block_codec::code_input::has_data() const
+{
+  return !!m_stream;
+}
+
+/**
+ * \brief Tell if the end of the current dictionary has been reached.
+ */
+inline bool claw::lzw_block_codec::code_input::end_of_data() const
+{
+  return !m_stream || (m_code == 256);
+}
+
+/**
+ * \brief Get the number of symbols, including the end of dictionary code.
+ */
+inline unsigned int claw::lzw_block_codec::code_input::symbols_count() const
+{
+  return 257;
+}
+
+/**
+ * \brief Get the next code.
+ *
+ * The code must be either a symbol, a code of the dictionary or the code to
+ * be added next in the dictionary.
+ */
+inline unsigned int claw::lzw_block_codec::code_input::get_next()
+{
+  m_code = m_stream.read_bits(m_code_size);
+
+  if(m_code > m_max_code)
+    throw claw::bad_format("lzw_block_codec: invalid code.");
+
+  m_max_code = std::max(m_max_code, symbols_count());
+
+  return m_code;
+}
+
+/**
+ * \brief Start a new dictionary.
+ */
+inline void claw::lzw_block_codec::code_input::reset()
+{
+  m_code = 0;
+  m_max_code = symbols_count() - 1;
+  m_code_size = 9;
+  m_code_limit = 1 << m_code_size;
+}
+
+/**
+ * \brief Notify the creation of a code in the dictionary.
+ * \param code The new code.
+ */
+inline void claw::lzw_block_codec::code_input::new_code(unsigned int code)
+{
+  m_max_code = code;
+
+  if((code == m_code_limit) && (m_code_size != 12))
+    {
+      ++m_code_size;
+      m_code_limit = 1 << m_code_size;
+    }
+}
+
+/**
+ * \brief Constructor.
+ * \param out The buffer receiving the bytes.
+ * \param size The size of the buffer.
+ */
+inline claw::lzw_block_codec::symbol_output::symbol_output(char* out,
+                                                           std::size_t size)
+  : m_out(out)
+  , m_size(size)
+  , m_count(0)
+{}
+
+/**
+ * \brief Get the number of symbols received, including those which did not
+ *        fit in the buffer.
+ */
+inline std::size_t claw::lzw_block_codec::symbol_output::count() const
+{
+  return m_count;
+}
+
+/**
+ * \brief Write a decoded symbol.
+ * \param symbol The symbol to write.
+ */
+inline void claw::lzw_block_codec::symbol_output::write(unsigned int symbol)
+{
+  if(m_count < m_size)
+    m_out[m_count] = symbol;
+
+  ++m_count;
+}
+
+/**
+ * \brief Compress a range of bytes.
+ * \param first The first byte to compress.
+ * \param last The end of the range.
+ * \param out (out) The buffer to which the compressed data is appended.
+ */
+inline void claw::lzw_block_codec::encode(const char* first, const char* last,
+                                          std::vector<char>& out) const
+{
+  lzw_encoder<symbol_input, code_output> encoder;
+  symbol_input input(first, last);
+  code_output output(out);
+
+  while(!input.end_of_data())
+    {
+      output.reset();
+      encoder.encode(input, output);
+      output.write(256);
+    }
+
+  output.flush();
+}
+
+/**
+ * \brief Uncompress a range of bytes.
+ * \param first The first byte of the compressed data.
+ * \param last The end of the compressed data.
+ * \param out (out) The buffer receiving the uncompressed data.
+ * \param size The size of the buffer pointed by \a out.
+ * \return The number of bytes produced by the compressed data.
+ */
+inline std::size_t claw::lzw_block_codec::decode(const char* first,
+                                                 const char* last, char* out,
+                                                 std::size_t size)
+{
+  code_input input(first, last);
+  symbol_output output(out, size);
+
+  while((output.count() < size) && input.has_data())
+    {
+      input.reset();
+      m_decoder.decode(input, output);
+    }
+
+  return output.count();
+}
+
+/**
+ * \brief Constructor.
+ * \param out The buffer receiving the packets.
+ */
+inline claw::rle_block_codec::packet_output::packet_output(
+    std::vector<char>& out)
+  : m_out(out)
+{}
+
+/**
+ * \brief Get the minimum length of a run worth a run packet.
+ */
+inline unsigned int
+claw::rle_block_codec::packet_output::min_interesting() const
+{
+  return 3;
+}
+
+/**
+ * \brief Get the maximum length of a run packet.
+ */
+inline unsigned int claw::rle_block_codec::packet_output::max_encodable() const
+{
+  return 128;
+}
+
+/**
+ * \brief Write a run packet.
+ * \param n The length of the run.
+ * \param pattern The repeated byte.
+ */
+inline void claw::rle_block_codec::packet_output::encode(unsigned int n,
+                                                         pattern_type pattern)
+{
+  m_out.push_back(0x80 | (n - 1));
+  m_out.push_back(pattern);
+}
+
+/**
+ * \brief Write some bytes without compression.
+ * \param first The first byte to write.
+ * \param last The end of the range.
+ */
+template <typename Iterator>
+void claw::rle_block_codec::packet_output::raw(Iterator first, Iterator last)
+{
+  while(first != last)
+    {
+      const std::size_t n =
+          std::min<std::size_t>(last - first, max_encodable());
+
+      m_out.push_back(n - 1);
+      m_out.insert(m_out.end(), first, first + n);
+      first += n;
+    }
+}
+
+/**
+ * \brief Constructor.
+ * \param first The first byte to read.
+ * \param last The end of the data.
+ */
+inline claw::rle_block_codec::packet_input::packet_input(const char* first,
+                                                         const char* last)
+  : m_current(first)
+  , m_end(last)
+{}
+
+/**
+ * \brief Get the number of bytes not read yet.
+ */
+inline std::size_t claw::rle_block_codec::packet_input::remaining() const
+{
+  return m_end - m_current;
+}
+
+/**
+ * \brief Read the next byte.
+ * \pre remaining() > 0
+ */
+inline char claw::rle_block_codec::packet_input::get_next()
+{
+  return *(m_current++);
+}
+
+/**
+ * \brief Move some bytes forward.
+ * \param n The number of bytes to read.
+ * \return The first byte read.
+ * \pre remaining() >= n
+ */
+inline const char* claw::rle_block_codec::packet_input::read(std::size_t n)
+{
+  const char* result = m_current;
+  m_current += n;
+  return result;
+}
+
+/**
+ * \brief Constructor.
+ * \param out The buffer receiving the bytes.
+ * \param size The size of the buffer.
+ */
+inline claw::rle_block_codec::byte_output::byte_output(char* out,
+                                                       std::size_t size)
+  : m_out(out)
+  , m_size(size)
+  , m_count(0)
+{}
+
+/**
+ * \brief Get the number of bytes received, including those which did not
+ *        fit in the buffer.
+ */
+inline std::size_t claw::rle_block_codec::byte_output::count() const
+{
+  return m_count;
+}
+
+/**
+ * \brief Write a byte several times.
+ * \param n The number of copies.
+ * \param pattern The byte to write.
+ */
+inline void claw::rle_block_codec::byte_output::fill(unsigned int n,
+                                                     char pattern)
+{
+  if(m_count < m_size)
+    std::fill(m_out + m_count, m_out + std::min(m_size, m_count + n),
+              pattern);
+
+  m_count += n;
+}
+
+/**
+ * \brief Copy some bytes from the input.
+ * \param n The number of bytes to copy.
+ * \param input The input from which the bytes are read.
+ */
+inline void claw::rle_block_codec::byte_output::copy(unsigned int n,
+                                                     packet_input& input)
+{
+  const std::size_t len = std::min(input.remaining(), (std::size_t)n);
+  const char* p = input.read(len);
+
+  if(m_count < m_size)
+    std::copy(p, p + std::min(len, m_size - m_count), m_out + m_count);
+
+  m_count += len;
+}
+
+/**
+ * \brief Read the header of the next packet.
+ * \param input The input from which the packet is read.
+ * \param output The output receiving the bytes.
+ * \param packet (out) The header of the packet.
+ */
+inline void claw::rle_block_codec::packet_mode_reader::read_mode(
+    packet_input& input, byte_output& output,
+    rle_packet<char>& packet) const
+{
+  packet.mode = packet.stop;
+
+  if(input.remaining() == 0)
+    return;
+
+  const unsigned char key = input.get_next();
+  packet.count = (key & 0x7F) + 1;
+
+  if((key & 0x80) == 0)
+    packet.mode = packet.raw;
+  else if(input.remaining() != 0)
+    {
+      packet.mode = packet.compressed;
+      packet.pattern = input.get_next();
+    }
+}
+
+/**
+ * \brief Compress a range of bytes.
+ * \param first The first byte to compress.
+ * \param last The end of the range.
+ * \param out (out) The buffer to which the compressed data is appended.
+ */
+inline void claw::rle_block_codec::encode(const char* first, const char* last,
+                                          std::vector<char>& out) const
+{
+  rle_encoder<packet_output> encoder;
+  packet_output output(out);
+
+  encoder.encode(first, last, output);
+}
+
+/**
+ * \brief Uncompress a range of bytes.
+ * \param first The first byte of the compressed data.
+ * \param last The end of the compressed data.
+ * \param out (out) The buffer receiving the uncompressed data.
+ * \param size The size of the buffer pointed by \a out.
+ * \return The number of bytes produced by the compressed data.
+ */
+inline std::size_t claw::rle_block_codec::decode(const char* first,
+                                                 const char* last, char* out,
+                                                 std::size_t size) const
+{
+  packet_decoder decoder;
+  packet_input input(first, last);
+  byte_output output(out, size);
+
+  decoder.decode(input, output);
+
+  return output.count();
+}
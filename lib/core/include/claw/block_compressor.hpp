@@ -0,0 +1,128 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_compressor.hpp
+ * \brief A class compressing a stream in independent blocks, on several
+ *        threads.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BLOCK_COMPRESSOR_HPP__
+#define __CLAW_BLOCK_COMPRESSOR_HPP__
+
+#include <claw/block_index.hpp>
+#include <claw/non_copyable.hpp>
+#include <claw/thread_pool.hpp>
+
+#include <deque>
+#include <future>
+#include <iostream>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A class compressing a stream in independent blocks, on several
+   *        threads.
+   *
+   * The data is cut in blocks of a fixed size, each block being compressed
+   * by a task of a claw::thread_pool. The compressed blocks are written in
+   * order, followed by an index allowing claw::block_decompressor to
+   * uncompress them in parallel or to access any of them. See
+   * claw::block_index for the layout of the file.
+   *
+   * At most two blocks per thread are waiting to be written, thus the memory
+   * used by the compressor does not depend on the size of the data.
+   *
+   * \b Template \b parameters:
+   * - \a Codec The type of the codec compressing the blocks. See
+   *   claw::lzw_block_codec for the requirements on this type.
+   *
+   * \author Julien Jorge
+   */
+  template <typename Codec>
+  class block_compressor : public pattern::non_copyable
+  {
+  public:
+    /** \brief The type of the codec compressing the blocks. */
+    typedef Codec codec_type;
+
+  private:
+    /** \brief A block being compressed. */
+    struct block
+    {
+      /** \brief The uncompressed data. */
+      std::vector<char> data;
+
+      /** \brief The compressed data. */
+      std::vector<char> compressed;
+
+      /** \brief Becomes ready when the block is compressed. */
+      std::future<void> done;
+    }; // struct block
+
+  public:
+    block_compressor(std::ostream& os, thread_pool& pool,
+                     std::size_t block_size = 1 << 20);
+    ~block_compressor();
+
+    void write(const char* p, std::size_t n);
+    void close();
+
+  private:
+    void submit();
+    void write_front();
+    void wait_pending();
+
+    static void compress(block& b);
+
+  private:
+    /** \brief The stream in which the file is written. */
+    std::ostream& m_stream;
+
+    /** \brief The threads compressing the blocks. */
+    thread_pool& m_pool;
+
+    /** \brief The index of the written blocks. */
+    block_index m_index;
+
+    /** \brief The data of the block not submitted yet. */
+    std::vector<char> m_data;
+
+    /** \brief The blocks submitted and not written yet, in order. */
+    std::deque<block> m_pending;
+
+    /** \brief The position in the file of the next written byte, relatively to
+        the header. */
+    unsigned long long m_offset;
+
+    /** \brief Tell if the index has been written. */
+    bool m_closed;
+
+  }; // class block_compressor
+}
+
+#include <claw/block_compressor.tpp>
+
+#endif // __CLAW_BLOCK_COMPRESSOR_HPP__
@@ -0,0 +1,182 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_compressor.tpp
+ * \brief Implementation of the claw::block_compressor class.
+ * \author Julien Jorge
+ */
+#include <algorithm>
+#include <cassert>
+
+/**
+ * \brief Constructor.
+ * \param os The stream in which the file is written.
+ * \param pool The threads compressing the blocks.
+ * \param block_size The size of the uncompressed blocks.
+ */
+template <typename Codec>
+claw::block_compressor<Codec>::block_compressor(std::ostream& os,
+                                                thread_pool& pool,
+                                                std::size_t block_size)
+  : m_stream(os)
+  , m_pool(pool)
+  , m_index(Codec::id, block_size)
+  , m_offset(block_index::header_size)
+  , m_closed(false)
+{
+  assert(block_size > 0);
+  assert(block_size <= block_index::max_block_size);
+
+  m_data.reserve(block_size);
+  m_index.write_header(m_stream);
+}
+
+/**
+ * \brief Destructor. Writes the pending blocks and the index if close() has
+ *        not been called.
+ */
+template <typename Codec>
+claw::block_compressor<Codec>::~block_compressor()
+{
+  if(!m_closed)
+    try
+      {
+        close();
+      }
+    catch(...)
+      {}
+
+  wait_pending();
+}
+
+/**
+ * \brief Write some data.
+ * \param p The data to write.
+ * \param n The number of bytes to write.
+ */
+template <typename Codec>
+void claw::block_compressor<Codec>::write(const char* p, std::size_t n)
+{
+  assert(!m_closed);
+
+  while(n != 0)
+    {
+      const std::size_t len =
+          std::min(n, m_index.block_size() - m_data.size());
+
+      m_data.insert(m_data.end(), p, p + len);
+      p += len;
+      n -= len;
+
+      if(m_data.size() == m_index.block_size())
+        submit();
+    }
+}
+
+/**
+ * \brief Compress the last block, then write all the pending blocks and the
+ *        index.
+ */
+template <typename Codec>
+void claw::block_compressor<Codec>::close()
+{
+  assert(!m_closed);
+
+  if(!m_data.empty())
+    submit();
+
+  while(!m_pending.empty())
+    write_front();
+
+  m_index.write(m_stream, m_offset);
+  m_closed = true;
+}
+
+/**
+ * \brief Start the compression of the current block, and write the oldest
+ *        blocks if there are too many of them in memory.
+ */
+template <typename Codec>
+void claw::block_compressor<Codec>::submit()
+{
+  m_pending.push_back(block());
+
+  block& b = m_pending.back();
+  b.data.swap(m_data);
+  b.done = m_pool.push(std::bind(&block_compressor<Codec>::compress,
+                                 std::ref(b)));
+
+  m_data.reserve(m_index.block_size());
+
+  while(m_pending.size() > 2 * m_pool.size())
+    write_front();
+}
+
+/**
+ * \brief Wait for the compression of the oldest pending block, then write it
+ *        in the stream.
+ */
+template <typename Codec>
+void claw::block_compressor<Codec>::write_front()
+{
+  assert(!m_pending.empty());
+
+  block& b = m_pending.front();
+  b.done.get();
+
+  block_index::entry e;
+  e.offset = m_offset;
+  e.compressed_size = b.compressed.size();
+  e.size = b.data.size();
+
+  m_stream.write(b.compressed.data(), b.compressed.size());
+  m_offset += b.compressed.size();
+  m_index.push_back(e);
+
+  m_pending.pop_front();
+}
+
+/**
+ * \brief Wait for the end of the tasks referencing the pending blocks.
+ */
+template <typename Codec>
+void claw::block_compressor<Codec>::wait_pending()
+{
+  for(std::size_t i = 0; i != m_pending.size(); ++i)
+    if(m_pending[i].done.valid())
+      m_pending[i].done.wait();
+}
+
+/**
+ * \brief Compress a block.
+ * \param b The block to compress.
+ */
+template <typename Codec>
+void claw::block_compressor<Codec>::compress(block& b)
+{
+  const char* const first = b.data.data();
+
+  Codec().encode(first, first + b.data.size(), b.compressed);
+}
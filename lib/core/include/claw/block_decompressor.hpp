@@ -0,0 +1,113 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_decompressor.hpp
+ * \brief A class uncompressing the files written by claw::block_compressor.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BLOCK_DECOMPRESSOR_HPP__
+#define __CLAW_BLOCK_DECOMPRESSOR_HPP__
+
+#include <claw/block_index.hpp>
+#include <claw/non_copyable.hpp>
+#include <claw/thread_pool.hpp>
+
+#include <deque>
+#include <future>
+#include <iostream>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A class uncompressing the files written by claw::block_compressor.
+   *
+   * The index of the file is read by the constructor. Then any block can be
+   * uncompressed alone with read_block(), or all of them can be uncompressed
+   * in parallel with read().
+   *
+   * \b Template \b parameters:
+   * - \a Codec The type of the codec uncompressing the blocks. It must be the
+   *   one used to compress the file.
+   *
+   * \author Julien Jorge
+   */
+  template <typename Codec>
+  class block_decompressor : public pattern::non_copyable
+  {
+  public:
+    /** \brief The type of the codec uncompressing the blocks. */
+    typedef Codec codec_type;
+
+  private:
+    /** \brief A block being uncompressed. */
+    struct block
+    {
+      /** \brief The compressed data. */
+      std::vector<char> compressed;
+
+      /** \brief Becomes ready when the block is uncompressed. */
+      std::future<void> done;
+    }; // struct block
+
+  public:
+    explicit block_decompressor(std::istream& is);
+
+    std::size_t block_count() const;
+    std::size_t block_size(std::size_t i) const;
+    unsigned long long size() const;
+
+    void read_block(std::size_t i, std::vector<char>& out);
+    void read(std::vector<char>& out, thread_pool& pool);
+
+  private:
+    void read_compressed(std::size_t i, std::vector<char>& compressed);
+    static void wait_front(std::deque<block>& pending);
+
+    static void uncompress(const std::vector<char>& compressed, char* out,
+                           std::size_t size);
+
+  private:
+    /** \brief The stream from which the file is read. */
+    std::istream& m_stream;
+
+    /** \brief The position of the header of the file in the stream. */
+    const std::istream::pos_type m_base;
+
+    /** \brief The index of the blocks. */
+    block_index m_index;
+
+    /** \brief The codec used by read_block(). */
+    codec_type m_codec;
+
+    /** \brief The compressed data of the last block read by read_block(). */
+    std::vector<char> m_compressed;
+
+  }; // class block_decompressor
+}
+
+#include <claw/block_decompressor.tpp>
+
+#endif // __CLAW_BLOCK_DECOMPRESSOR_HPP__
@@ -0,0 +1,194 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_decompressor.tpp
+ * \brief Implementation of the claw::block_decompressor class.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+
+#include <cassert>
+
+/**
+ * \brief Constructor.
+ * \param is The stream from which the file is read, positioned on its
+ *        header.
+ */
+template <typename Codec>
+claw::block_decompressor<Codec>::block_decompressor(std::istream& is)
+  : m_stream(is)
+  , m_base(is.tellg())
+{
+  m_index.read(m_stream);
+
+  if(m_index.codec() != Codec::id)
+    throw claw::bad_format("block_decompressor: unexpected codec.");
+}
+
+/**
+ * \brief Get the number of blocks in the file.
+ */
+template <typename Codec>
+std::size_t claw::block_decompressor<Codec>::block_count() const
+{
+  return m_index.size();
+}
+
+/**
+ * \brief Get the size of an uncompressed block.
+ * \param i The index of the block.
+ */
+template <typename Codec>
+std::size_t claw::block_decompressor<Codec>::block_size(std::size_t i) const
+{
+  return m_index[i].size;
+}
+
+/**
+ * \brief Get the size of the uncompressed data.
+ */
+template <typename Codec>
+unsigned long long claw::block_decompressor<Codec>::size() const
+{
+  unsigned long long result = 0;
+
+  for(std::size_t i = 0; i != m_index.size(); ++i)
+    result += m_index[i].size;
+
+  return result;
+}
+
+/**
+ * \brief Uncompress a block.
+ * \param i The index of the block.
+ * \param out (out) The uncompressed block.
+ */
+template <typename Codec>
+void claw::block_decompressor<Codec>::read_block(std::size_t i,
+                                                 std::vector<char>& out)
+{
+  read_compressed(i, m_compressed);
+  out.resize(m_index[i].size);
+
+  const char* const first = m_compressed.data();
+
+  if(m_codec.decode(first, first + m_compressed.size(), out.data(), out.size())
+     != out.size())
+    throw claw::bad_format("block_decompressor: corrupted block.");
+}
+
+/**
+ * \brief Uncompress all the blocks, in parallel.
+ * \param out (out) The uncompressed data.
+ * \param pool The threads uncompressing the blocks.
+ *
+ * The blocks are read sequentially from the stream and at most two blocks
+ * per thread are waiting to be uncompressed.
+ */
+template <typename Codec>
+void claw::block_decompressor<Codec>::read(std::vector<char>& out,
+                                           thread_pool& pool)
+{
+  out.resize(size());
+
+  std::deque<block> pending;
+  std::size_t offset = 0;
+
+  try
+    {
+      for(std::size_t i = 0; i != m_index.size(); ++i)
+        {
+          pending.push_back(block());
+
+          block& b = pending.back();
+          read_compressed(i, b.compressed);
+          b.done = pool.push(std::bind(&block_decompressor<Codec>::uncompress,
+                                       std::cref(b.compressed),
+                                       out.data() + offset, m_index[i].size));
+          offset += m_index[i].size;
+
+          while(pending.size() > 2 * pool.size())
+            wait_front(pending);
+        }
+
+      while(!pending.empty())
+        wait_front(pending);
+    }
+  catch(...)
+    {
+      for(std::size_t i = 0; i != pending.size(); ++i)
+        if(pending[i].done.valid())
+          pending[i].done.wait();
+
+      throw;
+    }
+}
+
+/**
+ * \brief Read the compressed data of a block.
+ * \param i The index of the block.
+ * \param compressed (out) The compressed data.
+ */
+template <typename Codec>
+void claw::block_decompressor<Codec>::read_compressed(
+    std::size_t i, std::vector<char>& compressed)
+{
+  const block_index::entry& e = m_index[i];
+
+  compressed.resize(e.compressed_size);
+  m_stream.seekg(m_base + (std::streamoff)e.offset);
+
+  if(!m_stream.read(compressed.data(), compressed.size()))
+    throw claw::bad_format("block_decompressor: truncated block.");
+}
+
+/**
+ * \brief Wait for the oldest pending block to be uncompressed and remove it.
+ * \param pending The blocks being uncompressed.
+ */
+template <typename Codec>
+void claw::block_decompressor<Codec>::wait_front(std::deque<block>& pending)
+{
+  assert(!pending.empty());
+
+  pending.front().done.get();
+  pending.pop_front();
+}
+
+/**
+ * \brief Uncompress a block.
+ * \param compressed The compressed data.
+ * \param out (out) The buffer receiving the uncompressed data.
+ * \param size The size of the uncompressed block.
+ */
+template <typename Codec>
+void claw::block_decompressor<Codec>::uncompress(
+    const std::vector<char>& compressed, char* out, std::size_t size)
+{
+  const char* const first = compressed.data();
+
+  if(Codec().decode(first, first + compressed.size(), out, size) != size)
+    throw claw::bad_format("block_decompressor: corrupted block.");
+}
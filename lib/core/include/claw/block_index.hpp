@@ -0,0 +1,122 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_index.hpp
+ * \brief The layout of the files written by claw::block_compressor.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BLOCK_INDEX_HPP__
+#define __CLAW_BLOCK_INDEX_HPP__
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief The layout of the files written by claw::block_compressor.
+   *
+   * A file is made of
+   * - a header of 12 bytes: the characters "CLWB", the version of the format,
+   *   the identifier of the codec, two zero bytes and the maximum size of an
+   *   uncompressed block on four bytes,
+   * - the compressed blocks, in the order of the uncompressed data,
+   * - the index, made of 16 bytes per block: the position of the block
+   *   relatively to the header on eight bytes, the size of the compressed
+   *   block on four bytes and the size of the uncompressed block on four
+   *   bytes,
+   * - a trailer of 16 bytes: the number of blocks on four bytes, the position
+   *   of the index relatively to the header on eight bytes and the characters
+   *   "CLWI".
+   *
+   * All integers are stored in little endian. The trailer must be at the end
+   * of the stream, such that the index can be found without reading the
+   * blocks.
+   *
+   * \author Julien Jorge
+   */
+  class block_index
+  {
+  public:
+    /** \brief The description of a block in the index. */
+    struct entry
+    {
+      /** \brief The position of the compressed block, relatively to the
+          header. */
+      unsigned long long offset;
+
+      /** \brief The size of the compressed block. */
+      std::size_t compressed_size;
+
+      /** \brief The size of the uncompressed block. */
+      std::size_t size;
+    }; // struct entry
+
+  public:
+    /** \brief The size of the header of the file. */
+    static const unsigned int header_size = 12;
+
+    /** \brief The maximum size of an uncompressed block, such that the size
+        of a compressed block fits on four bytes. */
+    static const std::size_t max_block_size = 1 << 30;
+
+  public:
+    inline block_index();
+    inline block_index(unsigned char codec, std::size_t block_size);
+
+    inline unsigned char codec() const;
+    inline std::size_t block_size() const;
+
+    inline std::size_t size() const;
+    inline const entry& operator[](std::size_t i) const;
+    inline void push_back(const entry& e);
+
+    inline void write_header(std::ostream& os) const;
+    inline void write(std::ostream& os, unsigned long long offset) const;
+    inline void read(std::istream& is);
+
+  private:
+    inline static void write_integer(std::ostream& os, unsigned long long v,
+                                     unsigned int n);
+    inline static unsigned long long read_integer(std::istream& is,
+                                                  unsigned int n);
+
+  private:
+    /** \brief The identifier of the codec of the blocks. */
+    unsigned char m_codec;
+
+    /** \brief The maximum size of an uncompressed block. */
+    std::size_t m_block_size;
+
+    /** \brief The description of the blocks. */
+    std::vector<entry> m_entries;
+
+  }; // class block_index
+}
+
+#include <claw/block_index.ipp>
+
+#endif // __CLAW_BLOCK_INDEX_HPP__
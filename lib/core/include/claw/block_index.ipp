@@ -0,0 +1,224 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file block_index.ipp
+ * \brief Implementation of the claw::block_index class.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+/**
+ * \brief Default constructor. The index must be read before being used.
+ */
+inline claw::block_index::block_index()
+  : m_codec(0)
+  , m_block_size(0)
+{}
+
+/**
+ * \brief Constructor.
+ * \param codec The identifier of the codec of the blocks.
+ * \param block_size The maximum size of an uncompressed block.
+ */
+inline claw::block_index::block_index(unsigned char codec,
+                                      std::size_t block_size)
+  : m_codec(codec)
+  , m_block_size(block_size)
+{}
+
+/**
+ * \brief Get the identifier of the codec of the blocks.
+ */
+inline unsigned char claw::block_index::codec() const
+{
+  return m_codec;
+}
+
+/**
+ * \brief Get the maximum size of an uncompressed block.
+ */
+inline std::size_t claw::block_index::block_size() const
+{
+  return m_block_size;
+}
+
+/**
+ * \brief Get the number of blocks.
+ */
+inline std::size_t claw::block_index::size() const
+{
+  return m_entries.size();
+}
+
+/**
+ * \brief Get the description of a block.
+ * \param i The index of the block.
+ */
+inline const claw::block_index::entry&
+claw::block_index::operator[](std::size_t i) const
+{
+  assert(i < m_entries.size());
+  return m_entries[i];
+}
+
+/**
+ * \brief Add a block at the end of the index.
+ * \param e The description of the block.
+ */
+inline void claw::block_index::push_back(const entry& e)
+{
+  m_entries.push_back(e);
+}
+
+/**
+ * \brief Write the header of the file.
+ * \param os The stream in which we write.
+ */
+inline void claw::block_index::write_header(std::ostream& os) const
+{
+  const char header[] = { 'C', 'L', 'W', 'B', 1, (char)m_codec, 0, 0 };
+
+  os.write(header, sizeof(header));
+  write_integer(os, m_block_size, 4);
+}
+
+/**
+ * \brief Write the index and the trailer of the file.
+ * \param os The stream in which we write.
+ * \param offset The position of the index, relatively to the header.
+ */
+inline void claw::block_index::write(std::ostream& os,
+                                     unsigned long long offset) const
+{
+  for(std::size_t i = 0; i != m_entries.size(); ++i)
+    {
+      write_integer(os, m_entries[i].offset, 8);
+      write_integer(os, m_entries[i].compressed_size, 4);
+      write_integer(os, m_entries[i].size, 4);
+    }
+
+  write_integer(os, m_entries.size(), 4);
+  write_integer(os, offset, 8);
+  os.write("CLWI", 4);
+}
+
+/**
+ * \brief Read the header and the index of a file.
+ * \param is The stream from which we read, positioned on the header. It is
+ *        left at an unspecified position.
+ */
+inline void claw::block_index::read(std::istream& is)
+{
+  const std::istream::pos_type base = is.tellg();
+  char magic[8];
+
+  if(!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, "CLWB"))
+    throw claw::bad_format("block_index: not a block file.");
+
+  if(magic[4] != 1)
+    throw claw::bad_format("block_index: unsupported version.");
+
+  m_codec = magic[5];
+  m_block_size = read_integer(is, 4);
+
+  if(m_block_size > max_block_size)
+    throw claw::bad_format("block_index: invalid block size.");
+
+  is.seekg(-16, std::ios_base::end);
+  const std::istream::pos_type trailer = is.tellg();
+  const std::size_t count = read_integer(is, 4);
+  const unsigned long long offset = read_integer(is, 8);
+
+  if(!is.read(magic, 4) || !std::equal(magic, magic + 4, "CLWI"))
+    throw claw::bad_format("block_index: missing trailer.");
+
+  if((trailer < base) || (offset > (unsigned long long)(trailer - base))
+     || ((unsigned long long)(trailer - base) - offset != 16ULL * count))
+    throw claw::bad_format("block_index: invalid index.");
+
+  is.seekg(base + (std::streamoff)offset);
+  m_entries.resize(count);
+
+  for(std::size_t i = 0; i != count; ++i)
+    {
+      m_entries[i].offset = read_integer(is, 8);
+      m_entries[i].compressed_size = read_integer(is, 4);
+      m_entries[i].size = read_integer(is, 4);
+
+      if((m_entries[i].offset < header_size)
+         || (m_entries[i].offset + m_entries[i].compressed_size > offset)
+         || (m_entries[i].size > m_block_size))
+        throw claw::bad_format("block_index: invalid index.");
+    }
+
+  if(!is)
+    throw claw::bad_format("block_index: truncated index.");
+}
+
+/**
+ * \brief Write an integer in little endian.
+ * \param os The stream in which we write.
+ * \param v The value to write.
+ * \param n The number of bytes to write.
+ */
+inline void claw::block_index::write_integer(std::ostream& os,
+                                             unsigned long long v,
+                                             unsigned int n)
+{
+  char bytes[8];
+
+  assert(n <= sizeof(bytes));
+
+  for(unsigned int i = 0; i != n; ++i, v >>= 8)
+    bytes[i] = v & 0xFF;
+
+  os.write(bytes, n);
+}
+
+/**
+ * \brief Read an integer stored in little endian.
+ * \param is The stream from which we read.
+ * \param n The number of bytes to read.
+ */
+inline unsigned long long claw::block_index::read_integer(std::istream& is,
+                                                          unsigned int n)
+{
+  unsigned char bytes[8];
+
+  assert(n <= sizeof(bytes));
+
+  if(!is.read(reinterpret_cast<char*>(bytes), n))
+    throw claw::bad_format("block_index: unexpected end of file.");
+
+  unsigned long long result = 0;
+
+  for(unsigned int i = n; i != 0; --i)
+    result = (result << 8) | bytes[i - 1];
+
+  return result;
+}
@@ -30,25 +30,39 @@
 #ifndef __CLAW_BUFFERED_ISTREAM_HPP__
 #define __CLAW_BUFFERED_ISTREAM_HPP__
 
+#include <claw/non_copyable.hpp>
+
 #include <iostream>
+#include <vector>
 
 namespace claw
 {
   /**
    * \brief This class is made to help reading istreams with a buffer.
+   *
+   * The buffer is filled as much as possible on each access to the stream and
+   * grows geometrically when a caller needs more bytes than it can hold. The
+   * storage can be provided by the caller, in which case it keeps its size
+   * once the buffer is destroyed and can be reused for the next stream.
+   *
+   * Since the bytes are read in advance, the stream must be seekable: close()
+   * moves its cursor back to the first byte not consumed from the buffer.
+   *
    * \author Julien Jorge
    */
   template <typename Stream>
-  class buffered_istream
+  class buffered_istream : public pattern::non_copyable
   {
   private:
     /** \brief The type of the stream we will read. */
     typedef Stream stream_type;
 
   public:
-    buffered_istream(stream_type& f);
+    explicit buffered_istream(stream_type& f, unsigned int capacity = 1024);
+    buffered_istream(stream_type& f, std::vector<char>& buffer);
     ~buffered_istream();
 
+    unsigned int capacity() const;
     unsigned int remaining() const;
     bool read_more(unsigned int n);
 
@@ -58,14 +72,23 @@ namespace claw
 
     void move(unsigned int n);
 
-    void close();
+    bool close();
 
     operator bool() const;
 
+  private:
+    void reserve(unsigned int n);
+
   private:
     /** \brief The stream we're reading. */
     stream_type& m_stream;
 
+    /** \brief The storage of the buffer when not provided by the caller. */
+    std::vector<char> m_own_buffer;
+
+    /** \brief The storage of the buffer. */
+    std::vector<char>& m_buffer;
+
     /** \brief Pointer to the begining of the buffer. */
     char* m_begin;
 
@@ -76,9 +99,6 @@ namespace claw
     /** \brief Pointer to the current not already read valid byte. */
     char* m_current;
 
-    /** \brief The size of the allocated buffer. */
-    unsigned int m_buffer_size;
-
   }; // class buffered_istream
 }
 
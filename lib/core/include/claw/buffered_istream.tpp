@@ -27,21 +27,43 @@
  * \brief Implementation of the claw::buffered_istream class.
  * \author Julien Jorge
  */
+#include <algorithm>
 #include <cassert>
 
 /**
  * \brief Constructor.
  * \param f The file associated to the stream.
+ * \param capacity The initial size of the buffer.
  */
 template <typename Stream>
-claw::buffered_istream<Stream>::buffered_istream(stream_type& f)
+claw::buffered_istream<Stream>::buffered_istream(stream_type& f,
+                                                 unsigned int capacity)
   : m_stream(f)
-  , m_begin(NULL)
-  , m_end(NULL)
-  , m_current(NULL)
-  , m_buffer_size(1024)
+  , m_own_buffer(std::max(capacity, 1u))
+  , m_buffer(m_own_buffer)
 {
-  m_begin = new char[m_buffer_size];
+  m_begin = &m_buffer[0];
+  m_end = m_begin;
+  m_current = m_end;
+}
+
+/**
+ * \brief Constructor using a buffer provided by the caller.
+ * \param f The file associated to the stream.
+ * \param buffer The storage of the buffer. Its size is the initial capacity
+ *        and it is resized when the buffer grows. It must outlive this
+ *        instance.
+ */
+template <typename Stream>
+claw::buffered_istream<Stream>::buffered_istream(stream_type& f,
+                                                 std::vector<char>& buffer)
+  : m_stream(f)
+  , m_buffer(buffer)
+{
+  if(m_buffer.empty())
+    m_buffer.resize(1024);
+
+  m_begin = &m_buffer[0];
   m_end = m_begin;
   m_current = m_end;
 }
@@ -53,9 +75,15 @@ template <typename Stream>
 claw::buffered_istream<Stream>::~buffered_istream()
 {
   close();
+}
 
-  if(m_begin)
-    delete[] m_begin;
+/**
+ * \brief Get the size of the buffer.
+ */
+template <typename Stream>
+unsigned int claw::buffered_istream<Stream>::capacity() const
+{
+  return m_buffer.size();
 }
 
 /**
@@ -70,7 +98,8 @@ unsigned int claw::buffered_istream<Stream>::remaining() const
 /**
  * \brief Increase the number of ready bytes to a given number.
  * \param n The number of bytes you need.
- * \remark This method reads n - remaining() bytes from the file.
+ * \remark This method reads at least n - remaining() bytes from the file and
+ *         fills the rest of the buffer if possible.
  */
 template <typename Stream>
 bool claw::buffered_istream<Stream>::read_more(unsigned int n)
@@ -78,35 +107,12 @@ bool claw::buffered_istream<Stream>::read_more(unsigned int n)
   if(n <= remaining())
     return true;
 
-  unsigned int r = remaining();
-
-  // we'll reach the end of the buffer
-  if(m_current + n > m_begin + m_buffer_size)
-    {
-      // try to avoid reallocation
-      if(n <= m_buffer_size)
-        std::copy(m_current, m_end, m_begin);
-      else // not enough space in the buffer
-        {
-          m_buffer_size = n;
-
-          char* new_buffer = new char[m_buffer_size];
-
-          std::copy(m_current, m_end, new_buffer);
-
-          delete[] m_begin;
+  reserve(n);
 
-          m_begin = new_buffer;
-        }
-
-      m_current = m_begin;
-      m_end = m_current + r;
-    }
-
-  m_stream.read(m_end, n - r);
+  m_stream.read(m_end, m_begin + m_buffer.size() - m_end);
   m_end += m_stream.gcount();
 
-  return !!m_stream;
+  return n <= remaining();
 }
 
 /**
@@ -143,7 +149,7 @@ bool claw::buffered_istream<Stream>::read(char* buf, unsigned int n)
   while((n != 0) && !!(*this))
     {
       if(n > remaining())
-        read_more(m_buffer_size);
+        read_more(capacity());
 
       unsigned int len = std::min(n, remaining());
 
@@ -171,14 +177,40 @@ void claw::buffered_istream<Stream>::move(unsigned int n)
  * \brief Closes this buffer (not the stream).
  *
  * The cursor of the stream is repositioned according to the remaining data,
- * and the buffer is cleared.
+ * and the buffer is cleared. The end of the stream reached by the read-ahead
+ * is forgotten, the other state flags of the stream are kept.
+ *
+ * \return false if the cursor of the stream could not be moved back, in which
+ *         case the failbit of the stream is set.
  */
 template <typename Stream>
-void claw::buffered_istream<Stream>::close()
+bool claw::buffered_istream<Stream>::close()
 {
-  m_stream.seekg(m_current - m_end, std::ios_base::cur);
+  bool result = true;
+
+  if(m_current != m_end)
+    {
+      const std::ios_base::iostate state = m_stream.rdstate();
+
+      // the read-ahead may have reached the end of the stream, which would
+      // prevent the seek.
+      m_stream.clear();
+      m_stream.seekg(m_current - m_end, std::ios_base::cur);
+
+      if(m_stream.fail())
+        {
+          m_stream.setstate(state);
+          result = false;
+        }
+      else
+        m_stream.clear(state
+                       & ~(std::ios_base::eofbit | std::ios_base::failbit));
+    }
+
   m_current = m_begin;
   m_end = m_begin;
+
+  return result;
 }
 
 /**
@@ -189,3 +221,29 @@ claw::buffered_istream<Stream>::operator bool() const
 {
   return m_stream || (remaining() > 0);
 }
+
+/**
+ * \brief Make room at the end of the buffer such that n bytes can be stored
+ *        after the current position.
+ * \param n The number of bytes we need after the current position.
+ *
+ * The remaining bytes are moved to the beginning of the buffer, and the buffer
+ * is grown to at least twice its size if it is still too small.
+ */
+template <typename Stream>
+void claw::buffered_istream<Stream>::reserve(unsigned int n)
+{
+  if(m_current + n <= m_begin + m_buffer.size())
+    return;
+
+  const unsigned int r = remaining();
+
+  std::copy(m_current, m_end, m_begin);
+
+  if(n > m_buffer.size())
+    m_buffer.resize(std::max(n, 2 * (unsigned int)m_buffer.size()));
+
+  m_begin = &m_buffer[0];
+  m_current = m_begin;
+  m_end = m_current + r;
+}
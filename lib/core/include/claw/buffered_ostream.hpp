@@ -30,23 +30,35 @@
 #ifndef __CLAW_BUFFERED_OSTREAM_HPP__
 #define __CLAW_BUFFERED_OSTREAM_HPP__
 
+#include <claw/non_copyable.hpp>
+
+#include <vector>
+
 namespace claw
 {
   /**
    * \brief This class is made to help writing in ostreams with a buffer.
+   *
+   * Ranges larger than the buffer are passed directly to the stream, after the
+   * pending bytes, instead of being copied through the buffer. The storage
+   * can be provided by the caller to be reused for several streams.
+   *
    * \author Julien Jorge
    */
   template <typename Stream>
-  class buffered_ostream
+  class buffered_ostream : public pattern::non_copyable
   {
   private:
     /** \brief The type of the stream we will write. */
     typedef Stream stream_type;
 
   public:
-    buffered_ostream(stream_type& f, unsigned int buffer_size = 1024);
+    explicit buffered_ostream(stream_type& f, unsigned int buffer_size = 4096);
+    buffered_ostream(stream_type& f, std::vector<char>& buffer);
     ~buffered_ostream();
 
+    unsigned int capacity() const;
+
     template <typename T>
     void write(T v);
 
@@ -58,12 +70,18 @@ namespace claw
     /** \brief The stream we're writing. */
     stream_type& m_stream;
 
+    /** \brief The storage of the buffer when not provided by the caller. */
+    std::vector<char> m_own_buffer;
+
+    /** \brief The storage of the buffer. */
+    std::vector<char>& m_buffer;
+
     /** \brief Pointer to the begining of the buffer. */
-    char* const m_begin;
+    char* m_begin;
 
     /** \brief Pointer to the first invalid byte after the end of the
         buffer. */
-    char* const m_end;
+    char* m_end;
 
     /** \brief Pointer to the current not already read valid byte. */
     char* m_current;
@@ -27,6 +27,7 @@
  * \brief Implementation of the claw::buffered_ostream class.
  * \author Julien Jorge
  */
+#include <algorithm>
 #include <cassert>
 
 /**
@@ -38,11 +39,33 @@ template <typename Stream>
 claw::buffered_ostream<Stream>::buffered_ostream(stream_type& f,
                                                  unsigned int buffer_size)
   : m_stream(f)
-  , m_begin(new char[buffer_size])
-  , m_end(m_begin + buffer_size)
+  , m_own_buffer(std::max(buffer_size, 1u))
+  , m_buffer(m_own_buffer)
+  , m_begin(&m_buffer[0])
+  , m_end(m_begin + m_buffer.size())
   , m_current(m_begin)
 {}
 
+/**
+ * \brief Constructor using a buffer provided by the caller.
+ * \param f The file associated to the stream.
+ * \param buffer The storage of the buffer. It is resized to a default size if
+ *        it is empty and must outlive this instance.
+ */
+template <typename Stream>
+claw::buffered_ostream<Stream>::buffered_ostream(stream_type& f,
+                                                 std::vector<char>& buffer)
+  : m_stream(f)
+  , m_buffer(buffer)
+{
+  if(m_buffer.empty())
+    m_buffer.resize(4096);
+
+  m_begin = &m_buffer[0];
+  m_end = m_begin + m_buffer.size();
+  m_current = m_begin;
+}
+
 /**
  * \brief Destructor.
  */
@@ -50,7 +73,15 @@ template <typename Stream>
 claw::buffered_ostream<Stream>::~buffered_ostream()
 {
   flush();
-  delete[] m_begin;
+}
+
+/**
+ * \brief Get the size of the buffer.
+ */
+template <typename Stream>
+unsigned int claw::buffered_ostream<Stream>::capacity() const
+{
+  return m_end - m_begin;
 }
 
 /**
@@ -72,18 +103,22 @@ void claw::buffered_ostream<Stream>::write(T v)
 template <typename Stream>
 void claw::buffered_ostream<Stream>::write(const char* p, unsigned int n)
 {
-  while(n > 0)
+  if(n >= capacity())
     {
-      unsigned int q = std::min(n, (unsigned int)(m_end - m_current));
-      const char* end = p + q;
+      // A copy in the buffer would not save any access to the stream.
+      flush();
+      m_stream.write(p, n);
+      return;
+    }
 
-      for(; p != end; ++p, ++m_current)
-        *m_current = *p;
+  unsigned int q = std::min(n, (unsigned int)(m_end - m_current));
 
-      n -= q;
+  m_current = std::copy(p, p + q, m_current);
 
-      if(m_current == m_end)
-        flush();
+  if(m_current == m_end)
+    {
+      flush();
+      m_current = std::copy(p + q, p + n, m_current);
     }
 }
 
@@ -0,0 +1,92 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file byte_set.hpp
+ * \brief A set of bytes, optimized to find the first byte of a string
+ *        belonging to the set.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BYTE_SET_HPP__
+#define __CLAW_BYTE_SET_HPP__
+
+#include <cstddef>
+
+namespace claw
+{
+  namespace text
+  {
+    /**
+     * \brief A set of bytes, optimized to find the first byte of a string
+     *        belonging to the set.
+     *
+     * The search processes the string by blocks of 16 or 32 bytes with SIMD
+     * instructions, when they are available and when the set is small
+     * enough. The AVX2 instructions are used only if the processor running
+     * the program supports them.
+     *
+     * \author Julien Jorge
+     */
+    class byte_set
+    {
+    public:
+      /** \brief The maximum number of bytes in the set for which the search
+          is done with SIMD instructions. */
+      static const std::size_t max_vector_size = 8;
+
+    public:
+      inline byte_set();
+      inline byte_set(const char* first, const char* last);
+
+      inline void insert(char c);
+      inline bool contains(char c) const;
+      inline std::size_t size() const;
+
+      inline const char* find_first_of(const char* first,
+                                       const char* last) const;
+
+    private:
+      inline const char* skip_sse2(const char* first, const char* last) const;
+      inline const char* skip_avx2(const char* first, const char* last) const;
+
+      inline static bool has_avx2();
+
+    private:
+      /** \brief Tell for each byte if it is in the set. */
+      bool m_contains[256];
+
+      /** \brief The bytes of the set, in the order of their insertion. Only
+          the first max_vector_size bytes are kept. */
+      char m_bytes[max_vector_size];
+
+      /** \brief The number of bytes in the set. */
+      std::size_t m_size;
+
+    }; // class byte_set
+  }
+}
+
+#include <claw/byte_set.ipp>
+
+#endif // __CLAW_BYTE_SET_HPP__
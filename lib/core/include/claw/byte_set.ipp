@@ -0,0 +1,238 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file byte_set.ipp
+ * \brief Implementation of the claw::text::byte_set class.
+ * \author Julien Jorge
+ */
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CLAW_BYTE_SET_AVX2
+#endif
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor of an empty set.
+ */
+inline claw::text::byte_set::byte_set()
+  : m_bytes()
+  , m_size(0)
+{
+  std::fill(m_contains, m_contains + 256, false);
+} // byte_set::byte_set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param first Pointer on the first byte to put in the set.
+ * \param last Pointer just past the last byte to put in the set.
+ */
+inline claw::text::byte_set::byte_set(const char* first, const char* last)
+  : m_bytes()
+  , m_size(0)
+{
+  std::fill(m_contains, m_contains + 256, false);
+
+  for(; first != last; ++first)
+    insert(*first);
+} // byte_set::byte_set()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Add a byte in the set.
+ * \param c The byte to add.
+ */
+inline void claw::text::byte_set::insert(char c)
+{
+  if(contains(c))
+    return;
+
+  m_contains[static_cast<unsigned char>(c)] = true;
+
+  if(m_size < max_vector_size)
+    m_bytes[m_size] = c;
+
+  ++m_size;
+} // byte_set::insert()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if a byte is in the set.
+ * \param c The byte to check.
+ */
+inline bool claw::text::byte_set::contains(char c) const
+{
+  return m_contains[static_cast<unsigned char>(c)];
+} // byte_set::contains()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of bytes in the set.
+ */
+inline std::size_t claw::text::byte_set::size() const
+{
+  return m_size;
+} // byte_set::size()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Find the first byte of a string which is in the set.
+ * \param first Pointer on the first byte of the string.
+ * \param last Pointer just past the last byte of the string.
+ * \return A pointer on the found byte, or \a last if there is none.
+ */
+inline const char* claw::text::byte_set::find_first_of(const char* first,
+                                                       const char* last) const
+{
+  if(m_size == 0)
+    return last;
+
+  if(m_size == 1)
+    {
+      const void* const result(std::memchr(first, m_bytes[0], last - first));
+
+      if(result == NULL)
+        return last;
+      else
+        return static_cast<const char*>(result);
+    }
+
+  if(m_size <= max_vector_size)
+    {
+      if(has_avx2())
+        first = skip_avx2(first, last);
+
+      first = skip_sse2(first, last);
+    }
+
+  while((first != last) && !contains(*first))
+    ++first;
+
+  return first;
+} // byte_set::find_first_of()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Skip the blocks of 16 bytes of a string having no byte in the set.
+ * \param first Pointer on the first byte of the string.
+ * \param last Pointer just past the last byte of the string.
+ * \return A pointer on the first byte of the string which is in the set, or
+ *         on the remaining bytes, less than a block, to be checked one by one.
+ * \pre 1 < size() <= max_vector_size
+ */
+inline const char* claw::text::byte_set::skip_sse2(const char* first,
+                                                   const char* last) const
+{
+#if defined(__SSE2__)
+  __m128i bytes[max_vector_size];
+
+  for(std::size_t i = 0; i != m_size; ++i)
+    bytes[i] = _mm_set1_epi8(m_bytes[i]);
+
+  for(; last - first >= 16; first += 16)
+    {
+      const __m128i block(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(first)));
+      __m128i found(_mm_cmpeq_epi8(block, bytes[0]));
+
+      for(std::size_t i = 1; i != m_size; ++i)
+        found = _mm_or_si128(found, _mm_cmpeq_epi8(block, bytes[i]));
+
+      const int mask(_mm_movemask_epi8(found));
+
+      if(mask != 0)
+        return first + __builtin_ctz(mask);
+    }
+#endif
+
+  return first;
+} // byte_set::skip_sse2()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Skip the blocks of 32 bytes of a string having no byte in the set.
+ * \param first Pointer on the first byte of the string.
+ * \param last Pointer just past the last byte of the string.
+ * \return A pointer on the first byte of the string which is in the set, or
+ *         on the remaining bytes, less than a block, to be checked with
+ *         smaller blocks.
+ * \pre 1 < size() <= max_vector_size and has_avx2()
+ */
+#if defined(CLAW_BYTE_SET_AVX2)
+__attribute__((target("avx2")))
+#endif
+inline const char*
+claw::text::byte_set::skip_avx2(const char* first, const char* last) const
+{
+#if defined(CLAW_BYTE_SET_AVX2)
+  __m256i bytes[max_vector_size];
+
+  for(std::size_t i = 0; i != m_size; ++i)
+    bytes[i] = _mm256_set1_epi8(m_bytes[i]);
+
+  for(; last - first >= 32; first += 32)
+    {
+      const __m256i block(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first)));
+      __m256i found(_mm256_cmpeq_epi8(block, bytes[0]));
+
+      for(std::size_t i = 1; i != m_size; ++i)
+        found = _mm256_or_si256(found, _mm256_cmpeq_epi8(block, bytes[i]));
+
+      const unsigned int mask(_mm256_movemask_epi8(found));
+
+      if(mask != 0)
+        return first + __builtin_ctz(mask);
+    }
+#endif
+
+  return first;
+} // byte_set::skip_avx2()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Tell if the processor running the program supports the AVX2
+ *        instructions.
+ */
+inline bool claw::text::byte_set::has_avx2()
+{
+#if defined(CLAW_BYTE_SET_AVX2)
+  // The processor is checked once, on the first call.
+  static const bool result((__builtin_cpu_init(),
+                            __builtin_cpu_supports("avx2")));
+  return result;
+#else
+  return false;
+#endif
+} // byte_set::has_avx2()
+
+#undef CLAW_BYTE_SET_AVX2
@@ -0,0 +1,138 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file compiled_automaton.hpp
+ * \brief A deterministic automaton stored as a flat transition table, for
+ *        fast matching.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_COMPILED_AUTOMATON_HPP__
+#define __CLAW_COMPILED_AUTOMATON_HPP__
+
+#include <claw/symbol_table.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace claw
+{
+  template <class State, class Edge, class StateComp, class EdgeComp>
+  class automaton;
+
+  /**
+   * \brief A deterministic automaton stored as a flat transition table, for
+   *        fast matching.
+   *
+   * A compiled_automaton is built by automaton::compile(). Its states and its
+   * symbols are numbered densely, such that reading a symbol costs a single
+   * lookup in the table. The table is complete: the missing transitions of
+   * the initial automaton go to a dead state, from which no final state can
+   * be reached.
+   *
+   * The matching can be done on a whole sequence with match(), or on a
+   * sequence received by chunks by passing the state returned by run() for a
+   * chunk to the call to run() for the next chunk.
+   *
+   * \b Template \b parameters
+   * - \a Edge The type of the symbols in the alphabet.
+   * - \a EdgeComp The type of the operator used to compare the symbols.
+   *
+   * \author Julien Jorge
+   */
+  template <class Edge, class EdgeComp = std::less<Edge> >
+  class compiled_automaton
+  {
+    template <class S, class E, class SC, class EC>
+    friend class automaton;
+
+  public:
+    /** \brief The type of the states. */
+    typedef unsigned int state_type;
+
+    /** \brief The type of the symbols on the edges. */
+    typedef Edge edge_type;
+
+    /** \brief The type of the operator used to compare edge symbols. */
+    typedef EdgeComp edge_compare;
+
+  public:
+    compiled_automaton();
+
+    state_type initial_state() const;
+    bool is_final(state_type s) const;
+    bool is_dead(state_type s) const;
+
+    state_type next_state(state_type s, const edge_type& e) const;
+
+    template <class InputIterator>
+    state_type run(state_type s, InputIterator first,
+                   InputIterator last) const;
+
+    template <class InputIterator>
+    bool match(InputIterator first, InputIterator last) const;
+
+    template <class ForwardIterator>
+    bool longest_match(ForwardIterator first, ForwardIterator last,
+                       ForwardIterator& end) const;
+
+    unsigned int states_count() const;
+    unsigned int symbols_count() const;
+
+  private:
+    void assign(const std::vector<edge_type>& symbols,
+                const std::vector<unsigned int>& transitions,
+                const std::vector<bool>& finals);
+
+    std::size_t column(const edge_type& e) const;
+
+  private:
+    /** \brief The symbols of the alphabet. The column of a symbol is its
+        index in this table. The last column is used for the symbols not in
+        the alphabet. */
+    symbol_table<edge_type, edge_compare> m_symbols;
+
+    /** \brief The number of columns in the table. */
+    std::size_t m_columns;
+
+    /** \brief The transitions. The target of the transition from the state s
+        with a symbol in the column c is m_transitions[s * m_columns + c]. */
+    std::vector<state_type> m_transitions;
+
+    /** \brief Tell for each state if it is final. */
+    std::vector<bool> m_finals;
+
+    /** \brief The initial state. */
+    state_type m_initial_state;
+
+    /** \brief The state from which no final state can be reached. */
+    state_type m_dead_state;
+
+  }; // class compiled_automaton
+}
+
+#include <claw/compiled_automaton.tpp>
+
+#endif // __CLAW_COMPILED_AUTOMATON_HPP__
@@ -0,0 +1,219 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file compiled_automaton.tpp
+ * \brief Implementation of the claw::compiled_automaton class.
+ * \author Julien Jorge
+ */
+
+/**
+ * \brief Constructor. The automaton recognizes nothing.
+ */
+template <class Edge, class EdgeComp>
+claw::compiled_automaton<Edge, EdgeComp>::compiled_automaton()
+{
+  assign(std::vector<edge_type>(), std::vector<unsigned int>(),
+         std::vector<bool>());
+}
+
+/**
+ * \brief Get the initial state.
+ */
+template <class Edge, class EdgeComp>
+typename claw::compiled_automaton<Edge, EdgeComp>::state_type
+claw::compiled_automaton<Edge, EdgeComp>::initial_state() const
+{
+  return m_initial_state;
+}
+
+/**
+ * \brief Tell if a state is final.
+ * \param s The state to check.
+ */
+template <class Edge, class EdgeComp>
+bool claw::compiled_automaton<Edge, EdgeComp>::is_final(state_type s) const
+{
+  return m_finals[s];
+}
+
+/**
+ * \brief Tell if no final state can be reached from a given state.
+ * \param s The state to check.
+ */
+template <class Edge, class EdgeComp>
+bool claw::compiled_automaton<Edge, EdgeComp>::is_dead(state_type s) const
+{
+  return s == m_dead_state;
+}
+
+/**
+ * \brief Get the state reached from a given state with a given symbol.
+ * \param s The source state.
+ * \param e The symbol.
+ */
+template <class Edge, class EdgeComp>
+typename claw::compiled_automaton<Edge, EdgeComp>::state_type
+claw::compiled_automaton<Edge, EdgeComp>::next_state(state_type s,
+                                                     const edge_type& e) const
+{
+  return m_transitions[s * m_columns + column(e)];
+}
+
+/**
+ * \brief Read a sequence of symbols from a given state.
+ * \param s The state from which the symbols are read.
+ * \param first Iterator on the first symbol.
+ * \param last Iterator after the last symbol.
+ * \return The state reached after the last symbol.
+ *
+ * The reading stops as soon as the dead state is reached.
+ */
+template <class Edge, class EdgeComp>
+template <class InputIterator>
+typename claw::compiled_automaton<Edge, EdgeComp>::state_type
+claw::compiled_automaton<Edge, EdgeComp>::run(state_type s,
+                                              InputIterator first,
+                                              InputIterator last) const
+{
+  for(; (first != last) && (s != m_dead_state); ++first)
+    s = m_transitions[s * m_columns + column(*first)];
+
+  return s;
+}
+
+/**
+ * \brief Tell if the automaton recognizes a given pattern.
+ * \param first Iterator on the first symbol in the pattern.
+ * \param last Iterator after the last symbol in the pattern.
+ */
+template <class Edge, class EdgeComp>
+template <class InputIterator>
+bool claw::compiled_automaton<Edge, EdgeComp>::match(InputIterator first,
+                                                     InputIterator last) const
+{
+  return is_final(run(m_initial_state, first, last));
+}
+
+/**
+ * \brief Find the longest prefix of a sequence recognized by the automaton.
+ * \param first Iterator on the first symbol of the sequence.
+ * \param last Iterator after the last symbol of the sequence.
+ * \param end (out) Iterator after the last symbol of the longest recognized
+ *        prefix, if any.
+ * \return true if a prefix, maybe empty, is recognized.
+ */
+template <class Edge, class EdgeComp>
+template <class ForwardIterator>
+bool claw::compiled_automaton<Edge, EdgeComp>::longest_match(
+    ForwardIterator first, ForwardIterator last, ForwardIterator& end) const
+{
+  state_type s(m_initial_state);
+  bool result(is_final(s));
+
+  if(result)
+    end = first;
+
+  while((first != last) && (s != m_dead_state))
+    {
+      s = m_transitions[s * m_columns + column(*first)];
+      ++first;
+
+      if(is_final(s))
+        {
+          result = true;
+          end = first;
+        }
+    }
+
+  return result;
+}
+
+/**
+ * \brief Get the number of states, including the dead state.
+ */
+template <class Edge, class EdgeComp>
+unsigned int claw::compiled_automaton<Edge, EdgeComp>::states_count() const
+{
+  return m_finals.size();
+}
+
+/**
+ * \brief Get the number of symbols in the alphabet.
+ */
+template <class Edge, class EdgeComp>
+unsigned int claw::compiled_automaton<Edge, EdgeComp>::symbols_count() const
+{
+  return m_symbols.size();
+}
+
+/**
+ * \brief Build the table from the one of a deterministic automaton.
+ * \param symbols The symbols of the alphabet, sorted.
+ * \param transitions The transition table. The target of the transition from
+ *        state s with symbols[c] is transitions[s * symbols.size() + c]. A
+ *        target greater or equal to finals.size() means that there is no
+ *        transition.
+ * \param finals Tell for each state if it is final.
+ *
+ * The initial state is zero, if any.
+ */
+template <class Edge, class EdgeComp>
+void claw::compiled_automaton<Edge, EdgeComp>::assign(
+    const std::vector<edge_type>& symbols,
+    const std::vector<unsigned int>& transitions,
+    const std::vector<bool>& finals)
+{
+  const std::size_t n(finals.size());
+
+  m_symbols = symbol_table<edge_type, edge_compare>(symbols);
+  m_columns = symbols.size() + 1;
+  m_dead_state = n;
+  m_initial_state = (n == 0) ? m_dead_state : 0;
+
+  m_transitions.assign((n + 1) * m_columns, m_dead_state);
+
+  for(std::size_t s = 0; s != n; ++s)
+    for(std::size_t c = 0; c != symbols.size(); ++c)
+      {
+        const unsigned int t(transitions[s * symbols.size() + c]);
+
+        if(t < n)
+          m_transitions[s * m_columns + c] = t;
+      }
+
+  m_finals = finals;
+  m_finals.push_back(false);
+}
+
+/**
+ * \brief Get the column of a symbol in the table.
+ * \param e The symbol.
+ */
+template <class Edge, class EdgeComp>
+std::size_t
+claw::compiled_automaton<Edge, EdgeComp>::column(const edge_type& e) const
+{
+  return m_symbols.find(e);
+}
@@ -30,6 +30,12 @@
 #ifndef __CLAW_GLOB_HPP__
 #define __CLAW_GLOB_HPP__
 
+#include <claw/symbol_table.hpp>
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
 namespace claw
 {
   template <typename InputIterator1, typename InputIterator2>
@@ -47,6 +53,158 @@ namespace claw
                             typename InputIterator1::value_type zero_or_one,
                             typename InputIterator1::value_type any);
 
+  /**
+   * \brief A set of glob patterns compiled into a deterministic automaton, to
+   *        check a sequence against all the patterns in a single pass.
+   *
+   * The patterns are given at construction time and the automaton is built
+   * once for all. Then, checking a sequence costs one table lookup per value
+   * of the sequence, without any backtracking, whatever the number of
+   * patterns.
+   *
+   * \b Template \b parameters:
+   * - \a T The type of the values in the patterns and in the sequences. It
+   *   must be comparable with operator<.
+   *
+   * \author Julien Jorge
+   */
+  template <typename T>
+  class glob_set
+  {
+  public:
+    /** \brief The type of the values in the patterns. */
+    typedef T value_type;
+
+  private:
+    /** \brief A set of positions in the patterns, i.e. a state of the
+        nondeterministic automaton. */
+    typedef std::vector<std::size_t> position_set;
+
+  public:
+    template <typename PatternIterator>
+    glob_set(PatternIterator first, PatternIterator last,
+             value_type any_sequence, value_type zero_or_one, value_type any);
+
+    std::size_t size() const;
+
+    template <typename InputIterator>
+    bool match(InputIterator first, InputIterator last) const;
+
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator match_all(InputIterator first, InputIterator last,
+                             OutputIterator out) const;
+
+    template <typename InputIterator>
+    bool potential_match(InputIterator first, InputIterator last) const;
+
+  private:
+    template <typename InputIterator>
+    std::size_t run(InputIterator first, InputIterator last) const;
+
+    void build_symbol_classes(const std::vector<value_type>& patterns,
+                              const std::vector<std::size_t>& pattern_index);
+
+    void build_automaton(const std::vector<value_type>& patterns,
+                         const std::vector<std::size_t>& pattern_index);
+
+    void closure(const std::vector<value_type>& patterns,
+                 const std::vector<std::size_t>& pattern_index,
+                 position_set& s) const;
+
+    std::size_t add_state(const position_set& s,
+                          std::map<position_set, std::size_t>& states,
+                          std::vector<position_set>& sets,
+                          const std::vector<std::size_t>& pattern_index);
+
+    void find_alive_states();
+
+    bool is_special(const value_type& v) const;
+
+  private:
+    /** \brief The value representing any sequence of values, empty or
+        not. */
+    const value_type m_any_sequence;
+
+    /** \brief The value representing any value or no value. */
+    const value_type m_zero_or_one;
+
+    /** \brief The value representing any value. */
+    const value_type m_any;
+
+    /** \brief The number of patterns in the set. */
+    std::size_t m_patterns_count;
+
+    /** \brief The literal values appearing in the patterns. The class of a
+        value is its index in this table, every other value being in the
+        class m_symbols.size(). */
+    symbol_table<value_type> m_symbols;
+
+    /** \brief The number of symbol classes, including the class of the
+        values not appearing in the patterns. */
+    std::size_t m_classes_count;
+
+    /** \brief The transitions of the automaton. The target of the transition
+        from state s with the symbol class c is
+        m_transitions[s * m_classes_count + c]. State zero is the dead state
+        and state one is the initial state. */
+    std::vector<std::size_t> m_transitions;
+
+    /** \brief For each state, the indices of the patterns matched by the
+        sequences ending in this state. */
+    std::vector<std::vector<std::size_t> > m_accepted;
+
+    /** \brief For each state, tell if an accepting state can be reached from
+        it. */
+    std::vector<bool> m_alive;
+
+    /** \brief The state from which the sequences are read. */
+    std::size_t m_initial_state;
+
+  }; // class glob_set
+
+  /**
+   * \brief A glob pattern compiled into a deterministic automaton, to check
+   *        many sequences against the same pattern.
+   *
+   * The result of match() is the same than the one of glob_match(), but the
+   * sequence is checked in linear time, without backtracking.
+   *
+   * \b Template \b parameters:
+   * - \a T The type of the values in the pattern and in the sequences. It
+   *   must be comparable with operator<.
+   *
+   * \author Julien Jorge
+   */
+  template <typename T>
+  class compiled_glob
+  {
+  public:
+    /** \brief The type of the values in the pattern. */
+    typedef T value_type;
+
+  public:
+    template <typename InputIterator>
+    compiled_glob(InputIterator first, InputIterator last,
+                  value_type any_sequence, value_type zero_or_one,
+                  value_type any);
+
+    template <typename InputIterator>
+    bool match(InputIterator first, InputIterator last) const;
+
+    template <typename InputIterator>
+    bool potential_match(InputIterator first, InputIterator last) const;
+
+  private:
+    compiled_glob(const std::vector<value_type>& pattern,
+                  value_type any_sequence, value_type zero_or_one,
+                  value_type any);
+
+  private:
+    /** \brief The automaton of the pattern. */
+    glob_set<value_type> m_automaton;
+
+  }; // class compiled_glob
+
 }
 
 #include <claw/glob.tpp>
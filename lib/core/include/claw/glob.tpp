@@ -27,6 +27,8 @@
  * \brief Implementation of the globalization algorithms.
  * \author Julien Jorge
  */
+#include <algorithm>
+#include <iterator>
 
 /**
  * \brief Check if a sequence matches a given pattern.
@@ -67,7 +69,7 @@ bool claw::glob_match(InputIterator1 pattern_first,
                         any_sequence, zero_or_one, any)
              || glob_match(pattern_first + 1, pattern_last, first + 1, last,
                            any_sequence, zero_or_one, any);
-  else if((*pattern_first == zero_or_one) || (*pattern_first == *first))
+  else if((*pattern_first == any) || (*pattern_first == *first))
     result = glob_match(pattern_first + 1, pattern_last, first + 1, last,
                         any_sequence, zero_or_one, any);
   else
@@ -119,3 +121,356 @@ bool claw::glob_potential_match(
 
   return result;
 }
+
+/**
+ * \brief Constructor.
+ * \param first Iterator on the first pattern of the set.
+ * \param last Iterator just past the last pattern of the set.
+ * \param any_sequence A value representing any sequence of values, empty or
+ *        not.
+ * \param zero_or_one A value representing any value or no value.
+ * \param any A value representing any value.
+ *
+ * The patterns are sequences of values, like std::basic_string, providing
+ * the begin() and end() methods. Their index in the set is their position in
+ * the range [first, last).
+ */
+template <typename T>
+template <typename PatternIterator>
+claw::glob_set<T>::glob_set(PatternIterator first, PatternIterator last,
+                            value_type any_sequence, value_type zero_or_one,
+                            value_type any)
+  : m_any_sequence(any_sequence)
+  , m_zero_or_one(zero_or_one)
+  , m_any(any)
+  , m_patterns_count(0)
+  , m_classes_count(0)
+  , m_initial_state(0)
+{
+  // All the patterns are stored in a single sequence, each one followed by
+  // a position marking its end. For every position, pattern_index tells the
+  // index of the pattern ending here, or size_t(-1) if it is not an end.
+  std::vector<value_type> patterns;
+  std::vector<std::size_t> pattern_index;
+
+  for(; first != last; ++first, ++m_patterns_count)
+    {
+      const std::size_t length(std::distance(first->begin(), first->end()));
+
+      patterns.insert(patterns.end(), first->begin(), first->end());
+      patterns.push_back(m_any_sequence);
+
+      pattern_index.resize(pattern_index.size() + length, std::size_t(-1));
+      pattern_index.push_back(m_patterns_count);
+    }
+
+  build_symbol_classes(patterns, pattern_index);
+  build_automaton(patterns, pattern_index);
+  find_alive_states();
+}
+
+/**
+ * \brief Get the number of patterns in the set.
+ */
+template <typename T>
+std::size_t claw::glob_set<T>::size() const
+{
+  return m_patterns_count;
+}
+
+/**
+ * \brief Check if a sequence matches at least one pattern of the set.
+ * \param first Iterator on the beginning of the sequence.
+ * \param last Iterator just past the end of the sequence.
+ */
+template <typename T>
+template <typename InputIterator>
+bool claw::glob_set<T>::match(InputIterator first, InputIterator last) const
+{
+  return !m_accepted[run(first, last)].empty();
+}
+
+/**
+ * \brief Find all the patterns of the set matched by a sequence.
+ * \param first Iterator on the beginning of the sequence.
+ * \param last Iterator just past the end of the sequence.
+ * \param out (out) Where the indices of the matched patterns are written, in
+ *        increasing order.
+ * \return The position of \a out after the last written index.
+ */
+template <typename T>
+template <typename InputIterator, typename OutputIterator>
+OutputIterator claw::glob_set<T>::match_all(InputIterator first,
+                                            InputIterator last,
+                                            OutputIterator out) const
+{
+  const std::vector<std::size_t>& accepted(m_accepted[run(first, last)]);
+  return std::copy(accepted.begin(), accepted.end(), out);
+}
+
+/**
+ * \brief Check if a sequence is the beginning of a sequence matching at least
+ *        one pattern of the set.
+ * \param first Iterator on the beginning of the sequence.
+ * \param last Iterator just past the end of the sequence.
+ */
+template <typename T>
+template <typename InputIterator>
+bool claw::glob_set<T>::potential_match(InputIterator first,
+                                        InputIterator last) const
+{
+  return m_alive[run(first, last)];
+}
+
+/**
+ * \brief Read a sequence in the automaton.
+ * \param first Iterator on the beginning of the sequence.
+ * \param last Iterator just past the end of the sequence.
+ * \return The state reached at the end of the sequence.
+ */
+template <typename T>
+template <typename InputIterator>
+std::size_t claw::glob_set<T>::run(InputIterator first,
+                                   InputIterator last) const
+{
+  std::size_t state(m_initial_state);
+
+  for(; (first != last) && (state != 0); ++first)
+    state = m_transitions[state * m_classes_count + m_symbols.find(*first)];
+
+  return state;
+}
+
+/**
+ * \brief Group the values into classes of values having the same effect on
+ *        the automaton.
+ * \param patterns The patterns, one after the other.
+ * \param pattern_index The index of the pattern ending at each position.
+ */
+template <typename T>
+void claw::glob_set<T>::build_symbol_classes(
+    const std::vector<value_type>& patterns,
+    const std::vector<std::size_t>& pattern_index)
+{
+  std::vector<value_type> symbols;
+
+  for(std::size_t i = 0; i != patterns.size(); ++i)
+    if((pattern_index[i] == std::size_t(-1)) && !is_special(patterns[i]))
+      symbols.push_back(patterns[i]);
+
+  std::sort(symbols.begin(), symbols.end());
+  symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+
+  m_symbols = symbol_table<value_type>(symbols);
+  m_classes_count = m_symbols.size() + 1;
+}
+
+/**
+ * \brief Build the deterministic automaton recognizing the patterns, with
+ *        the subset construction.
+ * \param patterns The patterns, one after the other.
+ * \param pattern_index The index of the pattern ending at each position.
+ */
+template <typename T>
+void claw::glob_set<T>::build_automaton(
+    const std::vector<value_type>& patterns,
+    const std::vector<std::size_t>& pattern_index)
+{
+  std::map<position_set, std::size_t> states;
+  std::vector<position_set> sets;
+
+  // the dead state
+  add_state(position_set(), states, sets, pattern_index);
+
+  position_set initial;
+
+  for(std::size_t i = 0; i != patterns.size(); ++i)
+    if((i == 0) || (pattern_index[i - 1] != std::size_t(-1)))
+      initial.push_back(i);
+
+  closure(patterns, pattern_index, initial);
+  m_initial_state = add_state(initial, states, sets, pattern_index);
+
+  // sets grows while we are iterating on the new states.
+  for(std::size_t state = 1; state < sets.size(); ++state)
+    for(std::size_t c = 0; c != m_classes_count; ++c)
+      {
+        position_set next;
+
+        for(std::size_t i = 0; i != sets[state].size(); ++i)
+          {
+            const std::size_t p(sets[state][i]);
+
+            if(pattern_index[p] != std::size_t(-1))
+              continue;
+
+            if(patterns[p] == m_any_sequence)
+              next.push_back(p);
+            else if((patterns[p] == m_zero_or_one) || (patterns[p] == m_any)
+                    || (m_symbols.find(patterns[p]) == c))
+              next.push_back(p + 1);
+          }
+
+        closure(patterns, pattern_index, next);
+        const std::size_t target(add_state(next, states, sets, pattern_index));
+        m_transitions[state * m_classes_count + c] = target;
+      }
+}
+
+/**
+ * \brief Add in a set of positions all the positions reachable without
+ *        reading any value.
+ * \param patterns The patterns, one after the other.
+ * \param pattern_index The index of the pattern ending at each position.
+ * \param s (in/out) The set to complete.
+ */
+template <typename T>
+void claw::glob_set<T>::closure(const std::vector<value_type>& patterns,
+                                const std::vector<std::size_t>& pattern_index,
+                                position_set& s) const
+{
+  const std::size_t n(s.size());
+
+  for(std::size_t i = 0; i != n; ++i)
+    for(std::size_t p = s[i];
+        (pattern_index[p] == std::size_t(-1))
+        && ((patterns[p] == m_any_sequence)
+            || (patterns[p] == m_zero_or_one));
+        ++p)
+      s.push_back(p + 1);
+
+  std::sort(s.begin(), s.end());
+  s.erase(std::unique(s.begin(), s.end()), s.end());
+}
+
+/**
+ * \brief Get the state of the automaton corresponding to a set of positions,
+ *        creating it if needed.
+ * \param s The positions.
+ * \param states The states already created, associated with their positions.
+ * \param sets The positions of the states already created.
+ * \param pattern_index The index of the pattern ending at each position.
+ */
+template <typename T>
+std::size_t claw::glob_set<T>::add_state(
+    const position_set& s, std::map<position_set, std::size_t>& states,
+    std::vector<position_set>& sets,
+    const std::vector<std::size_t>& pattern_index)
+{
+  const typename std::map<position_set, std::size_t>::const_iterator it(
+      states.find(s));
+
+  if(it != states.end())
+    return it->second;
+
+  const std::size_t result(sets.size());
+
+  states[s] = result;
+  sets.push_back(s);
+  m_transitions.resize(m_transitions.size() + m_classes_count, 0);
+  m_accepted.push_back(std::vector<std::size_t>());
+
+  for(std::size_t i = 0; i != s.size(); ++i)
+    if(pattern_index[s[i]] != std::size_t(-1))
+      m_accepted.back().push_back(pattern_index[s[i]]);
+
+  return result;
+}
+
+/**
+ * \brief Find the states from which an accepting state can be reached.
+ */
+template <typename T>
+void claw::glob_set<T>::find_alive_states()
+{
+  m_alive.resize(m_accepted.size());
+
+  for(std::size_t s = 0; s != m_accepted.size(); ++s)
+    m_alive[s] = !m_accepted[s].empty();
+
+  bool changed(true);
+
+  while(changed)
+    {
+      changed = false;
+
+      for(std::size_t s = 0; s != m_alive.size(); ++s)
+        for(std::size_t c = 0; !m_alive[s] && (c != m_classes_count); ++c)
+          if(m_alive[m_transitions[s * m_classes_count + c]])
+            {
+              m_alive[s] = true;
+              changed = true;
+            }
+    }
+}
+
+/**
+ * \brief Tell if a value has a special meaning in the patterns.
+ * \param v The value to check.
+ */
+template <typename T>
+bool claw::glob_set<T>::is_special(const value_type& v) const
+{
+  return (v == m_any_sequence) || (v == m_zero_or_one) || (v == m_any);
+}
+
+/**
+ * \brief Constructor.
+ * \param first Iterator on the beginning of the pattern.
+ * \param last Iterator just past the end of the pattern.
+ * \param any_sequence A value representing any sequence of values, empty or
+ *        not.
+ * \param zero_or_one A value representing any value or no value.
+ * \param any A value representing any value.
+ */
+template <typename T>
+template <typename InputIterator>
+claw::compiled_glob<T>::compiled_glob(InputIterator first,
+                                      InputIterator last,
+                                      value_type any_sequence,
+                                      value_type zero_or_one, value_type any)
+  : compiled_glob(std::vector<value_type>(first, last), any_sequence,
+                  zero_or_one, any)
+{}
+
+/**
+ * \brief Constructor.
+ * \param pattern The pattern.
+ * \param any_sequence A value representing any sequence of values, empty or
+ *        not.
+ * \param zero_or_one A value representing any value or no value.
+ * \param any A value representing any value.
+ */
+template <typename T>
+claw::compiled_glob<T>::compiled_glob(const std::vector<value_type>& pattern,
+                                      value_type any_sequence,
+                                      value_type zero_or_one, value_type any)
+  : m_automaton(&pattern, &pattern + 1, any_sequence, zero_or_one, any)
+{}
+
+/**
+ * \brief Check if a sequence matches the pattern.
+ * \param first Iterator on the beginning of the sequence.
+ * \param last Iterator just past the end of the sequence.
+ */
+template <typename T>
+template <typename InputIterator>
+bool claw::compiled_glob<T>::match(InputIterator first,
+                                   InputIterator last) const
+{
+  return m_automaton.match(first, last);
+}
+
+/**
+ * \brief Check if a sequence is the beginning of a sequence matching the
+ *        pattern.
+ * \param first Iterator on the beginning of the sequence.
+ * \param last Iterator just past the end of the sequence.
+ */
+template <typename T>
+template <typename InputIterator>
+bool claw::compiled_glob<T>::potential_match(InputIterator first,
+                                             InputIterator last) const
+{
+  return m_automaton.potential_match(first, last);
+}
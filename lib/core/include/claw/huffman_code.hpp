@@ -0,0 +1,93 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file huffman_code.hpp
+ * \brief The lengths and the bits of the codes of a canonical Huffman code.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_HUFFMAN_CODE_HPP__
+#define __CLAW_HUFFMAN_CODE_HPP__
+
+#include <claw/bit_order.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief The lengths and the bits of the codes of a canonical Huffman code.
+   *
+   * In a canonical code, the codes of a given length are consecutive integers
+   * assigned in the order of the symbols, and the shorter codes come first.
+   * Thus the code is entirely described by the lengths of the codes of the
+   * symbols, which is all a decoder needs to receive. A length of zero means
+   * that the symbol is not used.
+   *
+   * \author Julien Jorge
+   */
+  class huffman_code
+  {
+  public:
+    /** \brief The maximum length of a code. */
+    static const unsigned int max_code_length = 15;
+
+  public:
+    inline huffman_code();
+    inline explicit huffman_code(const std::vector<unsigned char>& lengths);
+
+    inline void build(const std::vector<std::size_t>& frequencies,
+                      unsigned int max_length = max_code_length);
+    inline void assign(const std::vector<unsigned char>& lengths);
+
+    inline unsigned int symbols_count() const;
+    inline unsigned int max_length() const;
+
+    inline const std::vector<unsigned char>& get_lengths() const;
+    inline unsigned int get_length(unsigned int symbol) const;
+    inline unsigned int get_code(unsigned int symbol, bit_order order) const;
+
+  private:
+    inline void limit_lengths(std::vector<std::size_t>& count,
+                              unsigned int max_length) const;
+    inline void assign_codes();
+
+  private:
+    /** \brief The length of the code of each symbol. */
+    std::vector<unsigned char> m_lengths;
+
+    /** \brief The code of each symbol, its first bit being the most
+        significant one. */
+    std::vector<unsigned int> m_codes;
+
+    /** \brief The length of the longest code. */
+    unsigned int m_max_length;
+
+  }; // class huffman_code
+}
+
+#include <claw/huffman_code.ipp>
+
+#endif // __CLAW_HUFFMAN_CODE_HPP__
@@ -0,0 +1,289 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file huffman_code.ipp
+ * \brief Implementation of the claw::huffman_code class.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <queue>
+#include <utility>
+
+/**
+ * \brief Constructor. The code has no symbol.
+ */
+inline claw::huffman_code::huffman_code()
+  : m_max_length(0)
+{}
+
+/**
+ * \brief Constructor.
+ * \param lengths The length of the code of each symbol.
+ */
+inline claw::huffman_code::huffman_code(
+    const std::vector<unsigned char>& lengths)
+  : m_max_length(0)
+{
+  assign(lengths);
+}
+
+/**
+ * \brief Build the optimal code for some frequencies of the symbols, with a
+ *        limit on the length of the codes.
+ * \param frequencies The number of occurrences of each symbol.
+ * \param max_length The maximum length of the codes.
+ * \pre 1 <= max_length <= max_code_length
+ *
+ * A symbol whose frequency is zero receives no code.
+ */
+inline void
+claw::huffman_code::build(const std::vector<std::size_t>& frequencies,
+                          unsigned int max_length)
+{
+  assert(max_length >= 1);
+  assert(max_length <= max_code_length);
+
+  m_lengths.assign(frequencies.size(), 0);
+
+  std::vector<unsigned int> used;
+
+  for(std::size_t i = 0; i != frequencies.size(); ++i)
+    if(frequencies[i] != 0)
+      used.push_back(i);
+
+  if(used.size() > (std::size_t(1) << max_length))
+    throw claw::exception("huffman_code: too many symbols for the maximum "
+                          "length of the codes.");
+
+  if(used.size() == 1)
+    m_lengths[used[0]] = 1;
+  else if(!used.empty())
+    {
+      // The leaves are the nodes [0, used.size()), the parents come after
+      // their children.
+      typedef std::pair<std::size_t, unsigned int> weighted_node;
+      std::priority_queue<weighted_node, std::vector<weighted_node>,
+                          std::greater<weighted_node> >
+          queue;
+      std::vector<unsigned int> parent(2 * used.size() - 1, 0);
+
+      for(std::size_t i = 0; i != used.size(); ++i)
+        queue.push(weighted_node(frequencies[used[i]], i));
+
+      for(unsigned int n = used.size(); queue.size() > 1; ++n)
+        {
+          const weighted_node a = queue.top();
+          queue.pop();
+          const weighted_node b = queue.top();
+          queue.pop();
+
+          parent[a.second] = n;
+          parent[b.second] = n;
+          queue.push(weighted_node(a.first + b.first, n));
+        }
+
+      std::vector<unsigned int> depth(parent.size(), 0);
+      std::vector<std::size_t> count(used.size(), 0);
+
+      for(std::size_t i = parent.size() - 1; i != 0; --i)
+        depth[i - 1] = depth[parent[i - 1]] + 1;
+
+      for(std::size_t i = 0; i != used.size(); ++i)
+        ++count[depth[i]];
+
+      limit_lengths(count, max_length);
+
+      // The most frequent symbols receive the shortest codes.
+      std::stable_sort(used.begin(), used.end(),
+                       [&frequencies](unsigned int a, unsigned int b) -> bool
+                       {
+                         return frequencies[a] > frequencies[b];
+                       });
+
+      std::size_t s = 0;
+
+      for(std::size_t length = 1; length != count.size(); ++length)
+        for(std::size_t i = 0; i != count[length]; ++i, ++s)
+          m_lengths[used[s]] = length;
+    }
+
+  assign_codes();
+}
+
+/**
+ * \brief Use the codes described by their lengths.
+ * \param lengths The length of the code of each symbol.
+ *
+ * The lengths are typically received from an encoder, thus they are checked
+ * and a claw::bad_format is thrown if they do not describe a prefix code.
+ */
+inline void
+claw::huffman_code::assign(const std::vector<unsigned char>& lengths)
+{
+  std::size_t kraft_sum = 0;
+
+  for(std::size_t i = 0; i != lengths.size(); ++i)
+    if(lengths[i] > max_code_length)
+      throw claw::bad_format("huffman_code: code length is too large.");
+    else if(lengths[i] != 0)
+      kraft_sum += std::size_t(1) << (max_code_length - lengths[i]);
+
+  if(kraft_sum > (std::size_t(1) << max_code_length))
+    throw claw::bad_format("huffman_code: over-subscribed code lengths.");
+
+  m_lengths = lengths;
+  assign_codes();
+}
+
+/**
+ * \brief Get the number of symbols of the alphabet, including the ones
+ *        having no code.
+ */
+inline unsigned int claw::huffman_code::symbols_count() const
+{
+  return m_lengths.size();
+}
+
+/**
+ * \brief Get the length of the longest code.
+ */
+inline unsigned int claw::huffman_code::max_length() const
+{
+  return m_max_length;
+}
+
+/**
+ * \brief Get the length of the code of each symbol.
+ */
+inline const std::vector<unsigned char>&
+claw::huffman_code::get_lengths() const
+{
+  return m_lengths;
+}
+
+/**
+ * \brief Get the length of the code of a symbol.
+ * \param symbol The symbol.
+ */
+inline unsigned int claw::huffman_code::get_length(unsigned int symbol) const
+{
+  assert(symbol < m_lengths.size());
+  return m_lengths[symbol];
+}
+
+/**
+ * \brief Get the bits of the code of a symbol, as they must be passed to
+ *        bit_ostream::write_bits() to be written in the given order.
+ * \param symbol The symbol.
+ * \param order The order of the bits in the stream.
+ *
+ * The codes are read bit per bit from their most significant bit, thus they
+ * are reversed for the streams beginning with the least significant bits.
+ */
+inline unsigned int claw::huffman_code::get_code(unsigned int symbol,
+                                                 bit_order order) const
+{
+  assert(symbol < m_codes.size());
+
+  if(order == msb_first)
+    return m_codes[symbol];
+
+  unsigned int code = m_codes[symbol];
+  unsigned int result = 0;
+
+  for(unsigned int i = 0; i != m_lengths[symbol]; ++i, code >>= 1)
+    result = (result << 1) | (code & 1);
+
+  return result;
+}
+
+/**
+ * \brief Change the lengths of the codes such that none is longer than a
+ *        given length, as described in the annex K.3 of the JPEG
+ *        specification.
+ * \param count (in/out) The number of codes of each length.
+ * \param max_length The maximum length of the codes.
+ *
+ * A code longer than the limit is moved up with its sibling, which takes the
+ * place of a shorter code whose owner goes one level down with the sibling
+ * as neighbour.
+ */
+inline void claw::huffman_code::limit_lengths(std::vector<std::size_t>& count,
+                                              unsigned int max_length) const
+{
+  for(std::size_t i = count.size() - 1; i > max_length;)
+    if(count[i] == 0)
+      --i;
+    else
+      {
+        std::size_t j = i - 2;
+
+        while(count[j] == 0)
+          --j;
+
+        assert(j != 0);
+
+        count[i] -= 2;
+        count[i - 1] += 1;
+        count[j + 1] += 2;
+        count[j] -= 1;
+      }
+
+  count.resize(max_length + 1, 0);
+}
+
+/**
+ * \brief Compute the canonical codes from the lengths of the codes.
+ */
+inline void claw::huffman_code::assign_codes()
+{
+  m_max_length = 0;
+
+  for(std::size_t i = 0; i != m_lengths.size(); ++i)
+    m_max_length = std::max<unsigned int>(m_max_length, m_lengths[i]);
+
+  std::vector<unsigned int> count(m_max_length + 1, 0);
+  std::vector<unsigned int> next_code(m_max_length + 1, 0);
+
+  for(std::size_t i = 0; i != m_lengths.size(); ++i)
+    ++count[m_lengths[i]];
+
+  count[0] = 0;
+
+  for(unsigned int length = 1; length <= m_max_length; ++length)
+    next_code[length] = (next_code[length - 1] + count[length - 1]) << 1;
+
+  m_codes.resize(m_lengths.size());
+
+  for(std::size_t i = 0; i != m_lengths.size(); ++i)
+    if(m_lengths[i] == 0)
+      m_codes[i] = 0;
+    else
+      m_codes[i] = next_code[m_lengths[i]]++;
+}
@@ -0,0 +1,113 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file huffman_decoder.hpp
+ * \brief A class to read from a bit stream the symbols written with a
+ *        canonical Huffman code.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_HUFFMAN_DECODER_HPP__
+#define __CLAW_HUFFMAN_DECODER_HPP__
+
+#include <claw/bit_istream.hpp>
+#include <claw/huffman_code.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A class to read from a bit stream the symbols written with a
+   *        canonical Huffman code.
+   *
+   * The symbols are decoded with lookup tables rather than bit per bit: the
+   * next bits of the stream are peeked at once and give the index of an
+   * entry containing the symbol and the length of its code. The first
+   * lookup_bits bits index a primary table, the codes longer than that
+   * continue in a secondary table reached from the entry of their prefix.
+   *
+   * \b Template \b parameters:
+   * - \a Order The order of the bits in the stream.
+   *
+   * \author Julien Jorge
+   */
+  template <bit_order Order = lsb_first>
+  class huffman_decoder
+  {
+  public:
+    /** \brief The maximum number of bits indexing the primary table. */
+    static const unsigned int lookup_bits = 10;
+
+  private:
+    /** \brief An entry of the lookup tables. */
+    struct entry
+    {
+      /** \brief The decoded symbol, or the index of the secondary table if
+          link is true. */
+      unsigned int value;
+
+      /** \brief The length of the code of the symbol, zero if the bits do
+          not match any code. */
+      unsigned char length;
+
+      /** \brief Tell if the code continues in a secondary table. */
+      bool link;
+    };
+
+  public:
+    explicit huffman_decoder(const huffman_code& code);
+
+    template <typename Stream>
+    unsigned int read(bit_istream<Stream, Order>& is) const;
+
+    template <typename Stream, typename OutputIterator>
+    OutputIterator decode(bit_istream<Stream, Order>& is, std::size_t n,
+                          OutputIterator out) const;
+
+  private:
+    void add_code(const huffman_code& code, unsigned int symbol);
+    void fill(std::size_t first, unsigned int bits, unsigned int length,
+              unsigned int table_bits, const entry& e);
+
+  private:
+    /** \brief The length of the longest code. */
+    unsigned int m_max_length;
+
+    /** \brief The number of bits indexing the primary table. */
+    unsigned int m_primary_bits;
+
+    /** \brief The number of bits indexing the secondary tables. */
+    unsigned int m_secondary_bits;
+
+    /** \brief The primary table, followed by the secondary tables. */
+    std::vector<entry> m_table;
+
+  }; // class huffman_decoder
+}
+
+#include <claw/huffman_decoder.tpp>
+
+#endif // __CLAW_HUFFMAN_DECODER_HPP__
@@ -0,0 +1,195 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file huffman_decoder.tpp
+ * \brief Implementation of the claw::huffman_decoder class.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+
+#include <algorithm>
+
+template <claw::bit_order Order>
+const unsigned int claw::huffman_decoder<Order>::lookup_bits;
+
+/**
+ * \brief Constructor.
+ * \param code The code of the symbols.
+ */
+template <claw::bit_order Order>
+claw::huffman_decoder<Order>::huffman_decoder(const huffman_code& code)
+  : m_max_length(code.max_length())
+  , m_primary_bits(std::min(m_max_length, (unsigned int)lookup_bits))
+  , m_secondary_bits(m_max_length - m_primary_bits)
+{
+  entry invalid;
+  invalid.value = 0;
+  invalid.length = 0;
+  invalid.link = false;
+
+  m_table.assign(std::size_t(1) << m_primary_bits, invalid);
+
+  for(unsigned int i = 0; i != code.symbols_count(); ++i)
+    if(code.get_length(i) != 0)
+      add_code(code, i);
+}
+
+/**
+ * \brief Read a symbol.
+ * \param is The stream from which the code of the symbol is read.
+ *
+ * A claw::bad_format is thrown if the next bits do not match any code.
+ */
+template <claw::bit_order Order>
+template <typename Stream>
+unsigned int
+claw::huffman_decoder<Order>::read(bit_istream<Stream, Order>& is) const
+{
+  const unsigned int bits = is.peek(m_max_length);
+  unsigned int primary;
+  unsigned int secondary;
+
+  if(Order == lsb_first)
+    {
+      primary = bits & ((1u << m_primary_bits) - 1);
+      secondary = bits >> m_primary_bits;
+    }
+  else
+    {
+      primary = bits >> m_secondary_bits;
+      secondary = bits & ((1u << m_secondary_bits) - 1);
+    }
+
+  const entry* e = &m_table[primary];
+
+  if(e->link)
+    e = &m_table[e->value + secondary];
+
+  if(e->length == 0)
+    throw claw::bad_format("huffman_decoder: invalid code.");
+
+  is.consume(e->length);
+  return e->value;
+}
+
+/**
+ * \brief Read several symbols.
+ * \param is The stream from which the codes of the symbols are read.
+ * \param n The number of symbols to read.
+ * \param out Where the symbols are written.
+ * \return The position of \a out after the last symbol.
+ */
+template <claw::bit_order Order>
+template <typename Stream, typename OutputIterator>
+OutputIterator
+claw::huffman_decoder<Order>::decode(bit_istream<Stream, Order>& is,
+                                     std::size_t n, OutputIterator out) const
+{
+  for(; n != 0; --n, ++out)
+    *out = read(is);
+
+  return out;
+}
+
+/**
+ * \brief Add the entries of the code of a symbol in the tables.
+ * \param code The code of the symbols.
+ * \param symbol The symbol whose code is added.
+ */
+template <claw::bit_order Order>
+void claw::huffman_decoder<Order>::add_code(const huffman_code& code,
+                                            unsigned int symbol)
+{
+  const unsigned int length = code.get_length(symbol);
+  const unsigned int bits = code.get_code(symbol, Order);
+
+  entry e;
+  e.value = symbol;
+  e.length = length;
+  e.link = false;
+
+  if(length <= m_primary_bits)
+    {
+      fill(0, bits, length, m_primary_bits, e);
+      return;
+    }
+
+  const unsigned int extra = length - m_primary_bits;
+  unsigned int prefix;
+  unsigned int rest;
+
+  if(Order == lsb_first)
+    {
+      prefix = bits & ((1u << m_primary_bits) - 1);
+      rest = bits >> m_primary_bits;
+    }
+  else
+    {
+      prefix = bits >> extra;
+      rest = bits & ((1u << extra) - 1);
+    }
+
+  if(!m_table[prefix].link)
+    {
+      m_table[prefix].value = m_table.size();
+      m_table[prefix].link = true;
+
+      entry invalid;
+      invalid.value = 0;
+      invalid.length = 0;
+      invalid.link = false;
+
+      m_table.resize(m_table.size() + (std::size_t(1) << m_secondary_bits),
+                     invalid);
+    }
+
+  fill(m_table[prefix].value, rest, extra, m_secondary_bits, e);
+}
+
+/**
+ * \brief Set an entry in all the places of a table indexed by some bits
+ *        followed by any value.
+ * \param first The index of the first entry of the table.
+ * \param bits The bits beginning the indices, in the order of the stream.
+ * \param length The number of bits in \a bits.
+ * \param table_bits The number of bits indexing the table.
+ * \param e The entry to set.
+ */
+template <claw::bit_order Order>
+void claw::huffman_decoder<Order>::fill(std::size_t first, unsigned int bits,
+                                        unsigned int length,
+                                        unsigned int table_bits,
+                                        const entry& e)
+{
+  const unsigned int count = 1u << (table_bits - length);
+
+  if(Order == lsb_first)
+    for(unsigned int i = 0; i != count; ++i)
+      m_table[first + (bits | (i << length))] = e;
+  else
+    std::fill(m_table.begin() + first + (bits << (table_bits - length)),
+              m_table.begin() + first + ((bits + 1) << (table_bits - length)),
+              e);
+}
@@ -0,0 +1,89 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file huffman_encoder.hpp
+ * \brief A class to write symbols with a canonical Huffman code in a bit
+ *        stream.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_HUFFMAN_ENCODER_HPP__
+#define __CLAW_HUFFMAN_ENCODER_HPP__
+
+#include <claw/bit_ostream.hpp>
+#include <claw/huffman_code.hpp>
+
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A class to write symbols with a canonical Huffman code in a bit
+   *        stream.
+   *
+   * The bits of the codes are prepared for the order of the stream at
+   * construction, so writing a symbol is a single call to
+   * bit_ostream::write_bits(). The symbols can be the bytes of a file as
+   * well as the codes produced by an lzw_encoder or the packets of an
+   * rle_encoder, as long as the code has been built for their alphabet.
+   *
+   * \b Template \b parameters:
+   * - \a Order The order of the bits in the stream.
+   *
+   * \author Julien Jorge
+   */
+  template <bit_order Order = lsb_first>
+  class huffman_encoder
+  {
+  private:
+    /** \brief The code of a symbol. */
+    struct entry
+    {
+      /** \brief The bits of the code, in the order of the stream. */
+      unsigned int bits;
+
+      /** \brief The number of bits in the code. */
+      unsigned int length;
+    };
+
+  public:
+    explicit huffman_encoder(const huffman_code& code);
+
+    template <typename Stream>
+    void write(bit_ostream<Stream, Order>& os, unsigned int symbol) const;
+
+    template <typename InputIterator, typename Stream>
+    void encode(InputIterator first, InputIterator last,
+                bit_ostream<Stream, Order>& os) const;
+
+  private:
+    /** \brief The code of each symbol. */
+    std::vector<entry> m_codes;
+
+  }; // class huffman_encoder
+}
+
+#include <claw/huffman_encoder.tpp>
+
+#endif // __CLAW_HUFFMAN_ENCODER_HPP__
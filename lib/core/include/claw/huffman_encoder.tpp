@@ -0,0 +1,84 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file huffman_encoder.tpp
+ * \brief Implementation of the claw::huffman_encoder class.
+ * \author Julien Jorge
+ */
+#include <cassert>
+
+/**
+ * \brief Constructor.
+ * \param code The code of the symbols.
+ */
+template <claw::bit_order Order>
+claw::huffman_encoder<Order>::huffman_encoder(const huffman_code& code)
+  : m_codes(code.symbols_count())
+{
+  for(unsigned int i = 0; i != m_codes.size(); ++i)
+    {
+      m_codes[i].bits = code.get_code(i, Order);
+      m_codes[i].length = code.get_length(i);
+    }
+}
+
+/**
+ * \brief Write the code of a symbol.
+ * \param os The stream in which the code is written.
+ * \param symbol The symbol to write.
+ * \pre The symbol has a code.
+ */
+template <claw::bit_order Order>
+template <typename Stream>
+void claw::huffman_encoder<Order>::write(bit_ostream<Stream, Order>& os,
+                                         unsigned int symbol) const
+{
+  assert(symbol < m_codes.size());
+  assert(m_codes[symbol].length != 0);
+
+  os.write_bits(m_codes[symbol].bits, m_codes[symbol].length);
+}
+
+/**
+ * \brief Write the codes of a sequence of symbols.
+ * \param first Iterator on the first symbol to write.
+ * \param last Iterator just past the last symbol to write.
+ * \param os The stream in which the codes are written.
+ *
+ * The values of type \a char are taken as unsigned bytes.
+ */
+template <claw::bit_order Order>
+template <typename InputIterator, typename Stream>
+void claw::huffman_encoder<Order>::encode(
+    InputIterator first, InputIterator last,
+    bit_ostream<Stream, Order>& os) const
+{
+  for(; first != last; ++first)
+    {
+      const unsigned int symbol =
+          (sizeof(*first) == 1) ? (unsigned char)*first : *first;
+      write(os, symbol);
+    }
+}
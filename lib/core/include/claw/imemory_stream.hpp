@@ -0,0 +1,83 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file imemory_stream.hpp
+ * \brief An input stream reading a memory area without copying it.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_IMEMORY_STREAM_HPP__
+#define __CLAW_IMEMORY_STREAM_HPP__
+
+#include <cstddef>
+#include <istream>
+#include <streambuf>
+
+namespace claw
+{
+  /**
+   * \brief A stream buffer whose get area is a memory area given by the
+   *        user.
+   *
+   * The memory is neither copied nor modified, and must stay valid as long
+   * as the buffer is used.
+   *
+   * \author Julien Jorge
+   */
+  class memory_streambuf : public std::streambuf
+  {
+  public:
+    inline memory_streambuf(const char* data, std::size_t size);
+
+  protected:
+    inline virtual std::streamsize showmanyc();
+    inline virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                                    std::ios_base::openmode which
+                                    = std::ios_base::in);
+    inline virtual pos_type seekpos(pos_type pos,
+                                    std::ios_base::openmode which
+                                    = std::ios_base::in);
+
+  }; // class memory_streambuf
+
+  /**
+   * \brief An input stream reading a memory area without copying it, for
+   *        example the content of a claw::memory_mapped_file.
+   * \author Julien Jorge
+   */
+  class imemory_stream : public std::istream
+  {
+  public:
+    inline imemory_stream(const char* data, std::size_t size);
+
+  private:
+    /** \brief The buffer of the stream. */
+    memory_streambuf m_buffer;
+
+  }; // class imemory_stream
+}
+
+#include <claw/imemory_stream.ipp>
+
+#endif // __CLAW_IMEMORY_STREAM_HPP__
@@ -0,0 +1,109 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file imemory_stream.ipp
+ * \brief Implementation of the claw::imemory_stream and
+ *        claw::memory_streambuf classes.
+ * \author Julien Jorge
+ */
+
+/**
+ * \brief Constructor.
+ * \param data The memory to read.
+ * \param size The size of the memory to read.
+ */
+inline claw::memory_streambuf::memory_streambuf(const char* data,
+                                                std::size_t size)
+{
+  // The get area is never written, but setg() wants non const pointers.
+  char* const begin = const_cast<char*>(data);
+  setg(begin, begin, begin + size);
+}
+
+/**
+ * \brief Get the number of characters available for reading.
+ */
+inline std::streamsize claw::memory_streambuf::showmanyc()
+{
+  if(gptr() == egptr())
+    return -1;
+  else
+    return egptr() - gptr();
+}
+
+/**
+ * \brief Move the read position.
+ * \param off The offset of the new position.
+ * \param dir The position from which the offset is added.
+ * \param which The positions to move. Only std::ios_base::in is supported.
+ */
+inline claw::memory_streambuf::pos_type
+claw::memory_streambuf::seekoff(off_type off, std::ios_base::seekdir dir,
+                                std::ios_base::openmode which)
+{
+  if(!(which & std::ios_base::in))
+    return pos_type(off_type(-1));
+
+  off_type base;
+
+  if(dir == std::ios_base::beg)
+    base = 0;
+  else if(dir == std::ios_base::cur)
+    base = gptr() - eback();
+  else
+    base = egptr() - eback();
+
+  const off_type result = base + off;
+
+  if((result < 0) || (result > egptr() - eback()))
+    return pos_type(off_type(-1));
+
+  setg(eback(), eback() + result, egptr());
+  return pos_type(result);
+}
+
+/**
+ * \brief Move the read position.
+ * \param pos The new position.
+ * \param which The positions to move. Only std::ios_base::in is supported.
+ */
+inline claw::memory_streambuf::pos_type
+claw::memory_streambuf::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+/**
+ * \brief Constructor.
+ * \param data The memory to read.
+ * \param size The size of the memory to read.
+ */
+inline claw::imemory_stream::imemory_stream(const char* data,
+                                            std::size_t size)
+  : std::istream(NULL)
+  , m_buffer(data, size)
+{
+  init(&m_buffer);
+}
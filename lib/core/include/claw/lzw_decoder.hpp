@@ -31,8 +31,7 @@
 #ifndef __CLAW_LZW_DECODER_HPP__
 #define __CLAW_LZW_DECODER_HPP__
 
-#include <utility>
-#include <vector>
+#include <claw/lzw_string_table.hpp>
 
 namespace claw
 {
@@ -56,6 +55,10 @@ namespace claw
    * The \a OutputBuffer type must have the following methods:
    * - write( unsigned int ), write a symbol in the output.
    *
+   * The strings are stored in a claw::lzw_string_table kept between the calls
+   * to decode(), so a decoder reused for several blocks does not allocate
+   * once it has seen its longest string.
+   *
    * \author Julien Jorge
    */
   template <typename InputBuffer, typename OutputBuffer>
@@ -68,21 +71,12 @@ namespace claw
     /** \brief The type of the output buffer. */
     typedef OutputBuffer output_buffer_type;
 
-  private:
-    typedef std::pair<unsigned int, unsigned int> word_type;
-    typedef std::vector<word_type> table_type;
-
   public:
     void decode(input_buffer_type& input, output_buffer_type& output);
 
   private:
-    unsigned int get_first_symbol(const table_type& table,
-                                  const unsigned int code,
-                                  const unsigned int symbols_count) const;
-
-    void decompose(const table_type& table, unsigned int code,
-                   const unsigned int symbols_count,
-                   output_buffer_type& output) const;
+    /** \brief The strings associated with the codes. */
+    lzw_string_table m_table;
 
   }; // class lzw_decoder
 }
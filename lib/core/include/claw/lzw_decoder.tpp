@@ -27,8 +27,6 @@
  * \brief Implementation of the claw::lzw_decoder class.
  * \author Julien Jorge
  */
-#include <list>
-
 /**
  * \brief Decode a sequence of LZW compressed datas.
  * \param input Where we read the compressed datas.
@@ -38,10 +36,7 @@ template <typename InputBuffer, typename OutputBuffer>
 void claw::lzw_decoder<InputBuffer, OutputBuffer>::decode(
     input_buffer_type& input, output_buffer_type& output)
 {
-  const unsigned int symbols_count = input.symbols_count();
-
-  table_type table;
-  unsigned int table_size = 0;
+  m_table.clear(input.symbols_count());
 
   unsigned int prefix = input.get_next();
 
@@ -55,67 +50,19 @@ void claw::lzw_decoder<InputBuffer, OutputBuffer>::decode(
             {
               unsigned int new_suffix;
 
-              if(suffix < table_size + symbols_count)
-                new_suffix = get_first_symbol(table, suffix, symbols_count);
+              if(suffix < m_table.size())
+                new_suffix = m_table.get_first_symbol(suffix);
               else
-                new_suffix = get_first_symbol(table, prefix, symbols_count);
+                new_suffix = m_table.get_first_symbol(prefix);
 
-              table.push_back(word_type(prefix, new_suffix));
-              ++table_size;
-              input.new_code(table_size + symbols_count);
+              m_table.add(prefix, new_suffix);
+              input.new_code(m_table.size());
 
-              decompose(table, prefix, symbols_count, output);
+              m_table.write(prefix, output);
               prefix = suffix;
             }
         }
 
-      decompose(table, prefix, symbols_count, output);
-    }
-}
-
-/**
- * \brief Get the first symbol of a string, represented by a code.
- * \param table The table of codes.
- * \param code The code of the string from which we want the first symbol.
- * \param symbols_count The count of atomic codes.
- */
-template <typename InputBuffer, typename OutputBuffer>
-unsigned int claw::lzw_decoder<InputBuffer, OutputBuffer>::get_first_symbol(
-    const table_type& table, const unsigned int code,
-    const unsigned int symbols_count) const
-{
-  unsigned int result = code;
-
-  while(result >= symbols_count)
-    result = table[result - symbols_count].first;
-
-  return result;
-}
-
-/**
- * \brief Write a string, represented by a code, in the ouput buffer.
- * \param table The table of codes.
- * \param code The code of the string to write.
- * \param symbols_count The count of atomic codes.
- * \param output Where we write the uncompressed datas.
- */
-template <typename InputBuffer, typename OutputBuffer>
-void claw::lzw_decoder<InputBuffer, OutputBuffer>::decompose(
-    const table_type& table, unsigned int code,
-    const unsigned int symbols_count, output_buffer_type& output) const
-{
-  std::list<unsigned int> result;
-
-  while(code >= symbols_count)
-    {
-      result.push_front(table[code - symbols_count].second);
-      code = table[code - symbols_count].first;
+      m_table.write(prefix, output);
     }
-
-  result.push_front(code);
-
-  std::list<unsigned int>::const_iterator it;
-
-  for(it = result.begin(); it != result.end(); ++it)
-    output.write(*it);
 }
@@ -0,0 +1,105 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_dictionary.hpp
+ * \brief The dictionary of an LZW encoder.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_LZW_DICTIONARY_HPP__
+#define __CLAW_LZW_DICTIONARY_HPP__
+
+#include <cstddef>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief The dictionary of an LZW encoder, associating the code of a string
+   *        with the code of its prefix and its last symbol.
+   *
+   * When the alphabet and the code range are small enough, the table is a
+   * direct array of prefix x symbol entries; otherwise it is an open
+   * addressing hash table.
+   *
+   * \author Julien Jorge
+   */
+  class lzw_dictionary
+  {
+  public:
+    inline lzw_dictionary();
+    inline lzw_dictionary(unsigned int symbols_count, unsigned int max_code);
+
+    inline void clear();
+    inline void clear(unsigned int symbols_count, unsigned int max_code);
+
+    inline unsigned int find_or_insert(unsigned int prefix,
+                                       unsigned int symbol,
+                                       unsigned int code);
+
+  private:
+    inline unsigned int find_or_insert_direct(unsigned int prefix,
+                                              unsigned int symbol,
+                                              unsigned int code);
+    inline unsigned int find_or_insert_hashed(unsigned int prefix,
+                                              unsigned int symbol,
+                                              unsigned int code);
+
+    inline std::size_t slot_of(unsigned long long key) const;
+    inline void grow();
+
+  public:
+    /** \brief The value returned by find_or_insert() when the word was not
+        in the dictionary. */
+    static const unsigned int not_found = (unsigned int)(-1);
+
+  private:
+    /** \brief The largest direct table we accept, in entries. */
+    static const std::size_t max_direct_size = 1 << 16;
+
+    /** \brief The number of symbols in the uncompressed data. */
+    unsigned int m_symbols_count;
+
+    /** \brief Tell if the table is a direct prefix x symbol array. */
+    bool m_direct;
+
+    /** \brief The codes of the words in the dictionary, or not_found. */
+    std::vector<unsigned int> m_codes;
+
+    /** \brief The (prefix, symbol) keys of the entries of the hash table. */
+    std::vector<unsigned long long> m_keys;
+
+    /** \brief The number of entries in the hash table. */
+    std::size_t m_size;
+
+    /** \brief The number of bits of the index of a slot in the hash
+        table. */
+    unsigned int m_bits;
+
+  }; // class lzw_dictionary
+}
+
+#include <claw/lzw_dictionary.ipp>
+
+#endif // __CLAW_LZW_DICTIONARY_HPP__
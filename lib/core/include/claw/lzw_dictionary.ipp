@@ -0,0 +1,208 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_dictionary.ipp
+ * \brief Implementation of the claw::lzw_dictionary class.
+ * \author Julien Jorge
+ */
+#include <algorithm>
+
+/**
+ * \brief Default constructor. The dictionary must be cleared with
+ *        clear( unsigned int, unsigned int ) before any insertion.
+ */
+inline claw::lzw_dictionary::lzw_dictionary()
+  : m_symbols_count(0)
+  , m_direct(true)
+  , m_size(0)
+  , m_bits(4)
+{}
+
+/**
+ * \brief Constructor.
+ * \param symbols_count The number of symbols in the uncompressed data.
+ * \param max_code The code after the last one that will be inserted.
+ */
+inline claw::lzw_dictionary::lzw_dictionary(unsigned int symbols_count,
+                                            unsigned int max_code)
+  : m_symbols_count(0)
+  , m_direct(true)
+  , m_size(0)
+  , m_bits(4)
+{
+  clear(symbols_count, max_code);
+}
+
+/**
+ * \brief Remove all the words from the dictionary. The memory is kept for the
+ *        next words.
+ */
+inline void claw::lzw_dictionary::clear()
+{
+  std::fill(m_codes.begin(), m_codes.end(), (unsigned int)not_found);
+  m_size = 0;
+}
+
+/**
+ * \brief Remove all the words from the dictionary and prepare it for a new
+ *        alphabet and code range. The memory of the previous words is reused.
+ * \param symbols_count The number of symbols in the uncompressed data.
+ * \param max_code The code after the last one that will be inserted.
+ */
+inline void claw::lzw_dictionary::clear(unsigned int symbols_count,
+                                        unsigned int max_code)
+{
+  m_symbols_count = symbols_count;
+  m_direct = (max_code != 0)
+             && ((std::size_t)symbols_count
+                 <= max_direct_size / (std::size_t)max_code);
+  m_size = 0;
+
+  if(m_direct)
+    m_codes.assign((std::size_t)symbols_count * max_code,
+                   (unsigned int)not_found);
+  else
+    {
+      const std::size_t expected =
+          (max_code > symbols_count) ? max_code - symbols_count : 0;
+      const std::size_t wanted =
+          2 * std::min(expected, (std::size_t)max_direct_size);
+
+      m_bits = 4;
+
+      while(((std::size_t)1 << m_bits) < wanted)
+        ++m_bits;
+
+      m_codes.assign((std::size_t)1 << m_bits, (unsigned int)not_found);
+      m_keys.resize(m_codes.size());
+    }
+}
+
+/**
+ * \brief Get the code of the word made of a prefix followed by a symbol, or
+ *        insert it in the dictionary if it is not known.
+ * \param prefix The code of the prefix of the word.
+ * \param symbol The last symbol of the word.
+ * \param code The code to give to the word if it is not in the dictionary.
+ * \return The code of the word if it was already in the dictionary,
+ *         not_found otherwise.
+ */
+inline unsigned int claw::lzw_dictionary::find_or_insert(unsigned int prefix,
+                                                         unsigned int symbol,
+                                                         unsigned int code)
+{
+  if(m_direct)
+    return find_or_insert_direct(prefix, symbol, code);
+  else
+    return find_or_insert_hashed(prefix, symbol, code);
+}
+
+/**
+ * \brief Implementation of find_or_insert() for the direct table.
+ * \param prefix The code of the prefix of the word.
+ * \param symbol The last symbol of the word.
+ * \param code The code to give to the word if it is not in the dictionary.
+ */
+inline unsigned int claw::lzw_dictionary::find_or_insert_direct(
+    unsigned int prefix, unsigned int symbol, unsigned int code)
+{
+  unsigned int& entry =
+      m_codes[(std::size_t)prefix * m_symbols_count + symbol];
+  const unsigned int result = entry;
+
+  if(result == not_found)
+    entry = code;
+
+  return result;
+}
+
+/**
+ * \brief Implementation of find_or_insert() for the hash table.
+ * \param prefix The code of the prefix of the word.
+ * \param symbol The last symbol of the word.
+ * \param code The code to give to the word if it is not in the dictionary.
+ */
+inline unsigned int claw::lzw_dictionary::find_or_insert_hashed(
+    unsigned int prefix, unsigned int symbol, unsigned int code)
+{
+  const unsigned long long key =
+      (unsigned long long)prefix * m_symbols_count + symbol;
+  const std::size_t mask = m_codes.size() - 1;
+  std::size_t slot = slot_of(key);
+
+  while(m_codes[slot] != not_found)
+    if(m_keys[slot] == key)
+      return m_codes[slot];
+    else
+      slot = (slot + 1) & mask;
+
+  m_codes[slot] = code;
+  m_keys[slot] = key;
+  ++m_size;
+
+  if(2 * m_size > m_codes.size())
+    grow();
+
+  return not_found;
+}
+
+/**
+ * \brief Get the first slot to probe for a given key in the hash table.
+ * \param key The key to search.
+ */
+inline std::size_t
+claw::lzw_dictionary::slot_of(unsigned long long key) const
+{
+  // Fibonacci hashing: the high bits of the product are well mixed.
+  return (std::size_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - m_bits));
+}
+
+/**
+ * \brief Double the capacity of the hash table.
+ */
+inline void claw::lzw_dictionary::grow()
+{
+  std::vector<unsigned int> codes(m_codes.size() * 2,
+                                  (unsigned int)not_found);
+  std::vector<unsigned long long> keys(codes.size());
+
+  codes.swap(m_codes);
+  keys.swap(m_keys);
+  ++m_bits;
+
+  const std::size_t mask = m_codes.size() - 1;
+
+  for(std::size_t i = 0; i != codes.size(); ++i)
+    if(codes[i] != not_found)
+      {
+        std::size_t slot = slot_of(keys[i]);
+
+        while(m_codes[slot] != not_found)
+          slot = (slot + 1) & mask;
+
+        m_codes[slot] = codes[i];
+        m_keys[slot] = keys[i];
+      }
+}
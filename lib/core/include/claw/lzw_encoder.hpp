@@ -31,6 +31,8 @@
 #ifndef __CLAW_LZW_ENCODER_HPP__
 #define __CLAW_LZW_ENCODER_HPP__
 
+#include <claw/lzw_dictionary.hpp>
+
 namespace claw
 {
   /**
@@ -52,7 +54,16 @@ namespace claw
    * The \a OutputBuffer type must have the following methods:
    * - unsigned int max_code(), get the highest code that the output buffer can
    *   handle,
-   * - write( unsigned int ), write a code in the output.
+   * - write( unsigned int ), write a code in the output,
+   * - new_code( unsigned int ), called each time a new code is added in the
+   *   dictionary.
+   *
+   * The dictionary is a flat table indexed by (prefix, symbol). When the
+   * alphabet and the code range are small enough, the table is a direct
+   * array of prefix x symbol entries; otherwise it is an open addressing hash
+   * table. In both cases a call to encode() does a single lookup per input
+   * symbol and no allocation once the table has been created. The table is
+   * kept in the encoder and cleared at the beginning of each call.
    *
    * \author Julien Jorge
    */
@@ -66,8 +77,17 @@ namespace claw
     /** \brief The type of the output buffer. */
     typedef OutputBuffer output_buffer_type;
 
+  private:
+    /** \brief The type of the dictionary of the encoder. */
+    typedef lzw_dictionary dictionary;
+
   public:
-    void encode(input_buffer_type& input, output_buffer_type& output) const;
+    void encode(input_buffer_type& input, output_buffer_type& output);
+
+  private:
+    /** \brief The dictionary of the codes, kept between the calls to
+        encode() to reuse its memory. */
+    dictionary m_table;
 
   }; // class lzw_encoder
 }
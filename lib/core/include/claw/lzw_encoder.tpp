@@ -3,7 +3,7 @@
  * \brief Implementation of the claw::lzw_encoder class.
  * \author Julien Jorge
  */
-#include <map>
+#include <algorithm>
 
 /**
  * \brief Encode a sequence of datas.
@@ -12,31 +12,30 @@
  */
 template <typename InputBuffer, typename OutputBuffer>
 void claw::lzw_encoder<InputBuffer, OutputBuffer>::encode(
-    input_buffer_type& input, output_buffer_type& output) const
+    input_buffer_type& input, output_buffer_type& output)
 {
-  typedef std::pair<unsigned int, unsigned int> word;
-
   if(!input.end_of_data())
     {
-      std::map<word, unsigned int> table;
+      const unsigned int max_code = output.max_code();
+      m_table.clear(input.symbols_count(), max_code);
 
       unsigned int symbol = input.get_next();
       unsigned int prefix_code = symbol;
       unsigned int next_code = input.symbols_count();
 
-      while(!input.end_of_data() && (next_code != output.max_code()))
+      while(!input.end_of_data() && (next_code != max_code))
         {
           symbol = input.get_next();
 
-          word new_word(prefix_code, symbol);
+          const unsigned int code =
+              m_table.find_or_insert(prefix_code, symbol, next_code);
 
-          if(table.find(new_word) != table.end())
-            prefix_code = table[new_word];
+          if(code != dictionary::not_found)
+            prefix_code = code;
           else
             {
               output.write(prefix_code);
               output.new_code(next_code);
-              table[new_word] = next_code;
               prefix_code = symbol;
 
               ++next_code;
@@ -0,0 +1,97 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_push_decoder.hpp
+ * \brief An LZW decoder receiving the codes to decode one by one.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_LZW_PUSH_DECODER_HPP__
+#define __CLAW_LZW_PUSH_DECODER_HPP__
+
+#include <claw/lzw_string_table.hpp>
+
+namespace claw
+{
+  /**
+   * \brief An LZW decoder receiving the codes to decode one by one.
+   *
+   * Unlike claw::lzw_decoder, which reads its input until the end of the
+   * dictionary, this decoder is given the codes as they become available,
+   * for example when they are received from a socket, and keeps its string
+   * table between the calls to push(). The symbols of a code are written in
+   * the output buffer as soon as the code is pushed.
+   *
+   * The codes marking the end of a dictionary are not interpreted by the
+   * decoder: the caller has to call reset() when it reads one. The caller
+   * also computes the size of the codes from code_count() if the codes have
+   * a variable length.
+   *
+   * \b Template \b parameters:
+   * - \a OutputBuffer The type of the buffer where we write the uncompressed
+   *   datas.
+   *
+   * The \a OutputBuffer type must have the following methods:
+   * - write( unsigned int ), write a symbol in the output.
+   *
+   * \author Julien Jorge
+   */
+  template <typename OutputBuffer>
+  class lzw_push_decoder
+  {
+  public:
+    /** \brief The type of the output buffer. */
+    typedef OutputBuffer output_buffer_type;
+
+  public:
+    lzw_push_decoder(output_buffer_type& output, unsigned int symbols_count);
+
+    void push(unsigned int code);
+    void reset();
+
+    unsigned int code_count() const;
+
+  private:
+    /** \brief Where we write the symbols. */
+    output_buffer_type& m_output;
+
+    /** \brief The number of symbols in the uncompressed data. */
+    const unsigned int m_symbols_count;
+
+    /** \brief The strings associated with the codes. */
+    lzw_string_table m_table;
+
+    /** \brief Tell if m_prefix is the last code received in the current
+        dictionary. */
+    bool m_has_prefix;
+
+    /** \brief The last code received. */
+    unsigned int m_prefix;
+
+  }; // class lzw_push_decoder
+}
+
+#include <claw/lzw_push_decoder.tpp>
+
+#endif // __CLAW_LZW_PUSH_DECODER_HPP__
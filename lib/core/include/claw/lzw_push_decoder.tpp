@@ -0,0 +1,97 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_push_decoder.tpp
+ * \brief Implementation of the claw::lzw_push_decoder class.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+
+/**
+ * \brief Constructor.
+ * \param output Where we write the symbols.
+ * \param symbols_count The number of symbols in the uncompressed data.
+ */
+template <typename OutputBuffer>
+claw::lzw_push_decoder<OutputBuffer>::lzw_push_decoder(
+    output_buffer_type& output, unsigned int symbols_count)
+  : m_output(output)
+  , m_symbols_count(symbols_count)
+  , m_has_prefix(false)
+  , m_prefix(0)
+{
+  m_table.clear(m_symbols_count);
+}
+
+/**
+ * \brief Decode a code.
+ * \param code The code to decode.
+ *
+ * \remark The code must be a symbol, a code of the table or the code to be
+ *         added next in the table. Otherwise a claw::bad_format is thrown.
+ */
+template <typename OutputBuffer>
+void claw::lzw_push_decoder<OutputBuffer>::push(unsigned int code)
+{
+  if(!m_has_prefix)
+    {
+      if(code >= m_symbols_count)
+        throw claw::bad_format("lzw_push_decoder: invalid code.");
+
+      m_has_prefix = true;
+    }
+  else
+    {
+      if(code > m_table.size())
+        throw claw::bad_format("lzw_push_decoder: invalid code.");
+
+      if(code < m_table.size())
+        m_table.add(m_prefix, m_table.get_first_symbol(code));
+      else
+        m_table.add(m_prefix, m_table.get_first_symbol(m_prefix));
+    }
+
+  m_table.write(code, m_output);
+  m_prefix = code;
+}
+
+/**
+ * \brief Start a new dictionary.
+ */
+template <typename OutputBuffer>
+void claw::lzw_push_decoder<OutputBuffer>::reset()
+{
+  m_table.clear(m_symbols_count);
+  m_has_prefix = false;
+}
+
+/**
+ * \brief Get the number of codes in the table, including the symbols.
+ */
+template <typename OutputBuffer>
+unsigned int claw::lzw_push_decoder<OutputBuffer>::code_count() const
+{
+  return m_table.size();
+}
@@ -0,0 +1,115 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_push_encoder.hpp
+ * \brief An LZW encoder receiving the data to encode piece by piece.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_LZW_PUSH_ENCODER_HPP__
+#define __CLAW_LZW_PUSH_ENCODER_HPP__
+
+#include <claw/lzw_dictionary.hpp>
+
+namespace claw
+{
+  /**
+   * \brief An LZW encoder receiving the data to encode piece by piece.
+   *
+   * Unlike claw::lzw_encoder, which reads its input until the end, this
+   * encoder is given the symbols as they become available and keeps its
+   * dictionary between the calls to push(). The codes are written in the
+   * output buffer as soon as they are known, and finish() writes the last
+   * one. The memory used by the encoder is bounded by the size of the
+   * dictionary.
+   *
+   * \b Template \b parameters:
+   * - \a OutputBuffer The type of the output buffer (where we write compressed
+   *      data).
+   *
+   * The \a OutputBuffer type must have the following methods:
+   * - unsigned int max_code(), get the highest code that the output buffer can
+   *   handle,
+   * - write( unsigned int ), write a code in the output,
+   * - new_code( unsigned int ), called each time a new code is added in the
+   *   dictionary,
+   * - end_of_dictionary(), called when the dictionary is full, before the
+   *   encoder starts a new one, and by finish().
+   *
+   * The codes are the same as those produced by a claw::lzw_encoder called
+   * repeatedly on the whole input, with a call to end_of_dictionary() after
+   * each call.
+   *
+   * \author Julien Jorge
+   */
+  template <typename OutputBuffer>
+  class lzw_push_encoder
+  {
+  public:
+    /** \brief The type of the output buffer. */
+    typedef OutputBuffer output_buffer_type;
+
+  public:
+    lzw_push_encoder(output_buffer_type& output, unsigned int symbols_count);
+
+    void push(unsigned int symbol);
+
+    template <typename Iterator>
+    void push(Iterator first, Iterator last);
+
+    void finish();
+
+  private:
+    void end_dictionary();
+
+  private:
+    /** \brief Where we write the codes. */
+    output_buffer_type& m_output;
+
+    /** \brief The number of symbols in the uncompressed data. */
+    const unsigned int m_symbols_count;
+
+    /** \brief The code after the last one that can be inserted in the
+        dictionary. */
+    const unsigned int m_max_code;
+
+    /** \brief The words of the current dictionary. */
+    lzw_dictionary m_dictionary;
+
+    /** \brief Tell if m_prefix_code is the code of a pending word. */
+    bool m_has_prefix;
+
+    /** \brief The code of the longest word of the dictionary matching the
+        last symbols. */
+    unsigned int m_prefix_code;
+
+    /** \brief The code to give to the next word added in the dictionary. */
+    unsigned int m_next_code;
+
+  }; // class lzw_push_encoder
+}
+
+#include <claw/lzw_push_encoder.tpp>
+
+#endif // __CLAW_LZW_PUSH_ENCODER_HPP__
@@ -0,0 +1,118 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_push_encoder.tpp
+ * \brief Implementation of the claw::lzw_push_encoder class.
+ * \author Julien Jorge
+ */
+
+/**
+ * \brief Constructor.
+ * \param output Where we write the codes.
+ * \param symbols_count The number of symbols in the uncompressed data.
+ */
+template <typename OutputBuffer>
+claw::lzw_push_encoder<OutputBuffer>::lzw_push_encoder(
+    output_buffer_type& output, unsigned int symbols_count)
+  : m_output(output)
+  , m_symbols_count(symbols_count)
+  , m_max_code(output.max_code())
+  , m_dictionary(symbols_count, m_max_code)
+  , m_has_prefix(false)
+  , m_prefix_code(0)
+  , m_next_code(symbols_count)
+{}
+
+/**
+ * \brief Encode a symbol.
+ * \param symbol The symbol to encode.
+ */
+template <typename OutputBuffer>
+void claw::lzw_push_encoder<OutputBuffer>::push(unsigned int symbol)
+{
+  if(!m_has_prefix)
+    {
+      m_prefix_code = symbol;
+      m_has_prefix = true;
+    }
+  else
+    {
+      const unsigned int code =
+          m_dictionary.find_or_insert(m_prefix_code, symbol, m_next_code);
+
+      if(code != lzw_dictionary::not_found)
+        m_prefix_code = code;
+      else
+        {
+          m_output.write(m_prefix_code);
+          m_output.new_code(m_next_code);
+          m_prefix_code = symbol;
+
+          ++m_next_code;
+        }
+    }
+
+  if(m_next_code == m_max_code)
+    end_dictionary();
+}
+
+/**
+ * \brief Encode a range of symbols.
+ * \param first The first symbol to encode.
+ * \param last The end of the range.
+ */
+template <typename OutputBuffer>
+template <typename Iterator>
+void claw::lzw_push_encoder<OutputBuffer>::push(Iterator first, Iterator last)
+{
+  for(; first != last; ++first)
+    push(*first);
+}
+
+/**
+ * \brief Write the code of the pending symbols, if any, and end the current
+ *        dictionary. The encoder can be used again for new data.
+ */
+template <typename OutputBuffer>
+void claw::lzw_push_encoder<OutputBuffer>::finish()
+{
+  if(m_has_prefix)
+    end_dictionary();
+}
+
+/**
+ * \brief Write the pending code, end the current dictionary and start a new
+ *        one.
+ */
+template <typename OutputBuffer>
+void claw::lzw_push_encoder<OutputBuffer>::end_dictionary()
+{
+  m_output.write(m_prefix_code);
+  m_output.end_of_dictionary();
+
+  m_dictionary.clear();
+  m_has_prefix = false;
+  m_next_code = m_symbols_count;
+}
@@ -0,0 +1,98 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_string_table.hpp
+ * \brief The table of the strings of an LZW decoder.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_LZW_STRING_TABLE_HPP__
+#define __CLAW_LZW_STRING_TABLE_HPP__
+
+#include <cstddef>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief The table of the strings of an LZW decoder.
+   *
+   * The codes lower than the number of symbols represent the symbols
+   * themselves. Each other entry stores the code of its prefix, its last
+   * symbol, its first symbol and its length. Thus the strings are rebuilt
+   * backward in a scratch buffer without chasing the prefixes twice. The
+   * memory is kept by clear(), so a table reused for several blocks does not
+   * allocate once it has seen its longest string.
+   *
+   * \author Julien Jorge
+   */
+  class lzw_string_table
+  {
+  private:
+    /** \brief A string in the table. */
+    struct word_type
+    {
+      /** \brief The code of the string without its last symbol. */
+      unsigned int prefix;
+
+      /** \brief The last symbol of the string. */
+      unsigned int symbol;
+
+      /** \brief The first symbol of the string. */
+      unsigned int first;
+
+      /** \brief The number of symbols in the string. */
+      unsigned int length;
+    };
+
+  public:
+    inline lzw_string_table();
+
+    inline void clear(unsigned int symbols_count);
+
+    inline unsigned int size() const;
+
+    inline void add(unsigned int prefix, unsigned int symbol);
+    inline unsigned int get_first_symbol(unsigned int code) const;
+
+    template <typename OutputBuffer>
+    void write(unsigned int code, OutputBuffer& output);
+
+  private:
+    /** \brief The count of atomic codes. */
+    unsigned int m_symbols_count;
+
+    /** \brief The strings associated with the codes greater or equal to the
+        number of symbols. */
+    std::vector<word_type> m_words;
+
+    /** \brief The buffer in which the strings are rebuilt. */
+    std::vector<unsigned int> m_scratch;
+
+  }; // class lzw_string_table
+}
+
+#include <claw/lzw_string_table.ipp>
+
+#endif // __CLAW_LZW_STRING_TABLE_HPP__
@@ -0,0 +1,134 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file lzw_string_table.ipp
+ * \brief Implementation of the claw::lzw_string_table class.
+ * \author Julien Jorge
+ */
+#include <cassert>
+
+/**
+ * \brief Constructor.
+ */
+inline claw::lzw_string_table::lzw_string_table()
+  : m_symbols_count(0)
+{}
+
+/**
+ * \brief Remove all the strings from the table.
+ * \param symbols_count The count of atomic codes.
+ */
+inline void claw::lzw_string_table::clear(unsigned int symbols_count)
+{
+  m_symbols_count = symbols_count;
+  m_words.clear();
+}
+
+/**
+ * \brief Get the number of codes in the table, including the atomic codes.
+ */
+inline unsigned int claw::lzw_string_table::size() const
+{
+  return m_symbols_count + m_words.size();
+}
+
+/**
+ * \brief Add in the table the string made of a known string followed by a
+ *        symbol.
+ * \param prefix The code of the known string.
+ * \param symbol The symbol added at the end of the string.
+ */
+inline void claw::lzw_string_table::add(unsigned int prefix,
+                                        unsigned int symbol)
+{
+  assert(prefix < size());
+
+  word_type result;
+
+  result.prefix = prefix;
+  result.symbol = symbol;
+
+  if(prefix < m_symbols_count)
+    {
+      result.first = prefix;
+      result.length = 2;
+    }
+  else
+    {
+      const word_type& w = m_words[prefix - m_symbols_count];
+      result.first = w.first;
+      result.length = w.length + 1;
+    }
+
+  m_words.push_back(result);
+}
+
+/**
+ * \brief Get the first symbol of a string, represented by a code.
+ * \param code The code of the string from which we want the first symbol.
+ */
+inline unsigned int
+claw::lzw_string_table::get_first_symbol(unsigned int code) const
+{
+  if(code < m_symbols_count)
+    return code;
+  else
+    return m_words[code - m_symbols_count].first;
+}
+
+/**
+ * \brief Write a string, represented by a code, in an output buffer.
+ * \param code The code of the string to write.
+ * \param output Where we write the symbols of the string.
+ */
+template <typename OutputBuffer>
+void claw::lzw_string_table::write(unsigned int code, OutputBuffer& output)
+{
+  if(code < m_symbols_count)
+    {
+      output.write(code);
+      return;
+    }
+
+  const std::size_t length = m_words[code - m_symbols_count].length;
+
+  if(m_scratch.size() < length)
+    m_scratch.resize(2 * length);
+
+  std::size_t i = length;
+
+  while(code >= m_symbols_count)
+    {
+      const word_type& w = m_words[code - m_symbols_count];
+      --i;
+      m_scratch[i] = w.symbol;
+      code = w.prefix;
+    }
+
+  m_scratch[0] = code;
+
+  for(i = 0; i != length; ++i)
+    output.write(m_scratch[i]);
+}
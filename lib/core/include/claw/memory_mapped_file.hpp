@@ -0,0 +1,112 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file memory_mapped_file.hpp
+ * \brief A file mapped in memory, in read only mode.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_MEMORY_MAPPED_FILE_HPP__
+#define __CLAW_MEMORY_MAPPED_FILE_HPP__
+
+#include <claw/buffered_istream.hpp>
+#include <claw/non_copyable.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace claw
+{
+  /**
+   * \brief A file mapped in memory, in read only mode.
+   *
+   * The content of the file can be read with a
+   * claw::buffered_istream<memory_mapped_file>, whose read_more() never
+   * copies anything, or with a claw::imemory_stream for the code expecting a
+   * std::istream.
+   *
+   * \author Julien Jorge
+   */
+  class memory_mapped_file : public pattern::non_copyable
+  {
+  public:
+    inline explicit memory_mapped_file(const std::string& path);
+    inline ~memory_mapped_file();
+
+    inline const char* data() const;
+    inline std::size_t size() const;
+
+  private:
+    /** \brief The content of the file. */
+    const char* m_data;
+
+    /** \brief The size of the file. */
+    std::size_t m_size;
+
+  }; // class memory_mapped_file
+
+  /**
+   * \brief Specialization of buffered_istream reading a memory mapped file.
+   *
+   * The whole file is always available in the buffer, thus read_more() only
+   * tells if there is enough data.
+   *
+   * \author Julien Jorge
+   */
+  template <>
+  class buffered_istream<memory_mapped_file>
+  {
+  private:
+    /** \brief The type of the stream we will read. */
+    typedef memory_mapped_file stream_type;
+
+  public:
+    inline buffered_istream(const stream_type& f);
+
+    inline unsigned int remaining() const;
+    inline bool read_more(unsigned int n);
+
+    inline const char* get_buffer() const;
+    inline char get_next();
+    inline bool read(char* buf, unsigned int n);
+
+    inline void move(unsigned int n);
+
+    inline bool close();
+
+    inline operator bool() const;
+
+  private:
+    /** \brief Pointer to the current not already read byte. */
+    const char* m_current;
+
+    /** \brief Pointer to the end of the file. */
+    const char* const m_end;
+
+  }; // class buffered_istream [memory_mapped_file]
+}
+
+#include <claw/memory_mapped_file.ipp>
+
+#endif // __CLAW_MEMORY_MAPPED_FILE_HPP__
@@ -0,0 +1,170 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file memory_mapped_file.ipp
+ * \brief Implementation of the claw::memory_mapped_file class.
+ * \author Julien Jorge
+ */
+#include <claw/exception.hpp>
+#include <claw/memory_mapping_traits.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+/**
+ * \brief Constructor.
+ * \param path The path of the file to map.
+ */
+inline claw::memory_mapped_file::memory_mapped_file(const std::string& path)
+  : m_data(NULL)
+  , m_size(0)
+{
+  m_data = memory_mapping_traits::map(path, m_size);
+
+  if(m_data == NULL)
+    throw claw::exception("Can't map file '" + path + "'.");
+}
+
+/**
+ * \brief Destructor.
+ */
+inline claw::memory_mapped_file::~memory_mapped_file()
+{
+  memory_mapping_traits::unmap(m_data, m_size);
+}
+
+/**
+ * \brief Get the content of the file.
+ */
+inline const char* claw::memory_mapped_file::data() const
+{
+  return m_data;
+}
+
+/**
+ * \brief Get the size of the file.
+ */
+inline std::size_t claw::memory_mapped_file::size() const
+{
+  return m_size;
+}
+
+/**
+ * \brief Constructor.
+ * \param f The file to read.
+ */
+inline claw::buffered_istream<claw::memory_mapped_file>::buffered_istream(
+    const stream_type& f)
+  : m_current(f.data())
+  , m_end(f.data() + f.size())
+{}
+
+/**
+ * \brief Tell how many bytes are ready in the buffer.
+ */
+inline unsigned int
+claw::buffered_istream<claw::memory_mapped_file>::remaining() const
+{
+  return std::min<std::size_t>(m_end - m_current,
+                               std::numeric_limits<unsigned int>::max());
+}
+
+/**
+ * \brief Tell if there are at least a given number of bytes in the buffer.
+ * \param n The number of bytes needed.
+ */
+inline bool
+claw::buffered_istream<claw::memory_mapped_file>::read_more(unsigned int n)
+{
+  return n <= remaining();
+}
+
+/**
+ * \brief Get the input buffer.
+ */
+inline const char*
+claw::buffered_istream<claw::memory_mapped_file>::get_buffer() const
+{
+  return m_current;
+}
+
+/**
+ * \brief Get the next character.
+ */
+inline char claw::buffered_istream<claw::memory_mapped_file>::get_next()
+{
+  assert(remaining() >= 1);
+
+  const char result = *m_current;
+  ++m_current;
+
+  return result;
+}
+
+/**
+ * \brief Read a range of data.
+ * \param buf The buffer in which we write the read data.
+ * \param n The number of bytes to read.
+ */
+inline bool
+claw::buffered_istream<claw::memory_mapped_file>::read(char* buf,
+                                                      unsigned int n)
+{
+  const unsigned int len = std::min(n, remaining());
+
+  std::copy(m_current, m_current + len, buf);
+  m_current += len;
+
+  return len == n;
+}
+
+/**
+ * \brief Move some bytes forward.
+ * \param n The number of bytes to skip.
+ */
+inline void
+claw::buffered_istream<claw::memory_mapped_file>::move(unsigned int n)
+{
+  assert(m_current + n <= m_end);
+  m_current += n;
+}
+
+/**
+ * \brief Stop reading the file. Nothing to do since nothing was read in
+ *        advance.
+ */
+inline bool claw::buffered_istream<claw::memory_mapped_file>::close()
+{
+  return true;
+}
+
+/**
+ * \brief Tell if there is still data to read.
+ */
+inline claw::buffered_istream<claw::memory_mapped_file>::operator bool() const
+{
+  return m_current != m_end;
+}
@@ -0,0 +1,56 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file memory_mapping_traits.hpp
+ * \brief Include the good interface for memory mapped files for your system.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_MEMORY_MAPPING_TRAITS_HPP__
+#define __CLAW_MEMORY_MAPPING_TRAITS_HPP__
+
+/**
+ * \class claw::memory_mapping_traits
+ *
+ * \brief Common interface for platform specific methods needed for mapping a
+ *        file in memory.
+ *
+ * This interface must include:
+ * - a method <tt> const char* map(std::string, std::size_t&) </tt> mapping a
+ *   file in read only mode and returning the address of its content, or
+ *   NULL if the file can't be mapped. The size of the file is stored in the
+ *   second argument. Empty files are mapped to a valid address.
+ * - a method <tt> void unmap(const char*, std::size_t) </tt> releasing the
+ *   memory of a mapped file.
+ *
+ * All these methods must be defined as <tt> static </tt>.
+ */
+
+#ifdef _WIN32
+#include <claw/memory_mapping_traits_win32.hpp>
+#else
+#include <claw/memory_mapping_traits_unix.hpp>
+#endif
+
+#endif // __CLAW_MEMORY_MAPPING_TRAITS_HPP__
@@ -0,0 +1,105 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file memory_mapping_traits_unix.hpp
+ * \brief Unix interface for mapping files in memory.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_MEMORY_MAPPING_TRAITS_UNIX_HPP__
+#define __CLAW_MEMORY_MAPPING_TRAITS_UNIX_HPP__
+
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace claw
+{
+  /**
+   * \brief Unix interface for mapping files in memory.
+   * \author Julien Jorge
+   */
+  class memory_mapping_traits
+  {
+  public:
+    /**
+     * \brief Map a file in memory, in read only mode.
+     * \param path The path of the file.
+     * \param size (out) The size of the file.
+     * \return The address of the content of the file, NULL if the file can't
+     *         be mapped.
+     */
+    static const char* map(const std::string& path, std::size_t& size)
+    {
+      const int fd = open(path.c_str(), O_RDONLY);
+
+      if(fd < 0)
+        return NULL;
+
+      struct stat st;
+      const char* result = NULL;
+
+      if(fstat(fd, &st) == 0)
+        {
+          size = st.st_size;
+
+          // mmap() refuses empty mappings.
+          if(size == 0)
+            result = "";
+          else
+            {
+              void* p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+              if(p != MAP_FAILED)
+                {
+                  posix_madvise(p, size, POSIX_MADV_SEQUENTIAL);
+                  result = static_cast<const char*>(p);
+                }
+            }
+        }
+
+      close(fd);
+
+      return result;
+    }
+
+    /**
+     * \brief Release the memory of a mapped file.
+     * \param data The address returned by map().
+     * \param size The size of the file.
+     */
+    static void unmap(const char* data, std::size_t size)
+    {
+      if(size != 0)
+        munmap(const_cast<char*>(data), size);
+    }
+
+  }; // class memory_mapping_traits
+}
+
+#endif // __CLAW_MEMORY_MAPPING_TRAITS_UNIX_HPP__
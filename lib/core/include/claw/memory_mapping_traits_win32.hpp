@@ -0,0 +1,107 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file memory_mapping_traits_win32.hpp
+ * \brief Windows interface for mapping files in memory.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_MEMORY_MAPPING_TRAITS_WIN32_HPP__
+#define __CLAW_MEMORY_MAPPING_TRAITS_WIN32_HPP__
+
+#include <cstddef>
+#include <string>
+
+#include <windows.h>
+
+namespace claw
+{
+  /**
+   * \brief Windows interface for mapping files in memory.
+   * \author Julien Jorge
+   */
+  class memory_mapping_traits
+  {
+  public:
+    /**
+     * \brief Map a file in memory, in read only mode.
+     * \param path The path of the file.
+     * \param size (out) The size of the file.
+     * \return The address of the content of the file, NULL if the file can't
+     *         be mapped.
+     */
+    static const char* map(const std::string& path, std::size_t& size)
+    {
+      HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                NULL);
+
+      if(file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+      LARGE_INTEGER file_size;
+      const char* result = NULL;
+
+      if(GetFileSizeEx(file, &file_size))
+        {
+          size = file_size.QuadPart;
+
+          // CreateFileMapping() refuses empty files.
+          if(size == 0)
+            result = "";
+          else
+            {
+              // The view keeps the mapping alive once the handles are closed.
+              HANDLE mapping =
+                  CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+              if(mapping != NULL)
+                {
+                  result = static_cast<const char*>(
+                      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                  CloseHandle(mapping);
+                }
+            }
+        }
+
+      CloseHandle(file);
+
+      return result;
+    }
+
+    /**
+     * \brief Release the memory of a mapped file.
+     * \param data The address returned by map().
+     * \param size The size of the file.
+     */
+    static void unmap(const char* data, std::size_t size)
+    {
+      if(size != 0)
+        UnmapViewOfFile(data);
+    }
+
+  }; // class memory_mapping_traits
+}
+
+#endif // __CLAW_MEMORY_MAPPING_TRAITS_WIN32_HPP__
@@ -0,0 +1,51 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file parallel_for.hpp
+ * \brief Run a function on the bands of a range of indices, on a thread
+ *        pool.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_PARALLEL_FOR_HPP__
+#define __CLAW_PARALLEL_FOR_HPP__
+
+#include <claw/thread_pool.hpp>
+
+#include <cstddef>
+
+namespace claw
+{
+  template <typename Function>
+  void parallel_for(thread_pool& pool, std::size_t first, std::size_t last,
+                    std::size_t grain, Function f);
+
+  template <typename Function>
+  void parallel_for_lines(thread_pool* pool, std::size_t height,
+                          std::size_t min_band, Function f);
+}
+
+#include <claw/parallel_for.tpp>
+
+#endif // __CLAW_PARALLEL_FOR_HPP__
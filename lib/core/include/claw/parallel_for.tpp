@@ -0,0 +1,130 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file parallel_for.tpp
+ * \brief Implementation of the claw::parallel_for() and
+ *        claw::parallel_for_lines() functions.
+ * \author Julien Jorge
+ */
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+/**
+ * \brief Split a range of indices in consecutive bands and call a function
+ *        on each band, the bands being processed concurrently on a thread
+ *        pool.
+ * \param pool The threads processing the bands.
+ * \param first The first index of the range.
+ * \param last The index just past the end of the range.
+ * \param grain The minimum number of indices in a band.
+ * \param f The function called with the first and the last index of each
+ *        band, as f(band_first, band_last).
+ *
+ * The last band is processed by the calling thread, and the function returns
+ * once all the bands are done. If a call to \a f throws, the first exception
+ * is rethrown after the end of the other bands.
+ *
+ * The bands do not overlap, thus the result does not depend on the number of
+ * threads as long as \a f only writes the data of its band. This function
+ * must not be called from a task of the same pool, since the calling thread
+ * waits for the other tasks.
+ */
+template <typename Function>
+void claw::parallel_for(thread_pool& pool, std::size_t first,
+                        std::size_t last, std::size_t grain, Function f)
+{
+  const std::size_t count = last - first;
+  const std::size_t max_bands = 4 * pool.size();
+  const std::size_t bands =
+      std::min(max_bands, count / std::max<std::size_t>(grain, 1));
+
+  if((pool.size() == 1) || (bands <= 1))
+    {
+      f(first, last);
+      return;
+    }
+
+  const std::size_t step = (count + bands - 1) / bands;
+  std::vector<std::future<void> > tasks;
+  tasks.reserve(bands);
+
+  std::exception_ptr error;
+
+  try
+    {
+      std::size_t band_first = first;
+
+      for(; last - band_first > step; band_first += step)
+        {
+          const std::size_t band_last = band_first + step;
+          tasks.push_back(pool.push(
+              [&f, band_first, band_last]() -> void
+              {
+                f(band_first, band_last);
+              }));
+        }
+
+      f(band_first, last);
+    }
+  catch(...)
+    {
+      error = std::current_exception();
+    }
+
+  for(std::size_t i = 0; i != tasks.size(); ++i)
+    try
+      {
+        tasks[i].get();
+      }
+    catch(...)
+      {
+        if(!error)
+          error = std::current_exception();
+      }
+
+  if(error)
+    std::rethrow_exception(error);
+}
+
+/**
+ * \brief Call a function on the lines of an image, or any range of indices
+ *        starting at zero, by bands processed concurrently if a thread pool is
+ *        given.
+ * \param pool The threads processing the bands, NULL to process all the
+ *        lines in the calling thread.
+ * \param height The number of lines.
+ * \param min_band The minimum number of lines in a band.
+ * \param f The function called as f(first_line, last_line) for each band.
+ */
+template <typename Function>
+void claw::parallel_for_lines(thread_pool* pool, std::size_t height,
+                              std::size_t min_band, Function f)
+{
+  if(pool == NULL)
+    f(0, height);
+  else
+    parallel_for(*pool, 0, height, min_band, f);
+}
@@ -32,13 +32,56 @@
 
 namespace claw
 {
+  /**
+   * \brief The header of a packet of a run-length encoded stream, as read by
+   *        the mode reader of a claw::rle_decoder.
+   *
+   *\b Template \b parameters :
+   * - \a Pattern The type of the patterns in the coded stream.
+   *
+   * \author Julien Jorge
+   */
+  template <typename Pattern>
+  struct rle_packet
+  {
+    /**
+     * \brief State of the decompression.
+     */
+    enum mode_type
+    {
+      /** \brief Stop the decoding. */
+      stop,
+
+      /** \brief Next bytes represent raw data. */
+      raw,
+
+      /** \brief Next bytes represent compressed data. */
+      compressed
+    }; // enum mode_type
+
+    /** \brief Current mode of the decompression. */
+    mode_type mode;
+
+    /**
+     * \brief Case of mode :
+     * - mode == raw : The number of the next raw patterns,
+     * - mode == compressed : How many times the pattern is repeated.
+     */
+    unsigned int count;
+
+    /** \brief The pattern to repeat. */
+    Pattern pattern;
+
+  }; // struct rle_packet
+
   /**
    * \brief A class to help decoding run-length encoded (RLE) streams.
    *
    *\b Template \b parameters :
    * - \a Pattern The type of the patterns in the coded stream,
    * - \a InputBuffer The type of the input buffer,
-   * - \a OutputBuffer The type of the output buffer.
+   * - \a OutputBuffer The type of the output buffer,
+   * - \a ModeReader The policy reading the header of the packets.
    *
    * The \a Pattern and \a InputBuffer parameters don't have any type
    * requirement.
@@ -48,9 +91,20 @@ namespace claw
    * - copy( unsigned int n, InputBuffer input ), copy n patterns directly from
    *         the input buffer.
    *
+   * The \a ModeReader type must be default constructible and have the
+   * following method :
+   * - read_mode( InputBuffer& input, OutputBuffer& output,
+   *   rle_packet<Pattern>& packet ), read the header of the next packet in
+   *   \a input, eventually apply the special codes on \a output, and set
+   *   the mode of the packet, and its count and its pattern if needed.
+   *
+   * The mode reader is a template parameter, thus its calls are resolved at
+   * compile time and can be inlined in the decoding loop.
+   *
    * \author Julien Jorge
    */
-  template <typename Pattern, typename InputBuffer, typename OutputBuffer>
+  template <typename Pattern, typename InputBuffer, typename OutputBuffer,
+            typename ModeReader>
   class rle_decoder
   {
   public:
@@ -63,46 +117,21 @@ namespace claw
     /** \brief The type of the output buffer. */
     typedef OutputBuffer output_buffer_type;
 
-  protected:
-    /**
-     * \brief State of the decompression.
-     */
-    enum mode
-    {
-      /** \brief Stop the decoding. */
-      stop,
+    /** \brief The type of the policy reading the header of the packets. */
+    typedef ModeReader mode_reader_type;
 
-      /** \brief Next bytes represent raw data. */
-      raw,
-
-      /** \brief Next bytes represent compressed data. */
-      compressed
-    }; // enum mode
+    /** \brief The type of the header of the packets. */
+    typedef rle_packet<pattern_type> packet_type;
 
   public:
-    rle_decoder();
-    virtual ~rle_decoder();
+    explicit rle_decoder(const mode_reader_type& reader = mode_reader_type());
 
     void decode(input_buffer_type& input, output_buffer_type& output);
 
-  protected:
-    virtual void read_mode(input_buffer_type& input,
-                           output_buffer_type& output)
-        = 0;
+  private:
+    /** \brief The policy reading the header of the packets. */
+    mode_reader_type m_mode_reader;
 
-  protected:
-    /** \brief Current mode of the decompression. */
-    mode m_mode;
-
-    /**
-     * \brief Case of m_mode :
-     * - m_mode == raw : The number of the next raw patterns,
-     * - m_mode == compressed : How many times the pattern is repeated.
-     */
-    unsigned int m_count;
-
-    /** \brief The pattern to repeat. */
-    pattern_type m_pattern;
   }; // class rle_decoder
 }
 
@@ -24,24 +24,19 @@
 */
 /**
  * \file rle_decoder.tpp
- * \brief Implementation of the claw::rle_decoder class and subclasses.
+ * \brief Implementation of the claw::rle_decoder class.
  * \author Julien Jorge
  */
 
 /**
  * \brief Constructor.
+ * \param reader The policy reading the header of the packets.
  */
-template <typename Pattern, typename InputBuffer, typename OutputBuffer>
-claw::rle_decoder<Pattern, InputBuffer, OutputBuffer>::rle_decoder()
-  : m_mode(stop)
-  , m_count(0)
-{}
-
-/**
- * \brief Destructor.
- */
-template <typename Pattern, typename InputBuffer, typename OutputBuffer>
-claw::rle_decoder<Pattern, InputBuffer, OutputBuffer>::~rle_decoder()
+template <typename Pattern, typename InputBuffer, typename OutputBuffer,
+          typename ModeReader>
+claw::rle_decoder<Pattern, InputBuffer, OutputBuffer, ModeReader>::rle_decoder(
+    const mode_reader_type& reader)
+  : m_mode_reader(reader)
 {}
 
 /**
@@ -49,20 +44,23 @@ claw::rle_decoder<Pattern, InputBuffer, OutputBuffer>::~rle_decoder()
  * \param input The RLE stream.
  * \param output The raw stream.
  */
-template <typename Pattern, typename InputBuffer, typename OutputBuffer>
-void claw::rle_decoder<Pattern, InputBuffer, OutputBuffer>::decode(
+template <typename Pattern, typename InputBuffer, typename OutputBuffer,
+          typename ModeReader>
+void claw::rle_decoder<Pattern, InputBuffer, OutputBuffer, ModeReader>::decode(
     input_buffer_type& input, output_buffer_type& output)
 {
-  m_mode = stop;
-  read_mode(input, output);
+  packet_type packet;
+
+  packet.mode = packet_type::stop;
+  m_mode_reader.read_mode(input, output, packet);
 
-  while(m_mode != stop)
+  while(packet.mode != packet_type::stop)
     {
-      if(m_mode == compressed)
-        output.fill(m_count, m_pattern);
+      if(packet.mode == packet_type::compressed)
+        output.fill(packet.count, packet.pattern);
       else
-        output.copy(m_count, input);
+        output.copy(packet.count, input);
 
-      read_mode(input, output);
+      m_mode_reader.read_mode(input, output, packet);
     }
 }
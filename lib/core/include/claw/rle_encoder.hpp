@@ -30,7 +30,7 @@
 #ifndef __CLAW_RLE_ENCODER_HPP__
 #define __CLAW_RLE_ENCODER_HPP__
 
-#include <list>
+#include <claw/run_length.hpp>
 
 namespace claw
 {
@@ -46,12 +46,19 @@ namespace claw
    * The \a OutputBuffer type must have the following methods :
    * - encode( unsigned int n, pattern_type pattern ), code n times the
    *   pattern ;
-   * - template<typename Iterator> raw( Iterator first, Iterator last ) ;
+   * - template<typename Iterator> raw( Iterator first, Iterator last ), write
+   *   the values of a range of the encoded sequence without compression ;
    * - unsigned int min_interesting() returns the minimum number of time we
    *must have the same value before compressing it ;
    * - unsigned int max_encodable() return the maximum number of time we can
    *   have the same value before compressing it.
    *
+   * The runs are searched with claw::skip_run(), thus the search is done
+   * with SIMD instructions when the encoded sequence is given as pointers on
+   * contiguous values for which claw::is_bitwise_comparable is true. The raw
+   * data is passed to the output buffer as a range of the encoded sequence,
+   * without intermediate copy.
+   *
    * \author Julien Jorge
    */
   template <typename OutputBuffer>
@@ -64,10 +71,6 @@ namespace claw
     /** \brief The type of the stored data. */
     typedef typename output_buffer_type::pattern_type pattern_type;
 
-  private:
-    /** \brief The type of the buffer on which we store the raw data. */
-    typedef std::list<pattern_type> raw_buffer_type;
-
   public:
     template <typename Iterator>
     void encode(Iterator first, Iterator last,
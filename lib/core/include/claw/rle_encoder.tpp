@@ -35,7 +35,8 @@
  * \param last Iterator past the last data.
  * \param output The buffer on which we write the compressed data.
  *
- * \pre Iterator::value_type must be castable to pattern_type.
+ * \pre Iterator::value_type must be castable to pattern_type and Iterator
+ *      must be a forward iterator.
  */
 template <typename OutputBuffer>
 template <typename Iterator>
@@ -44,43 +45,29 @@ void claw::rle_encoder<OutputBuffer>::encode(Iterator first, Iterator last,
 {
   const unsigned int max_encodable = output.max_encodable();
   const unsigned int min_interesting = output.min_interesting();
-  raw_buffer_type raw_buffer;
+
+  // The beginning of the data not written in the output yet.
+  Iterator raw_first = first;
 
   assert(max_encodable > 0);
 
   while(first != last)
     {
-      unsigned int count = 1;
-      pattern_type pattern = *first;
-      Iterator saved_it = first;
-      ++first;
-      bool ok = true;
-
-      // try to find enough similar data
-      while(ok && (first != last) && (count < max_encodable))
-        if(*first == pattern)
-          {
-            ++count;
-            ++first;
-          }
-        else
-          ok = false;
+      const pattern_type pattern = *first;
+      const Iterator saved_it = first;
+      const std::size_t count = skip_run(first, last, max_encodable);
 
       // if we have enough data
       if(count >= min_interesting)
         {
-          if(!raw_buffer.empty())
-            {
-              output.raw(raw_buffer.begin(), raw_buffer.end());
-              raw_buffer.clear();
-            }
+          if(raw_first != saved_it)
+            output.raw(raw_first, saved_it);
 
           output.encode(count, pattern);
+          raw_first = first;
         }
-      else
-        raw_buffer.insert(raw_buffer.end(), saved_it, first);
     }
 
-  if(!raw_buffer.empty())
-    output.raw(raw_buffer.begin(), raw_buffer.end());
+  if(raw_first != last)
+    output.raw(raw_first, last);
 }
@@ -0,0 +1,67 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file run_length.hpp
+ * \brief Functions to find the runs of equal values in a sequence, as needed
+ *        by the RLE encoders.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_RUN_LENGTH_HPP__
+#define __CLAW_RUN_LENGTH_HPP__
+
+#include <cstddef>
+#include <type_traits>
+
+namespace claw
+{
+  /**
+   * \brief Tell if two values of a type are equal if and only if their bytes
+   *        are equal.
+   *
+   * The runs of such values stored in contiguous memory are searched with
+   * SIMD instructions. Specialize this class for the types having this
+   * property.
+   *
+   * \b Template \b parameters:
+   * - \a T The type of the values.
+   */
+  template <typename T>
+  struct is_bitwise_comparable
+    : public std::integral_constant<bool, std::is_integral<T>::value>
+  {}; // struct is_bitwise_comparable
+
+  template <typename Iterator>
+  std::size_t skip_run(Iterator& first, Iterator last, std::size_t max);
+
+  template <typename T>
+  std::size_t skip_run(const T*& first, const T* last, std::size_t max);
+
+  template <typename T>
+  std::size_t skip_run(T*& first, T* last, std::size_t max);
+}
+
+#include <claw/run_length.tpp>
+
+#endif // __CLAW_RUN_LENGTH_HPP__
@@ -0,0 +1,173 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file run_length.tpp
+ * \brief Implementation of the functions of run_length.hpp.
+ * \author Julien Jorge
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace claw
+{
+  namespace detail
+  {
+    /**
+     * \brief Count the values at the beginning of a range that are equal to
+     *        the first one, one value at a time.
+     * \param first The beginning of the range.
+     * \param n The length of the range.
+     */
+    template <typename T>
+    std::size_t run_length(const T* first, std::size_t n, std::false_type)
+    {
+      const T& pattern = *first;
+      std::size_t i = 1;
+
+      while((i != n) && (first[i] == pattern))
+        ++i;
+
+      return i;
+    }
+
+    /**
+     * \brief Count the values at the beginning of a range that are equal to
+     *        the first one, comparing the bytes of sixteen bytes blocks.
+     * \param first The beginning of the range.
+     * \param n The length of the range.
+     */
+    template <typename T>
+    std::size_t run_length(const T* first, std::size_t n, std::true_type)
+    {
+      std::size_t i = 1;
+
+#if defined(__SSE2__)
+      const std::size_t block = 16 / sizeof(T);
+      unsigned char repeated[16];
+
+      for(std::size_t j = 0; j != block; ++j)
+        std::memcpy(repeated + j * sizeof(T), first, sizeof(T));
+
+      const __m128i pattern =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(repeated));
+
+      for(i = 0; i + block <= n; i += block)
+        {
+          const __m128i values =
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+          const unsigned int mask =
+              _mm_movemask_epi8(_mm_cmpeq_epi8(values, pattern));
+
+          if(mask != 0xFFFF)
+            return i + __builtin_ctz(~mask) / sizeof(T);
+        }
+
+      if(i == 0)
+        i = 1;
+#endif
+
+      return i + run_length(first + i - 1, n - i + 1, std::false_type()) - 1;
+    }
+  }
+}
+
+/**
+ * \brief Move forward in a sequence while the values are equal to the first
+ *        one.
+ * \param first (in/out) The beginning of the sequence, moved past the run.
+ * \param last The end of the sequence.
+ * \param max The maximum length of the run.
+ * \return The length of the run.
+ * \pre (first != last) && (max > 0)
+ */
+template <typename Iterator>
+std::size_t claw::skip_run(Iterator& first, Iterator last, std::size_t max)
+{
+  assert(first != last);
+  assert(max > 0);
+
+  const typename std::iterator_traits<Iterator>::value_type pattern = *first;
+  std::size_t result = 1;
+
+  for(++first; (result != max) && (first != last) && (*first == pattern);
+      ++first)
+    ++result;
+
+  return result;
+}
+
+/**
+ * \brief Move forward in an array while the values are equal to the first
+ *        one.
+ * \param first (in/out) The beginning of the array, moved past the run.
+ * \param last The end of the array.
+ * \param max The maximum length of the run.
+ * \return The length of the run.
+ * \pre (first != last) && (max > 0)
+ *
+ * When claw::is_bitwise_comparable<T> is true and the SSE2 instructions are
+ * available, the values are compared sixteen bytes at a time.
+ */
+template <typename T>
+std::size_t claw::skip_run(const T*& first, const T* last, std::size_t max)
+{
+  assert(first != last);
+  assert(max > 0);
+
+  typedef std::integral_constant<bool, is_bitwise_comparable<T>::value
+                                           && (16 % sizeof(T) == 0)>
+      vectorizable;
+
+  const std::size_t result = detail::run_length(
+      first, std::min(max, (std::size_t)(last - first)), vectorizable());
+
+  first += result;
+  return result;
+}
+
+/**
+ * \brief Move forward in an array while the values are equal to the first
+ *        one.
+ * \param first (in/out) The beginning of the array, moved past the run.
+ * \param last The end of the array.
+ * \param max The maximum length of the run.
+ * \return The length of the run.
+ * \pre (first != last) && (max > 0)
+ */
+template <typename T>
+std::size_t claw::skip_run(T*& first, T* last, std::size_t max)
+{
+  const T* p = first;
+  const std::size_t result = skip_run(p, (const T*)last, max);
+
+  first += result;
+  return result;
+}
@@ -31,6 +31,12 @@
 #define __CLAW_STRING_ALGORITHM_HPP__
 
 #include <cstddef>
+#include <iterator>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 namespace claw
 {
@@ -55,10 +61,15 @@ namespace claw
     void squeeze(StringType& str,
                  const typename StringType::value_type* const s);
 
+    inline void squeeze(std::string& str, const char* const s);
+
     template <typename StringType>
     std::size_t replace(StringType& str, const StringType& e1,
                         const StringType& e2);
 
+    inline std::size_t replace(std::string& str, const std::string& e1,
+                               const std::string& e2);
+
     template <typename T, typename StringType>
     bool is_of_type(const StringType& str);
 
@@ -73,7 +84,21 @@ namespace claw
                const typename Sequence::value_type::value_type sep);
 
     template <typename InputIterator, typename OutputIterator>
-    void c_escape(InputIterator first, InputIterator last, OutputIterator out);
+    OutputIterator c_escape(InputIterator first, InputIterator last,
+                            OutputIterator out);
+
+    template <typename OutputIterator>
+    OutputIterator c_escape(const char* first, const char* last,
+                            OutputIterator out);
+
+    template <typename OutputIterator>
+    OutputIterator c_escape(std::string::const_iterator first,
+                            std::string::const_iterator last,
+                            OutputIterator out);
+
+    template <typename OutputIterator>
+    OutputIterator c_escape(std::string::iterator first,
+                            std::string::iterator last, OutputIterator out);
 
     template <typename StringType>
     bool glob_match(const StringType& pattern, const StringType& text,
@@ -88,6 +113,152 @@ namespace claw
         const typename StringType::value_type zero_or_one = '?',
         const typename StringType::value_type any = '.');
 
+#if __cplusplus >= 201703L
+    /**
+     * \brief A range on the substrings of a string separated by a given
+     *        separator. The substrings are found on demand, when the range is
+     *        iterated.
+     *
+     * The substrings are the same than the ones produced by
+     * split( Sequence&, const Sequence::value_type&, sep ), but they are
+     * views in the initial string, thus no memory is allocated.
+     *
+     * \author Julien Jorge
+     */
+    template <typename CharT, typename Traits = std::char_traits<CharT> >
+    class split_range
+    {
+    public:
+      /** \brief The type of the string to split and of the substrings. */
+      typedef std::basic_string_view<CharT, Traits> string_view_type;
+
+      /**
+       * \brief Iterator on the substrings.
+       */
+      class const_iterator
+      {
+      public:
+        /** \brief The type of the current class. */
+        typedef const_iterator self_type;
+
+        /** \brief The type of the substrings. */
+        typedef string_view_type value_type;
+
+        /** \brief Reference on a substring. */
+        typedef const string_view_type& reference;
+
+        /** \brief Pointer on a substring. */
+        typedef const string_view_type* pointer;
+
+        /** \brief Difference between two iterators. */
+        typedef std::ptrdiff_t difference_type;
+
+        /** \brief The category of this iterator. */
+        typedef std::forward_iterator_tag iterator_category;
+
+      public:
+        const_iterator();
+        const_iterator(string_view_type str, CharT sep);
+
+        bool operator==(const self_type& that) const;
+        bool operator!=(const self_type& that) const;
+
+        self_type& operator++();
+        self_type operator++(int);
+
+        reference operator*() const;
+        pointer operator->() const;
+
+      private:
+        void next();
+
+      private:
+        /** \brief The part of the string after the current substring. */
+        string_view_type m_rest;
+
+        /** \brief The current substring. */
+        string_view_type m_piece;
+
+        /** \brief The separator of the substrings. */
+        CharT m_separator;
+
+        /** \brief Tell if the current substring is the last one. */
+        bool m_last;
+
+        /** \brief Tell if the iterator is past the last substring. */
+        bool m_end;
+
+      }; // class const_iterator
+
+      /** \brief Iterator on the substrings. */
+      typedef const_iterator iterator;
+
+    public:
+      split_range(string_view_type str, CharT sep);
+
+      const_iterator begin() const;
+      const_iterator end() const;
+
+    private:
+      /** \brief The string to split. */
+      const string_view_type m_string;
+
+      /** \brief The separator of the substrings. */
+      const CharT m_separator;
+
+    }; // class split_range
+
+    template <typename CharT, typename Traits>
+    std::basic_string_view<CharT, Traits>
+    trim_left_view(std::basic_string_view<CharT, Traits> str,
+                   const CharT* const s = " ");
+    template <typename CharT, typename Traits, typename Alloc>
+    std::basic_string_view<CharT, Traits>
+    trim_left_view(const std::basic_string<CharT, Traits, Alloc>& str,
+                   const CharT* const s = " ");
+    template <typename CharT, typename Traits, typename Alloc>
+    void trim_left_view(const std::basic_string<CharT, Traits, Alloc>&& str,
+                        const CharT* const s = " ")
+        = delete;
+
+    template <typename CharT, typename Traits>
+    std::basic_string_view<CharT, Traits>
+    trim_right_view(std::basic_string_view<CharT, Traits> str,
+                    const CharT* const s = " ");
+    template <typename CharT, typename Traits, typename Alloc>
+    std::basic_string_view<CharT, Traits>
+    trim_right_view(const std::basic_string<CharT, Traits, Alloc>& str,
+                    const CharT* const s = " ");
+    template <typename CharT, typename Traits, typename Alloc>
+    void trim_right_view(const std::basic_string<CharT, Traits, Alloc>&& str,
+                         const CharT* const s = " ")
+        = delete;
+
+    template <typename CharT, typename Traits>
+    std::basic_string_view<CharT, Traits>
+    trim_view(std::basic_string_view<CharT, Traits> str,
+              const CharT* const s = " ");
+    template <typename CharT, typename Traits, typename Alloc>
+    std::basic_string_view<CharT, Traits>
+    trim_view(const std::basic_string<CharT, Traits, Alloc>& str,
+              const CharT* const s = " ");
+    template <typename CharT, typename Traits, typename Alloc>
+    void trim_view(const std::basic_string<CharT, Traits, Alloc>&& str,
+                   const CharT* const s = " ")
+        = delete;
+
+    template <typename CharT, typename Traits>
+    split_range<CharT, Traits> split(std::basic_string_view<CharT, Traits> str,
+                                     const CharT sep);
+    template <typename CharT, typename Traits, typename Alloc>
+    split_range<CharT, Traits>
+    split(const std::basic_string<CharT, Traits, Alloc>& str, const CharT sep);
+    template <typename CharT, typename Traits, typename Alloc>
+    void split(const std::basic_string<CharT, Traits, Alloc>&& str,
+               const CharT sep)
+        = delete;
+#endif
+
   }
 }
 
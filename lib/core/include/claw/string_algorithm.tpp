@@ -29,8 +29,11 @@
  */
 
 #include <claw/algorithm.hpp>
+#include <claw/byte_set.hpp>
 #include <claw/glob.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -138,6 +141,48 @@ void claw::text::squeeze(StringType& str,
   while((first != StringType::npos) && (first != str.length()));
 }
 
+/**
+ * \brief Squeeze successive characters of a string into one character.
+ * \param str The string to modify.
+ * \param s The characters to remove.
+ *
+ * This is the same than the generic squeeze() but the string is modified in
+ * place, in a single pass, and the characters to squeeze are searched by
+ * blocks with a claw::text::byte_set.
+ */
+inline void claw::text::squeeze(std::string& str, const char* const s)
+{
+  const byte_set chars(s, s + std::strlen(s));
+  char* const begin(&str[0]);
+  const char* const end(begin + str.size());
+  char* out(begin);
+  const char* first(begin);
+
+  while(first != end)
+    {
+      const char* const next(chars.find_first_of(first, end));
+
+      if(out != first)
+        std::memmove(out, first, next - first);
+
+      out += next - first;
+      first = next;
+
+      if(first != end)
+        {
+          const char c(*first);
+          *out = c;
+          ++out;
+
+          do
+            ++first;
+          while((first != end) && (*first == c));
+        }
+    }
+
+  str.resize(out - begin);
+}
+
 /**
  * \brief Replace a set of characters by other characters.
  * \param str The string to modify.
@@ -164,6 +209,49 @@ std::size_t claw::text::replace(StringType& str, const StringType& e1,
                        e2.begin(), e2.end());
 }
 
+/**
+ * \brief Replace a set of characters by other characters.
+ * \param str The string to modify.
+ * \param e1 The characters to remove.
+ * \param e2 The characters replacing the ones in \a e1.
+ *
+ * \return The number of replaced characters.
+ *
+ * This is the same than the generic replace() but the characters to replace
+ * are searched by blocks with a claw::text::byte_set, then replaced using a
+ * lookup table.
+ */
+inline std::size_t claw::text::replace(std::string& str, const std::string& e1,
+                                       const std::string& e2)
+{
+  if(e1.empty() || e2.empty())
+    return 0;
+
+  byte_set chars;
+  char replacement[256];
+
+  for(std::size_t i = 0; i != e1.size(); ++i)
+    if(!chars.contains(e1[i]))
+      {
+        chars.insert(e1[i]);
+        replacement[static_cast<unsigned char>(e1[i])] =
+            e2[std::min(i, e2.size() - 1)];
+      }
+
+  std::size_t count(0);
+  char* first(&str[0]);
+  const char* const last(first + str.size());
+
+  while((first = const_cast<char*>(chars.find_first_of(first, last))) != last)
+    {
+      *first = replacement[static_cast<unsigned char>(*first)];
+      ++first;
+      ++count;
+    }
+
+  return count;
+}
+
 /**
  * \brief Test if the content of a string is immediately convertible to a type.
  * \param str The string to test.
@@ -249,8 +337,8 @@ void claw::text::split(Sequence& sequence,
  * \remark This method has not been tested with wide chars yet.
  */
 template <typename InputIterator, typename OutputIterator>
-void claw::text::c_escape(InputIterator first, InputIterator last,
-                          OutputIterator out)
+OutputIterator claw::text::c_escape(InputIterator first, InputIterator last,
+                                    OutputIterator out)
 {
   typedef typename std::iterator_traits<InputIterator>::value_type char_type;
   typedef std::basic_string<char_type> string_type;
@@ -260,7 +348,7 @@ void claw::text::c_escape(InputIterator first, InputIterator last,
 
   bool escape(false);
 
-  for(; first != last; ++out)
+  while(first != last)
     if(escape)
       {
         switch(*first)
@@ -324,6 +412,7 @@ void claw::text::c_escape(InputIterator first, InputIterator last,
             ++first;
           }
 
+        ++out;
         escape = false;
       }
     else if(*first == '\\')
@@ -334,8 +423,117 @@ void claw::text::c_escape(InputIterator first, InputIterator last,
     else
       {
         *out = *first;
+        ++out;
         ++first;
       }
+
+  return out;
+}
+
+/**
+ * \brief Find escaped symbols in a sequence of characters and replace them by
+ *        their c-equivalent.
+ *
+ * \param first Pointer on the beginning of the string to escape.
+ * \param last Pointer just past the end of the string to escape.
+ * \param out Iterator on the beginning of the output string.
+ * \pre \a out points on a range long enough to store the resulting string.
+ *
+ * This is the same than the generic c_escape() but the characters between
+ * the escaped symbols are found with std::memchr() and copied in a single
+ * call, and the common escaped symbols are decoded with a lookup.
+ */
+template <typename OutputIterator>
+OutputIterator claw::text::c_escape(const char* first, const char* last,
+                                    OutputIterator out)
+{
+  static const char oct[] = "01234567";
+  static const char hex[] = "0123456789ABCDEFabcdef";
+  static const char symbols[] = "abfnrtv";
+  static const char values[] = "\a\b\f\n\r\t\v";
+
+  while(first != last)
+    {
+      const char* escape(
+          static_cast<const char*>(std::memchr(first, '\\', last - first)));
+
+      if(escape == NULL)
+        escape = last;
+
+      out = std::copy(first, escape, out);
+
+      if(escape == last)
+        first = last;
+      else
+        {
+          first = escape + 1;
+
+          if(first == last)
+            ; // a single backslash at the end produces nothing
+          else if((*first == 'o') || (*first == 'x'))
+            {
+              if(*first == 'o')
+                first = find_first_not_of(first + 1, last, oct, oct + 8);
+              else
+                first = find_first_not_of(first + 1, last, hex, hex + 22);
+
+              out = c_escape<const char*, OutputIterator>(escape, first, out);
+            }
+          else
+            {
+              const char* const symbol(std::strchr(symbols, *first));
+
+              if((symbol == NULL) || (*first == '\0'))
+                *out = *first;
+              else
+                *out = values[symbol - symbols];
+
+              ++out;
+              ++first;
+            }
+        }
+    }
+
+  return out;
+}
+
+/**
+ * \brief Find escaped symbols in a string and replace them by their
+ *        c-equivalent.
+ *
+ * \param first Iterator on the beginning of the string to escape.
+ * \param last Iterator just past the end of the string to escape.
+ * \param out Iterator on the beginning of the output string.
+ * \pre \a out points on a range long enough to store the resulting string.
+ */
+template <typename OutputIterator>
+OutputIterator claw::text::c_escape(std::string::const_iterator first,
+                                    std::string::const_iterator last,
+                                    OutputIterator out)
+{
+  if(first == last)
+    return out;
+
+  const char* const p(&*first);
+  return c_escape(p, p + (last - first), out);
+}
+
+/**
+ * \brief Find escaped symbols in a string and replace them by their
+ *        c-equivalent.
+ *
+ * \param first Iterator on the beginning of the string to escape.
+ * \param last Iterator just past the end of the string to escape.
+ * \param out Iterator on the beginning of the output string.
+ * \pre \a out points on a range long enough to store the resulting string.
+ */
+template <typename OutputIterator>
+OutputIterator claw::text::c_escape(std::string::iterator first,
+                                    std::string::iterator last,
+                                    OutputIterator out)
+{
+  return c_escape(std::string::const_iterator(first),
+                  std::string::const_iterator(last), out);
 }
 
 /**
@@ -377,3 +575,300 @@ bool claw::text::glob_potential_match(
                                     text.begin(), text.end(), any_sequence,
                                     zero_or_one, any);
 }
+
+#if __cplusplus >= 201703L
+
+/**
+ * \brief Constructor of the end iterator.
+ */
+template <typename CharT, typename Traits>
+claw::text::split_range<CharT, Traits>::const_iterator::const_iterator()
+  : m_separator()
+  , m_last(true)
+  , m_end(true)
+{}
+
+/**
+ * \brief Constructor of an iterator on the first substring of a string.
+ * \param str The string to split.
+ * \param sep The separator on which the string is splitted.
+ */
+template <typename CharT, typename Traits>
+claw::text::split_range<CharT, Traits>::const_iterator::const_iterator(
+    string_view_type str, CharT sep)
+  : m_rest(str)
+  , m_separator(sep)
+  , m_last(false)
+  , m_end(str.empty())
+{
+  if(!m_end)
+    next();
+}
+
+/**
+ * \brief Tell if two iterators are on the same substring.
+ * \param that The other iterator.
+ */
+template <typename CharT, typename Traits>
+bool claw::text::split_range<CharT, Traits>::const_iterator::operator==(
+    const self_type& that) const
+{
+  if(m_end || that.m_end)
+    return m_end == that.m_end;
+  else
+    return (m_piece.data() == that.m_piece.data())
+           && (m_piece.size() == that.m_piece.size());
+}
+
+/**
+ * \brief Tell if two iterators are on different substrings.
+ * \param that The other iterator.
+ */
+template <typename CharT, typename Traits>
+bool claw::text::split_range<CharT, Traits>::const_iterator::operator!=(
+    const self_type& that) const
+{
+  return !(*this == that);
+}
+
+/**
+ * \brief Move to the next substring (preincrement).
+ */
+template <typename CharT, typename Traits>
+typename claw::text::split_range<CharT, Traits>::const_iterator::self_type&
+claw::text::split_range<CharT, Traits>::const_iterator::operator++()
+{
+  if(m_last)
+    m_end = true;
+  else
+    next();
+
+  return *this;
+}
+
+/**
+ * \brief Move to the next substring (postincrement).
+ */
+template <typename CharT, typename Traits>
+typename claw::text::split_range<CharT, Traits>::const_iterator::self_type
+claw::text::split_range<CharT, Traits>::const_iterator::operator++(int)
+{
+  self_type result(*this);
+  ++(*this);
+  return result;
+}
+
+/**
+ * \brief Get the current substring.
+ */
+template <typename CharT, typename Traits>
+typename claw::text::split_range<CharT, Traits>::const_iterator::reference
+claw::text::split_range<CharT, Traits>::const_iterator::operator*() const
+{
+  return m_piece;
+}
+
+/**
+ * \brief Get a pointer on the current substring.
+ */
+template <typename CharT, typename Traits>
+typename claw::text::split_range<CharT, Traits>::const_iterator::pointer
+claw::text::split_range<CharT, Traits>::const_iterator::operator->() const
+{
+  return &m_piece;
+}
+
+/**
+ * \brief Find the next substring in the remaining part of the string.
+ *
+ * Like std::getline(), a separator at the end of the string does not
+ * produce an empty substring.
+ */
+template <typename CharT, typename Traits>
+void claw::text::split_range<CharT, Traits>::const_iterator::next()
+{
+  const typename string_view_type::size_type p(m_rest.find(m_separator));
+
+  if(p == string_view_type::npos)
+    {
+      m_piece = m_rest;
+      m_rest = string_view_type();
+      m_last = true;
+    }
+  else
+    {
+      m_piece = m_rest.substr(0, p);
+      m_rest.remove_prefix(p + 1);
+      m_last = m_rest.empty();
+    }
+}
+
+/**
+ * \brief Constructor.
+ * \param str The string to split.
+ * \param sep The separator on which the string is splitted.
+ */
+template <typename CharT, typename Traits>
+claw::text::split_range<CharT, Traits>::split_range(string_view_type str,
+                                                    CharT sep)
+  : m_string(str)
+  , m_separator(sep)
+{}
+
+/**
+ * \brief Get an iterator on the first substring.
+ */
+template <typename CharT, typename Traits>
+typename claw::text::split_range<CharT, Traits>::const_iterator
+claw::text::split_range<CharT, Traits>::begin() const
+{
+  return const_iterator(m_string, m_separator);
+}
+
+/**
+ * \brief Get an iterator just past the last substring.
+ */
+template <typename CharT, typename Traits>
+typename claw::text::split_range<CharT, Traits>::const_iterator
+claw::text::split_range<CharT, Traits>::end() const
+{
+  return const_iterator();
+}
+
+/**
+ * \brief Get the part of a string without the given characters at its
+ *        begining.
+ * \param str The string to trim.
+ * \param s The characters to remove.
+ * \return A view in \a str, or \a str itself if it contains only characters
+ *         from \a s, like trim_left( StringType&, s ).
+ *
+ * This function has its own name such that a std::string is never trimmed in
+ * place by mistake.
+ */
+template <typename CharT, typename Traits>
+std::basic_string_view<CharT, Traits>
+claw::text::trim_left_view(std::basic_string_view<CharT, Traits> str,
+                           const CharT* const s)
+{
+  const typename std::basic_string_view<CharT, Traits>::size_type p(
+      str.find_first_not_of(s));
+
+  if(p != std::basic_string_view<CharT, Traits>::npos)
+    str.remove_prefix(p);
+
+  return str;
+}
+
+/**
+ * \brief Get the part of a string without the given characters at its
+ *        begining.
+ * \param str The string to trim. It must outlive the returned view.
+ * \param s The characters to remove.
+ */
+template <typename CharT, typename Traits, typename Alloc>
+std::basic_string_view<CharT, Traits>
+claw::text::trim_left_view(const std::basic_string<CharT, Traits, Alloc>& str,
+                           const CharT* const s)
+{
+  return trim_left_view(std::basic_string_view<CharT, Traits>(str), s);
+}
+
+/**
+ * \brief Get the part of a string without the given characters at its end.
+ * \param str The string to trim.
+ * \param s The characters to remove.
+ * \return A view in \a str, or \a str itself if it contains only characters
+ *         from \a s, like trim_right( StringType&, s ).
+ */
+template <typename CharT, typename Traits>
+std::basic_string_view<CharT, Traits>
+claw::text::trim_right_view(std::basic_string_view<CharT, Traits> str,
+                            const CharT* const s)
+{
+  const typename std::basic_string_view<CharT, Traits>::size_type p(
+      str.find_last_not_of(s));
+
+  if(p != std::basic_string_view<CharT, Traits>::npos)
+    str.remove_suffix(str.size() - p - 1);
+
+  return str;
+}
+
+/**
+ * \brief Get the part of a string without the given characters at its end.
+ * \param str The string to trim. It must outlive the returned view.
+ * \param s The characters to remove.
+ */
+template <typename CharT, typename Traits, typename Alloc>
+std::basic_string_view<CharT, Traits>
+claw::text::trim_right_view(const std::basic_string<CharT, Traits, Alloc>& str,
+                            const CharT* const s)
+{
+  return trim_right_view(std::basic_string_view<CharT, Traits>(str), s);
+}
+
+/**
+ * \brief Get the part of a string without the given characters at its
+ *        begining and at its end.
+ * \param str The string to trim.
+ * \param s The characters to remove.
+ * \return A view in \a str, or \a str itself if it contains only characters
+ *         from \a s, like trim( StringType&, s ).
+ */
+template <typename CharT, typename Traits>
+std::basic_string_view<CharT, Traits>
+claw::text::trim_view(std::basic_string_view<CharT, Traits> str,
+                      const CharT* const s)
+{
+  return trim_right_view(trim_left_view(str, s), s);
+}
+
+/**
+ * \brief Get the part of a string without the given characters at its
+ *        begining and at its end.
+ * \param str The string to trim. It must outlive the returned view.
+ * \param s The characters to remove.
+ */
+template <typename CharT, typename Traits, typename Alloc>
+std::basic_string_view<CharT, Traits>
+claw::text::trim_view(const std::basic_string<CharT, Traits, Alloc>& str,
+                      const CharT* const s)
+{
+  return trim_view(std::basic_string_view<CharT, Traits>(str), s);
+}
+
+/**
+ * \brief Split a string into several substrings, according to a given
+ *        separator, without copying the substrings.
+ * \param str The string to split.
+ * \param sep The separator on which the string is splitted.
+ *
+ * \b Example :
+ * <tt>
+ * for ( std::string_view field : claw::text::split( line, ',' ) )
+ *   std::cout << field << std::endl;
+ * </tt>
+ */
+template <typename CharT, typename Traits>
+claw::text::split_range<CharT, Traits>
+claw::text::split(std::basic_string_view<CharT, Traits> str, const CharT sep)
+{
+  return split_range<CharT, Traits>(str, sep);
+}
+
+/**
+ * \brief Split a string into several substrings, according to a given
+ *        separator, without copying the substrings.
+ * \param str The string to split. It must outlive the returned range.
+ * \param sep The separator on which the string is splitted.
+ */
+template <typename CharT, typename Traits, typename Alloc>
+claw::text::split_range<CharT, Traits>
+claw::text::split(const std::basic_string<CharT, Traits, Alloc>& str,
+                  const CharT sep)
+{
+  return split(std::basic_string_view<CharT, Traits>(str), sep);
+}
+
+#endif
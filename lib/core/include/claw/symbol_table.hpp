@@ -0,0 +1,100 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file symbol_table.hpp
+ * \brief A table giving the index of the symbols of an alphabet.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_SYMBOL_TABLE_HPP__
+#define __CLAW_SYMBOL_TABLE_HPP__
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A table giving the index of the symbols of an alphabet, used to
+   *        find the column of a symbol in the transition table of an
+   *        automaton.
+   *
+   * The symbols are numbered in increasing order, from zero. The values not
+   * in the alphabet all have the index size(). When the symbols are bytes,
+   * the index is found with a direct lookup in a table of 256 entries,
+   * otherwise it is found with a binary search in the alphabet.
+   *
+   * \b Template \b parameters
+   * - \a T The type of the symbols.
+   * - \a Compare The type of the operator used to compare the symbols.
+   *
+   * \author Julien Jorge
+   */
+  template <class T, class Compare = std::less<T> >
+  class symbol_table
+  {
+  public:
+    /** \brief The type of the symbols. */
+    typedef T value_type;
+
+    /** \brief The type of the operator used to compare the symbols. */
+    typedef Compare value_compare;
+
+  private:
+    /** \brief Tell if the symbols are bytes, for which the index is found
+        with a direct lookup. */
+    typedef std::integral_constant<bool, std::is_integral<T>::value
+                                             && (sizeof(T) == 1)>
+        is_byte;
+
+  public:
+    symbol_table();
+    explicit symbol_table(const std::vector<value_type>& symbols);
+
+    std::size_t size() const;
+    std::size_t find(const value_type& v) const;
+
+  private:
+    std::size_t find(const value_type& v, std::true_type) const;
+    std::size_t find(const value_type& v, std::false_type) const;
+
+    void build_byte_index(std::true_type);
+    void build_byte_index(std::false_type);
+
+  private:
+    /** \brief The symbols of the alphabet, sorted. The index of m_symbols[i]
+        is i. */
+    std::vector<value_type> m_symbols;
+
+    /** \brief The index of each byte, when value_type is a byte type. */
+    std::vector<std::size_t> m_byte_index;
+
+  }; // class symbol_table
+}
+
+#include <claw/symbol_table.tpp>
+
+#endif // __CLAW_SYMBOL_TABLE_HPP__
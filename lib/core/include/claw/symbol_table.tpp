@@ -0,0 +1,123 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file symbol_table.tpp
+ * \brief Implementation of the claw::symbol_table class.
+ * \author Julien Jorge
+ */
+#include <algorithm>
+
+/**
+ * \brief Constructor. The alphabet is empty.
+ */
+template <class T, class Compare>
+claw::symbol_table<T, Compare>::symbol_table()
+{
+  build_byte_index(is_byte());
+}
+
+/**
+ * \brief Constructor.
+ * \param symbols The symbols of the alphabet.
+ * \pre symbols is sorted according to Compare and has no duplicates.
+ */
+template <class T, class Compare>
+claw::symbol_table<T, Compare>::symbol_table(
+    const std::vector<value_type>& symbols)
+  : m_symbols(symbols)
+{
+  build_byte_index(is_byte());
+}
+
+/**
+ * \brief Get the number of symbols in the alphabet.
+ */
+template <class T, class Compare>
+std::size_t claw::symbol_table<T, Compare>::size() const
+{
+  return m_symbols.size();
+}
+
+/**
+ * \brief Get the index of a value in the alphabet, or size() if the value is
+ *        not in the alphabet.
+ * \param v The value.
+ */
+template <class T, class Compare>
+std::size_t claw::symbol_table<T, Compare>::find(const value_type& v) const
+{
+  return find(v, is_byte());
+}
+
+/**
+ * \brief Get the index of a byte in the alphabet.
+ * \param v The value.
+ */
+template <class T, class Compare>
+std::size_t claw::symbol_table<T, Compare>::find(const value_type& v,
+                                                 std::true_type) const
+{
+  return m_byte_index[static_cast<unsigned char>(v)];
+}
+
+/**
+ * \brief Get the index of a value in the alphabet, with a binary search.
+ * \param v The value.
+ */
+template <class T, class Compare>
+std::size_t claw::symbol_table<T, Compare>::find(const value_type& v,
+                                                 std::false_type) const
+{
+  const value_compare comp;
+  const typename std::vector<value_type>::const_iterator it(
+      std::lower_bound(m_symbols.begin(), m_symbols.end(), v, comp));
+
+  if((it == m_symbols.end()) || comp(v, *it))
+    return m_symbols.size();
+  else
+    return it - m_symbols.begin();
+}
+
+/**
+ * \brief Fill the lookup table giving the index of each byte.
+ */
+template <class T, class Compare>
+void claw::symbol_table<T, Compare>::build_byte_index(std::true_type)
+{
+  m_byte_index.resize(256);
+
+  for(std::size_t i = 0; i != m_byte_index.size(); ++i)
+    m_byte_index[i] = find(static_cast<value_type>(i), std::false_type());
+}
+
+/**
+ * \brief Fill the lookup table giving the index of each byte. This one is
+ *        for the types which are not bytes, thus it does nothing.
+ */
+template <class T, class Compare>
+void claw::symbol_table<T, Compare>::build_byte_index(std::false_type)
+{
+  // nothing to do
+}
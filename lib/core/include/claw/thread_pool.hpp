@@ -0,0 +1,96 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file thread_pool.hpp
+ * \brief A fixed set of threads running tasks.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_THREAD_POOL_HPP__
+#define __CLAW_THREAD_POOL_HPP__
+
+#include <claw/non_copyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace claw
+{
+  /**
+   * \brief A fixed set of threads running tasks.
+   *
+   * The tasks are run in the order in which they are pushed. The end of a task
+   * is reported through the std::future returned by push(), which also
+   * carries the exception thrown by the task, if any.
+   *
+   * The threads are joined by the destructor, after all the pending tasks
+   * have been run.
+   *
+   * \author Julien Jorge
+   */
+  class thread_pool : public pattern::non_copyable
+  {
+  public:
+    /** \brief The type of the tasks run by the threads. */
+    typedef std::function<void()> task_type;
+
+  public:
+    inline explicit thread_pool(unsigned int thread_count = 0);
+    inline ~thread_pool();
+
+    inline unsigned int size() const;
+
+    inline std::future<void> push(const task_type& task);
+
+  private:
+    inline void run();
+    inline void stop();
+
+  private:
+    /** \brief The threads running the tasks. */
+    std::vector<std::thread> m_threads;
+
+    /** \brief The tasks not started yet. */
+    std::deque<std::packaged_task<void()> > m_tasks;
+
+    /** \brief The mutex protecting m_tasks and m_stop. */
+    std::mutex m_mutex;
+
+    /** \brief Signaled when a task is pushed or when the pool is stopped. */
+    std::condition_variable m_condition;
+
+    /** \brief Tell if the threads must stop once there is no more tasks. */
+    bool m_stop;
+
+  }; // class thread_pool
+}
+
+#include <claw/thread_pool.ipp>
+
+#endif // __CLAW_THREAD_POOL_HPP__
@@ -0,0 +1,139 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file thread_pool.ipp
+ * \brief Implementation of the claw::thread_pool class.
+ * \author Julien Jorge
+ */
+
+/**
+ * \brief Constructor.
+ * \param thread_count The number of threads to create. If zero, the number of
+ *        threads supported by the hardware is used.
+ */
+inline claw::thread_pool::thread_pool(unsigned int thread_count)
+  : m_stop(false)
+{
+  if(thread_count == 0)
+    thread_count = std::thread::hardware_concurrency();
+
+  if(thread_count == 0)
+    thread_count = 1;
+
+  m_threads.reserve(thread_count);
+
+  try
+    {
+      for(unsigned int i = 0; i != thread_count; ++i)
+        m_threads.push_back(std::thread(&thread_pool::run, this));
+    }
+  catch(...)
+    {
+      // The destructor will not be called, the threads created so far must
+      // be joined here.
+      stop();
+      throw;
+    }
+}
+
+/**
+ * \brief Destructor. Runs the pending tasks then joins the threads.
+ */
+inline claw::thread_pool::~thread_pool()
+{
+  stop();
+}
+
+/**
+ * \brief Get the number of threads in the pool.
+ */
+inline unsigned int claw::thread_pool::size() const
+{
+  return m_threads.size();
+}
+
+/**
+ * \brief Add a task to run.
+ * \param task The task to run.
+ * \return A future becoming ready when the task is done.
+ */
+inline std::future<void> claw::thread_pool::push(const task_type& task)
+{
+  std::packaged_task<void()> t(task);
+  std::future<void> result(t.get_future());
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(t));
+  }
+
+  m_condition.notify_one();
+
+  return result;
+}
+
+/**
+ * \brief The loop of the threads: pick the tasks and run them until the pool
+ *        is stopped.
+ */
+inline void claw::thread_pool::run()
+{
+  while(true)
+    {
+      std::packaged_task<void()> task;
+
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while(!m_stop && m_tasks.empty())
+          m_condition.wait(lock);
+
+        if(m_tasks.empty())
+          return;
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+
+      task();
+    }
+}
+
+/**
+ * \brief Tell the threads to stop once the pending tasks are done, and join
+ *        them.
+ */
+inline void claw::thread_pool::stop()
+{
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  m_condition.notify_all();
+
+  for(std::size_t i = 0; i != m_threads.size(); ++i)
+    m_threads[i].join();
+}
@@ -0,0 +1,131 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file batch_loader.hpp
+ * \brief Load many images at once, concurrently on a thread pool.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_BATCH_LOADER_HPP__
+#define __CLAW_BATCH_LOADER_HPP__
+
+#include <claw/graphic/format_registry.hpp>
+#include <claw/graphic/image.hpp>
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace claw
+{
+  class thread_pool;
+
+  namespace graphic
+  {
+    /**
+     * \brief Load many images at once, concurrently on a thread pool.
+     *
+     * The images are loaded with the readers of a format_registry and are
+     * returned in the order of their sources. A source that can't be loaded
+     * does not stop the loading of the other ones: its error is reported in
+     * its item of the result.
+     *
+     * \author Julien Jorge
+     */
+    class batch_loader
+    {
+    public:
+      /**
+       * \brief The result of the loading of a source.
+       */
+      struct item
+      {
+        /** \brief The loaded image, empty if the loading failed. */
+        image picture;
+
+        /** \brief Tell if the image has been loaded. */
+        bool loaded;
+
+        /** \brief The reason of the failure, if the image has not been
+            loaded. */
+        std::string error;
+
+      }; // struct item
+
+      /**
+       * \brief The measures of the loading of a batch.
+       */
+      struct statistics
+      {
+        /** \brief The number of loaded images. */
+        std::size_t loaded_count;
+
+        /** \brief The number of sources that could not be loaded. */
+        std::size_t failed_count;
+
+        /** \brief The number of pixels in the loaded images. */
+        std::size_t pixel_count;
+
+        /** \brief The time spent loading the batch, in seconds. */
+        double duration;
+
+        double images_per_second() const;
+        double pixels_per_second() const;
+
+      }; // struct statistics
+
+    public:
+      explicit batch_loader(
+          const format_registry& formats = format_registry::get_default());
+
+      statistics load(const std::vector<std::string>& paths,
+                      std::vector<item>& result) const;
+      statistics load(const std::vector<std::string>& paths,
+                      std::vector<item>& result, thread_pool& pool) const;
+
+      statistics load(const std::vector<std::istream*>& streams,
+                      std::vector<item>& result) const;
+      statistics load(const std::vector<std::istream*>& streams,
+                      std::vector<item>& result, thread_pool& pool) const;
+
+    private:
+      template <typename Source>
+      statistics load_all(const std::vector<Source>& sources,
+                          std::vector<item>& result, thread_pool* pool) const;
+
+      void load_item(const std::string& path, std::vector<char>& buffer,
+                     item& result) const;
+      void load_item(std::istream* f, std::vector<char>& buffer,
+                     item& result) const;
+
+    private:
+      /** \brief The formats of the images. */
+      const format_registry& m_formats;
+
+    }; // class batch_loader
+  }
+}
+
+#endif // __CLAW_BATCH_LOADER_HPP__
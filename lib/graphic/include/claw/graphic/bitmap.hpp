@@ -178,14 +178,12 @@ namespace claw
         }; // class rle_bitmap_output_buffer
 
         /**
-         * \brief RLE decoder for bitmap RLE format
+         * \brief Policy of claw::rle_decoder reading the header of the
+         *        packets of the bitmap RLE format.
          *
-         * \b Template \b parameters :
-         * - \a OutputBuffer The type of the output buffer.
-         *
-         * The \a OutputBuffer type must match the type requirements of the
-         * template parameter OutputBuffer of the rle_decoder class, plus two
-         * methods :
+         * The output buffer given to read_mode() must match the type
+         * requirements of the template parameter OutputBuffer of the
+         * rle_decoder class, plus two methods :
          * - next_line(), set the output position at the begining of the next
          *                line.
          * - delta_move( unsigned char x, unsigned char y ), move the output
@@ -193,25 +191,25 @@ namespace claw
          *
          * \author Julien Jorge
          */
-        template <typename OutputBuffer>
-        class rle_bitmap_decoder
-          : public rle_decoder<char, file_input_buffer, OutputBuffer>
+        class rle_bitmap_mode_reader
         {
         public:
-          /** \brief Type of the output buffer. */
-          typedef OutputBuffer output_buffer_type;
+          template <typename OutputBuffer>
+          void read_mode(file_input_buffer& input, OutputBuffer& output,
+                         rle_packet<char>& packet) const;
 
-        private:
-          virtual void read_mode(file_input_buffer& input,
-                                 output_buffer_type& output);
-        }; // class rle_bitmap_decoder
+        }; // class rle_bitmap_mode_reader
 
         /** \brief RLE decoder for 4 bpp bitmap images. */
-        typedef rle_bitmap_decoder<rle_bitmap_output_buffer<true> >
+        typedef rle_decoder<char, file_input_buffer,
+                            rle_bitmap_output_buffer<true>,
+                            rle_bitmap_mode_reader>
             rle4_decoder;
 
         /** \brief RLE decoder for 8 bpp bitmap images. */
-        typedef rle_bitmap_decoder<rle_bitmap_output_buffer<false> >
+        typedef rle_decoder<char, file_input_buffer,
+                            rle_bitmap_output_buffer<false>,
+                            rle_bitmap_mode_reader>
             rle8_decoder;
 
         /**
@@ -256,7 +254,9 @@ namespace claw
 
       public:
         reader(image& img);
+        reader(image& img, std::vector<char>& buffer);
         reader(image& img, std::istream& f);
+        reader(image& img, std::istream& f, std::vector<char>& buffer);
 
         void load(std::istream& f);
 
@@ -287,6 +287,13 @@ namespace claw
         /** \brief The image in which we store the data we read. */
         image& m_image;
 
+        /** \brief The storage of the input buffers when not provided by the
+            caller. */
+        std::vector<char> m_own_buffer;
+
+        /** \brief The storage of the input buffers. */
+        std::vector<char>& m_buffer;
+
       }; // class reader
 
       /**
@@ -296,21 +303,19 @@ namespace claw
       class writer : private file_structure
       {
       public:
-        writer(const image& img);
-        writer(const image& img, std::ostream& f);
+        writer(const const_image_view& img);
+        writer(const const_image_view& img, std::ostream& f);
 
         void save(std::ostream& f) const;
 
       private:
         void save_data(std::ostream& f) const;
 
-        void pixel32_to_pixel24(char* dest, const scanline& src) const;
-
         void init_header(header& h) const;
 
       private:
         /** \brief The image from which we read the data. */
-        const image& m_image;
+        const_image_view m_image;
 
       }; // class writer
 
@@ -82,13 +82,14 @@ void claw::graphic::bitmap::reader::rle_bitmap_output_buffer<
  *        apply the special codes.
  * \param input The input stream (the bitmap file).
  * \param output The output stream (the bitmap image).
+ * \param packet (out) The header of the next packet.
  */
 template <typename OutputBuffer>
-void claw::graphic::bitmap::reader::rle_bitmap_decoder<
-    OutputBuffer>::read_mode(file_input_buffer& input,
-                             output_buffer_type& output)
+void claw::graphic::bitmap::reader::rle_bitmap_mode_reader::read_mode(
+    file_input_buffer& input, OutputBuffer& output,
+    rle_packet<char>& packet) const
 {
-  this->m_mode = this->stop;
+  packet.mode = packet.stop;
   bool ok = true;
 
   if(input.remaining() < 2)
@@ -104,9 +105,9 @@ void claw::graphic::bitmap::reader::rle_bitmap_decoder<
       // compressed data, next byte is the pattern
       if(key > 0)
         {
-          this->m_mode = this->compressed;
-          this->m_count = key;
-          this->m_pattern = pattern;
+          packet.mode = packet.compressed;
+          packet.count = key;
+          packet.pattern = pattern;
         }
       else
         switch(pattern)
@@ -114,11 +115,11 @@ void claw::graphic::bitmap::reader::rle_bitmap_decoder<
             // end of line
           case 0:
             output.next_line();
-            read_mode(input, output);
+            read_mode(input, output, packet);
             break;
             // end of file
           case 1:
-            this->m_mode = this->stop;
+            packet.mode = packet.stop;
             break;
             // delta move
           case 2:
@@ -132,14 +133,14 @@ void claw::graphic::bitmap::reader::rle_bitmap_decoder<
                   x = pattern;
                   y = input.get_next();
                   output.delta_move(x, y);
-                  read_mode(input, output);
+                  read_mode(input, output, packet);
                   break;
                 }
             }
             // raw data
           default:
-            this->m_mode = this->raw;
-            this->m_count = pattern;
+            packet.mode = packet.raw;
+            packet.count = pattern;
             break;
           }
     }
@@ -169,7 +170,10 @@ void claw::graphic::bitmap::reader::load_rgb_data(
   if(buffer_size % 4 != 0)
     buffer_size += 4 - buffer_size % 4;
 
-  char* buffer = new char[buffer_size];
+  if(m_buffer.size() < buffer_size)
+    m_buffer.resize(buffer_size);
+
+  char* buffer = &m_buffer[0];
 
   for(line = m_image.height(); (line > 0) && !f.eof();)
     {
@@ -178,8 +182,6 @@ void claw::graphic::bitmap::reader::load_rgb_data(
       pixel_convert(m_image[line], buffer, palette);
     }
 
-  delete[] buffer;
-
   if(f.rdstate() != std::ios_base::goodbit)
     throw claw::bad_format("bitmap::reader::load_data");
 }
@@ -0,0 +1,119 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file format_registry.hpp
+ * \brief The formats of the image files, detected from their first bytes.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_FORMAT_REGISTRY_HPP__
+#define __CLAW_FORMAT_REGISTRY_HPP__
+
+#include <claw/graphic/image.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace claw
+{
+  namespace graphic
+  {
+    /**
+     * \brief The formats of the image files, detected from their first
+     *        bytes.
+     *
+     * Each format is registered with the signatures found at the beginning
+     * of its files and a function reading such a file. An image is loaded by
+     * the readers of the formats whose signature matches the first bytes of
+     * the stream, then, if none of them succeeded, by the readers of the
+     * formats having no signature, in the order of their registration.
+     *
+     * The formats must be registered before the images are loaded, the
+     * registry being read concurrently without any lock.
+     *
+     * \author Julien Jorge
+     */
+    class format_registry
+    {
+    public:
+      /** \brief The type of the functions reading an image from a
+          stream. The last argument is a storage that the function can use
+          to buffer the stream, kept by the caller for the next images. */
+      typedef std::function<void(image&, std::istream&, std::vector<char>&)>
+          reader_function;
+
+    private:
+      /**
+       * \brief A format of the image files.
+       */
+      struct format
+      {
+        /** \brief The name of the format. */
+        std::string name;
+
+        /** \brief The first bytes of the files of this format, any of them
+            identifying the format. */
+        std::vector<std::string> signatures;
+
+        /** \brief The function reading the files of this format. */
+        reader_function read;
+
+      }; // struct format
+
+    public:
+      format_registry();
+
+      void add_format(const std::string& name,
+                      const std::vector<std::string>& signatures,
+                      const reader_function& read);
+      void add_format(const std::string& name, const reader_function& read);
+
+      std::string detect(std::istream& f) const;
+      void load(image& img, std::istream& f) const;
+      void load(image& img, std::istream& f, std::vector<char>& buffer) const;
+
+      static format_registry& get_default();
+
+    private:
+      std::string read_header(std::istream& f) const;
+      bool matches(const format& fmt, const std::string& header) const;
+      bool try_read(const format& fmt, image& img, std::istream& f,
+                    std::vector<char>& buffer) const;
+
+    private:
+      /** \brief The registered formats, in the order of their
+          registration. */
+      std::vector<format> m_formats;
+
+      /** \brief The length of the longest signature. */
+      std::size_t m_header_length;
+
+    }; // class format_registry
+  }
+}
+
+#endif // __CLAW_FORMAT_REGISTRY_HPP__
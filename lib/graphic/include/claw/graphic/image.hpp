@@ -37,64 +37,103 @@
 #include <cstddef>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 namespace claw
 {
+  class thread_pool;
+
   namespace graphic
   {
+    template <typename Pixel>
+    class basic_image_view;
+
+    /** \brief A view on modifiable pixels of an image. */
+    typedef basic_image_view<rgba_pixel> image_view;
+
+    /** \brief A view on constant pixels of an image. */
+    typedef basic_image_view<const rgba_pixel> const_image_view;
+
     /**
      * \brief A class to deal with images.
+     *
+     * The pixels are stored in a single block of memory, line after line from
+     * the top of the image, the first pixel being aligned on
+     * image::alignment bytes. The pixel (x, y) is at data()[y * stride() + x].
+     *
+     * The operations processing the lines independently can be given a
+     * claw::thread_pool to process bands of lines concurrently. The result is
+     * the same as without the pool.
+     *
+     * A rectangle of an image can be processed in place, without copying its
+     * pixels, through an image_view. The images convert implicitly to views
+     * on all their pixels.
+     *
      * \author Julien Jorge
      */
     class image
     {
     public:
+      /** \brief The alignment, in bytes, of the first pixel of the image. */
+      static const std::size_t alignment = 64;
+
       /** \brief The type representing the colors of the pixels in the image.
        */
       typedef rgba_pixel pixel_type;
 
       /**
        * \brief One line in the image.
+       *
+       * The line does not own its pixels: they are a range in the buffer of
+       * the image, valid until the size of the image changes.
+       *
        * \author Julien Jorge
        */
-      class scanline : private std::vector<pixel_type>
+      class scanline
       {
         friend class image;
 
       public:
-        /** \brief The type of the parent class. */
-        typedef std::vector<pixel_type> super;
-
         /** \brief The type of the pixels. */
-        typedef super::value_type value_type;
+        typedef pixel_type value_type;
 
         /** \brief Reference to a pixel.. */
-        typedef super::reference reference;
+        typedef pixel_type& reference;
 
         /** \brief Const reference to a pixel. */
-        typedef super::const_reference const_reference;
+        typedef const pixel_type& const_reference;
 
         /** \brief Iterator in the line. */
-        typedef super::iterator iterator;
+        typedef pixel_type* iterator;
 
         /** \brief Const iterator in the line. */
-        typedef super::const_iterator const_iterator;
+        typedef const pixel_type* const_iterator;
 
         /** \brief An unsigned integral type. */
-        typedef super::size_type size_type;
+        typedef std::size_t size_type;
+
+      private:
+        inline scanline(pixel_type* first, size_type size);
 
       public:
-        iterator begin();
-        iterator end();
+        inline iterator begin();
+        inline iterator end();
 
-        const_iterator begin() const;
-        const_iterator end() const;
+        inline const_iterator begin() const;
+        inline const_iterator end() const;
 
         inline reference operator[](unsigned int i);
         inline const_reference operator[](unsigned int i) const;
 
-        size_type size() const;
+        inline size_type size() const;
+
+      private:
+        /** \brief The first pixel of the line. */
+        pixel_type* m_first;
+
+        /** \brief The number of pixels in the line. */
+        size_type m_size;
 
       }; // class scanline
 
@@ -206,12 +245,20 @@ namespace claw
       image();
       image(unsigned int w, unsigned int h);
       image(std::istream& f);
+      image(const image& that);
+      image(image&& that);
+
+      image& operator=(image that);
 
       void swap(image& that);
 
       unsigned int width() const;
       unsigned int height() const;
 
+      inline pixel_type* data();
+      inline const pixel_type* data() const;
+      inline unsigned int stride() const;
+
       inline scanline& operator[](unsigned int i);
       inline const scanline& operator[](unsigned int i) const;
 
@@ -220,22 +267,47 @@ namespace claw
       const_iterator begin() const;
       const_iterator end() const;
 
-      void merge(const image& that);
-      void merge(const image& that, const math::coordinate_2d<int>& pos);
+      void merge(const const_image_view& that);
+      void merge(const const_image_view& that,
+                 const math::coordinate_2d<int>& pos);
+      void merge(const const_image_view& that,
+                 const math::coordinate_2d<int>& pos, thread_pool& pool);
 
-      void partial_copy(const image& that,
+      void partial_copy(const const_image_view& that,
                         const math::coordinate_2d<int>& pos);
+      void partial_copy(const const_image_view& that,
+                        const math::coordinate_2d<int>& pos,
+                        thread_pool& pool);
 
       void flip();
       void fill(const math::rectangle<int> r, const pixel_type& c);
+      void fill(const math::rectangle<int> r, const pixel_type& c,
+                thread_pool& pool);
 
       void set_size(unsigned int w, unsigned int h);
 
       void load(std::istream& f);
+      void load(const char* data, std::size_t size);
 
     private:
-      /** \brief Data of the picture. */
-      std::vector<scanline> m_data;
+      void allocate(unsigned int w, unsigned int h);
+
+    private:
+      /** \brief The memory containing the pixels, with some room to align
+          them. */
+      std::unique_ptr<char[]> m_memory;
+
+      /** \brief The first pixel of the image, in m_memory. */
+      pixel_type* m_pixels;
+
+      /** \brief The width of the image. */
+      unsigned int m_width;
+
+      /** \brief The height of the image. */
+      unsigned int m_height;
+
+      /** \brief The lines of the image, pointing in m_pixels. */
+      std::vector<scanline> m_lines;
 
     }; // class image
 
@@ -249,5 +321,6 @@ namespace std
 
 // Inline methods
 #include <claw/graphic/image.ipp>
+#include <claw/graphic/image_view.hpp>
 
 #endif // __CLAW_IMAGE_HPP__
@@ -29,6 +29,59 @@
  */
 #include <claw/assert.hpp>
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Constructor.
+ * \param first The first pixel of the line.
+ * \param size The number of pixels in the line.
+ */
+inline claw::graphic::image::scanline::scanline
+( pixel_type* first, size_type size )
+  : m_first(first), m_size(size)
+{
+
+} // image::scanline::scanline()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator on the first pixel.
+ */
+inline claw::graphic::image::scanline::iterator
+claw::graphic::image::scanline::begin()
+{
+  return m_first;
+} // image::scanline::begin()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get en iterator past the last pixel.
+ */
+inline claw::graphic::image::scanline::iterator
+claw::graphic::image::scanline::end()
+{
+  return m_first + m_size;
+} // image::scanline::end()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator on constant data on the first pixel.
+ */
+inline claw::graphic::image::scanline::const_iterator
+claw::graphic::image::scanline::begin() const
+{
+  return m_first;
+} // image::scanline::begin() [const]
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get an iterator on constant data past the last pixel.
+ */
+inline claw::graphic::image::scanline::const_iterator
+claw::graphic::image::scanline::end() const
+{
+  return m_first + m_size;
+} // image::scanline::end() [const]
+
 /*----------------------------------------------------------------------------*/
 /**
  * \brief Get a pixel from the line.
@@ -37,7 +90,9 @@
 claw::graphic::image::scanline::reference
 inline claw::graphic::image::scanline::operator[](unsigned int i)
 {
-  return super::operator[](i);
+  CLAW_PRECOND( i < m_size );
+
+  return m_first[i];
 } // image::scanline::operator[]()
 
 /*----------------------------------------------------------------------------*/
@@ -48,9 +103,21 @@ inline claw::graphic::image::scanline::operator[](unsigned int i)
 claw::graphic::image::scanline::const_reference
 inline claw::graphic::image::scanline::operator[](unsigned int i) const
 {
-  return super::operator[](i);
+  CLAW_PRECOND( i < m_size );
+
+  return m_first[i];
 } // image::scanline::operator[]()
 
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the length of the line.
+ */
+inline claw::graphic::image::scanline::size_type
+claw::graphic::image::scanline::size() const
+{
+  return m_size;
+} // image::scanline::size()
+
 
 
 
@@ -428,7 +495,7 @@ claw::graphic::image::base_iterator<Image, Pixel>::is_final() const
 inline claw::graphic::image::scanline&
 claw::graphic::image::operator[](unsigned int i)
 {
-  return m_data[i];
+  return m_lines[i];
 } // image::operator[]()
 
 /*----------------------------------------------------------------------------*/
@@ -438,5 +505,36 @@ claw::graphic::image::operator[](unsigned int i)
 inline const claw::graphic::image::scanline&
 claw::graphic::image::operator[](unsigned int i) const
 {
-  return m_data[i];
+  return m_lines[i];
 } // image::operator[]() [const]
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the first pixel of the image, the other ones following line
+ *        after line.
+ */
+inline claw::graphic::image::pixel_type* claw::graphic::image::data()
+{
+  return m_pixels;
+} // image::data()
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the first pixel of the image, the other ones following line
+ *        after line.
+ */
+inline const claw::graphic::image::pixel_type*
+claw::graphic::image::data() const
+{
+  return m_pixels;
+} // image::data() [const]
+
+/*----------------------------------------------------------------------------*/
+/**
+ * \brief Get the number of pixels from the beginning of a line to the
+ *        beginning of the next one.
+ */
+inline unsigned int claw::graphic::image::stride() const
+{
+  return m_width;
+} // image::stride()
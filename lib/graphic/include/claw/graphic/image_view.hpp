@@ -0,0 +1,143 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file image_view.hpp
+ * \brief A rectangle of pixels in the memory of an image, without owning
+ *        them.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_IMAGE_VIEW_HPP__
+#define __CLAW_IMAGE_VIEW_HPP__
+
+#include <claw/graphic/image.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace claw
+{
+  namespace graphic
+  {
+    /**
+     * \brief A rectangle of pixels in the memory of an image, without owning
+     *        them.
+     *
+     * A view is a pointer on its first pixel, its size and the distance
+     * between its lines. It is cheap to copy and lets a region of an image be
+     * processed in place, for example a tile being composed or saved, without
+     * copying its pixels in a new image. The view is valid as long as the
+     * pixels it references are not reallocated.
+     *
+     * Like a pointer, a constant view can modify its pixels; the constness of
+     * the pixels is given by the template parameter. A view on modifiable
+     * pixels converts implicitly to a view on constant pixels.
+     *
+     * \b Template \b parameters:
+     * - \a Pixel The type of the pixels, either rgba_pixel or
+     *   const rgba_pixel.
+     *
+     * \author Julien Jorge
+     */
+    template <typename Pixel>
+    class basic_image_view
+    {
+    public:
+      /** \brief The type of the pixels. */
+      typedef Pixel pixel_type;
+
+      /** \brief The type of the images on which the view can be created. */
+      typedef typename std::conditional<std::is_const<Pixel>::value,
+                                        const image, image>::type image_type;
+
+      /** \brief The type of the views on the constant pixels. */
+      typedef basic_image_view<const typename std::remove_const<Pixel>::type>
+          const_view_type;
+
+    public:
+      basic_image_view();
+      basic_image_view(pixel_type* data, unsigned int w, unsigned int h,
+                       unsigned int stride);
+      basic_image_view(image_type& img);
+      basic_image_view(image_type& img, const math::rectangle<int>& r);
+
+      template <typename P>
+      basic_image_view(const basic_image_view<P>& that);
+
+      basic_image_view sub_view(const math::rectangle<int>& r) const;
+
+      unsigned int width() const;
+      unsigned int height() const;
+      unsigned int stride() const;
+      bool empty() const;
+
+      pixel_type* data() const;
+      pixel_type* operator[](unsigned int y) const;
+
+      void merge(const const_view_type& that,
+                 const math::coordinate_2d<int>& pos) const;
+      void merge(const const_view_type& that,
+                 const math::coordinate_2d<int>& pos, thread_pool& pool) const;
+
+      void partial_copy(const const_view_type& that,
+                        const math::coordinate_2d<int>& pos) const;
+      void partial_copy(const const_view_type& that,
+                        const math::coordinate_2d<int>& pos,
+                        thread_pool& pool) const;
+
+      void fill(const math::rectangle<int>& r, const rgba_pixel& c) const;
+      void fill(const math::rectangle<int>& r, const rgba_pixel& c,
+                thread_pool& pool) const;
+
+    private:
+      void merge_bands(const const_view_type& that,
+                       const math::coordinate_2d<int>& pos,
+                       thread_pool* pool) const;
+      void partial_copy_bands(const const_view_type& that,
+                              const math::coordinate_2d<int>& pos,
+                              thread_pool* pool) const;
+      void fill_bands(const math::rectangle<int>& r, const rgba_pixel& c,
+                      thread_pool* pool) const;
+
+    private:
+      /** \brief The first pixel of the view. */
+      pixel_type* m_data;
+
+      /** \brief The number of pixels in a line of the view. */
+      unsigned int m_width;
+
+      /** \brief The number of lines in the view. */
+      unsigned int m_height;
+
+      /** \brief The number of pixels from the beginning of a line to the
+          beginning of the next one. */
+      unsigned int m_stride;
+
+    }; // class basic_image_view
+  }
+}
+
+#include <claw/graphic/image_view.tpp>
+
+#endif // __CLAW_IMAGE_VIEW_HPP__
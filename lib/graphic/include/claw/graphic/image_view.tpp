@@ -0,0 +1,404 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file image_view.tpp
+ * \brief Implementation of the claw::graphic::basic_image_view class.
+ * \author Julien Jorge
+ */
+#include <claw/assert.hpp>
+#include <claw/parallel_for.hpp>
+#include <claw/graphic/pixel_kernels.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace claw
+{
+  namespace graphic
+  {
+    namespace detail
+    {
+      /**
+       * \brief Get the minimum number of lines in a band processed by a
+       *        task, such that the band is large enough to be worth the task.
+       * \param width The number of pixels in a line.
+       */
+      inline std::size_t min_band_height(unsigned int width)
+      {
+        const std::size_t min_pixels_per_band = 1 << 16;
+
+        return min_pixels_per_band / std::max(width, 1u);
+      }
+    }
+  }
+}
+
+/**
+ * \brief Constructor. Creates a view without pixels.
+ * \post width() == height() == 0
+ */
+template <typename Pixel>
+claw::graphic::basic_image_view<Pixel>::basic_image_view()
+  : m_data(NULL)
+  , m_width(0)
+  , m_height(0)
+  , m_stride(0)
+{}
+
+/**
+ * \brief Constructor. Creates a view on pixels stored line after line.
+ * \param data The first pixel of the view.
+ * \param w The number of pixels in a line.
+ * \param h The number of lines.
+ * \param stride The number of pixels from the beginning of a line to the
+ *        beginning of the next one.
+ * \pre stride >= w
+ */
+template <typename Pixel>
+claw::graphic::basic_image_view<Pixel>::basic_image_view(pixel_type* data,
+                                                         unsigned int w,
+                                                         unsigned int h,
+                                                         unsigned int stride)
+  : m_data(data)
+  , m_width(w)
+  , m_height(h)
+  , m_stride(stride)
+{
+  CLAW_PRECOND(stride >= w);
+}
+
+/**
+ * \brief Constructor. Creates a view on all the pixels of an image.
+ * \param img The image whose pixels are viewed.
+ */
+template <typename Pixel>
+claw::graphic::basic_image_view<Pixel>::basic_image_view(image_type& img)
+  : m_data(img.data())
+  , m_width(img.width())
+  , m_height(img.height())
+  , m_stride(img.stride())
+{}
+
+/**
+ * \brief Constructor. Creates a view on a rectangle of an image.
+ * \param img The image whose pixels are viewed.
+ * \param r The rectangle to view. It is clipped to the image.
+ */
+template <typename Pixel>
+claw::graphic::basic_image_view<Pixel>::basic_image_view(
+    image_type& img, const math::rectangle<int>& r)
+  : basic_image_view(basic_image_view(img).sub_view(r))
+{}
+
+/**
+ * \brief Conversion from a view on modifiable pixels to a view on constant
+ *        pixels.
+ * \param that The view to convert.
+ */
+template <typename Pixel>
+template <typename P>
+claw::graphic::basic_image_view<Pixel>::basic_image_view(
+    const basic_image_view<P>& that)
+  : m_data(that.data())
+  , m_width(that.width())
+  , m_height(that.height())
+  , m_stride(that.stride())
+{}
+
+/**
+ * \brief Get a view on a rectangle of this view.
+ * \param r The rectangle to view, relative to this view. It is clipped to this
+ *        view, the result being empty if they do not intersect.
+ */
+template <typename Pixel>
+claw::graphic::basic_image_view<Pixel>
+claw::graphic::basic_image_view<Pixel>::sub_view(
+    const math::rectangle<int>& r) const
+{
+  const long left = std::max<long>(r.position.x, 0);
+  const long top = std::max<long>(r.position.y, 0);
+  const long right = std::min<long>((long)r.position.x + r.width, m_width);
+  const long bottom = std::min<long>((long)r.position.y + r.height, m_height);
+
+  if((left >= right) || (top >= bottom))
+    return basic_image_view();
+  else
+    return basic_image_view(m_data + top * (std::size_t)m_stride + left,
+                            right - left, bottom - top, m_stride);
+}
+
+/**
+ * \brief Get the number of pixels in a line of the view.
+ */
+template <typename Pixel>
+unsigned int claw::graphic::basic_image_view<Pixel>::width() const
+{
+  return m_width;
+}
+
+/**
+ * \brief Get the number of lines in the view.
+ */
+template <typename Pixel>
+unsigned int claw::graphic::basic_image_view<Pixel>::height() const
+{
+  return m_height;
+}
+
+/**
+ * \brief Get the number of pixels from the beginning of a line to the
+ *        beginning of the next one.
+ */
+template <typename Pixel>
+unsigned int claw::graphic::basic_image_view<Pixel>::stride() const
+{
+  return m_stride;
+}
+
+/**
+ * \brief Tell if the view has no pixels.
+ */
+template <typename Pixel>
+bool claw::graphic::basic_image_view<Pixel>::empty() const
+{
+  return (m_width == 0) || (m_height == 0);
+}
+
+/**
+ * \brief Get the first pixel of the view. The pixel (x, y) is at
+ *        data()[y * stride() + x].
+ */
+template <typename Pixel>
+typename claw::graphic::basic_image_view<Pixel>::pixel_type*
+claw::graphic::basic_image_view<Pixel>::data() const
+{
+  return m_data;
+}
+
+/**
+ * \brief Get the first pixel of a line of the view.
+ * \param y The index of the line.
+ * \pre y < height()
+ */
+template <typename Pixel>
+typename claw::graphic::basic_image_view<Pixel>::pixel_type*
+claw::graphic::basic_image_view<Pixel>::operator[](unsigned int y) const
+{
+  CLAW_PRECOND(y < m_height);
+  return m_data + (std::size_t)y * m_stride;
+}
+
+/**
+ * \brief Merge some pixels on the pixels of the view.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner of \a that in the view.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::merge(
+    const const_view_type& that, const math::coordinate_2d<int>& pos) const
+{
+  merge_bands(that, pos, NULL);
+}
+
+/**
+ * \brief Merge some pixels on the pixels of the view, the lines being
+ *        processed concurrently on a thread pool.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner of \a that in the view.
+ * \param pool The threads processing the lines.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::merge(
+    const const_view_type& that, const math::coordinate_2d<int>& pos,
+    thread_pool& pool) const
+{
+  merge_bands(that, pos, &pool);
+}
+
+/**
+ * \brief Copy some pixels on the pixels of the view.
+ * \param that The pixels to copy.
+ * \param pos The position of the top left corner of \a that in the view.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::partial_copy(
+    const const_view_type& that, const math::coordinate_2d<int>& pos) const
+{
+  partial_copy_bands(that, pos, NULL);
+}
+
+/**
+ * \brief Copy some pixels on the pixels of the view, the lines being
+ *        processed concurrently on a thread pool.
+ * \param that The pixels to copy.
+ * \param pos The position of the top left corner of \a that in the view.
+ * \param pool The threads processing the lines.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::partial_copy(
+    const const_view_type& that, const math::coordinate_2d<int>& pos,
+    thread_pool& pool) const
+{
+  partial_copy_bands(that, pos, &pool);
+}
+
+/**
+ * \brief Fill an area of the view with a given color.
+ * \param r The area to fill, relative to the view.
+ * \param c The color to fill with.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::fill(
+    const math::rectangle<int>& r, const rgba_pixel& c) const
+{
+  fill_bands(r, c, NULL);
+}
+
+/**
+ * \brief Fill an area of the view with a given color, the lines being
+ *        processed concurrently on a thread pool.
+ * \param r The area to fill, relative to the view.
+ * \param c The color to fill with.
+ * \param pool The threads processing the lines.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::fill(
+    const math::rectangle<int>& r, const rgba_pixel& c,
+    thread_pool& pool) const
+{
+  fill_bands(r, c, &pool);
+}
+
+/**
+ * \brief Merge some pixels on the pixels of the view.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner of \a that in the view.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::merge_bands(
+    const const_view_type& that, const math::coordinate_2d<int>& pos,
+    thread_pool* pool) const
+{
+  const basic_image_view dest(
+      sub_view(math::rectangle<int>(pos.x, pos.y, that.width(),
+                                    that.height())));
+
+  if(dest.empty())
+    return;
+
+  const const_view_type src(that.sub_view(math::rectangle<int>(
+      std::max(-pos.x, 0), std::max(-pos.y, 0), dest.width(), dest.height())));
+
+  parallel_for_lines(
+      pool, dest.height(), detail::min_band_height(dest.width()),
+      [&](std::size_t first_line, std::size_t last_line) -> void
+      {
+        for(std::size_t y = first_line; y != last_line; ++y)
+          pixel_kernels::merge(dest[y], src[y], dest.width());
+      });
+}
+
+/**
+ * \brief Copy some pixels on the pixels of the view.
+ * \param that The pixels to copy.
+ * \param pos The position of the top left corner of \a that in the view.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::partial_copy_bands(
+    const const_view_type& that, const math::coordinate_2d<int>& pos,
+    thread_pool* pool) const
+{
+  const basic_image_view dest(
+      sub_view(math::rectangle<int>(pos.x, pos.y, that.width(),
+                                    that.height())));
+
+  if(dest.empty())
+    return;
+
+  const const_view_type src(that.sub_view(math::rectangle<int>(
+      std::max(-pos.x, 0), std::max(-pos.y, 0), dest.width(), dest.height())));
+
+  parallel_for_lines(
+      pool, dest.height(), detail::min_band_height(dest.width()),
+      [&](std::size_t first_line, std::size_t last_line) -> void
+      {
+        for(std::size_t y = first_line; y != last_line; ++y)
+          std::copy(src[y], src[y] + dest.width(), dest[y]);
+      });
+}
+
+/**
+ * \brief Fill an area of the view with a given color.
+ * \param r The area to fill, relative to the view.
+ * \param c The color to fill with.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+template <typename Pixel>
+void claw::graphic::basic_image_view<Pixel>::fill_bands(
+    const math::rectangle<int>& r, const rgba_pixel& c,
+    thread_pool* pool) const
+{
+  const basic_image_view dest(sub_view(r));
+
+  if(dest.empty())
+    return;
+
+  const unsigned int max_comp(
+      std::numeric_limits<rgba_pixel::component_type>::max());
+  const unsigned int src_alpha(c.components.alpha);
+
+  // Each component of the pixels is increased by the color weighted by its
+  // alpha, and the alpha increases by one if the color is fully transparent.
+  // This is the same increment for every pixel.
+  rgba_pixel increment;
+  increment.components.red = src_alpha * c.components.red / max_comp;
+  increment.components.green = src_alpha * c.components.green / max_comp;
+  increment.components.blue = src_alpha * c.components.blue / max_comp;
+  increment.components.alpha = (src_alpha == 0) ? 1 : 0;
+
+  const rgba_pixel zero(0, 0, 0, 0);
+  const rgba_pixel saturated(max_comp, max_comp, max_comp, max_comp);
+
+  if(increment == zero)
+    return;
+
+  parallel_for_lines(
+      pool, dest.height(), detail::min_band_height(dest.width()),
+      [&](std::size_t first_line, std::size_t last_line) -> void
+      {
+        for(std::size_t y = first_line; y != last_line; ++y)
+          // The saturated components do not depend on the
+          // previous value.
+          if(increment == saturated)
+            pixel_kernels::fill(dest[y], dest.width(), saturated);
+          else
+            pixel_kernels::add(dest[y], dest.width(), increment);
+      });
+}
@@ -117,21 +117,24 @@ namespace claw
 
       private:
         /**
-         * \brief Functor converting a RGB pixel to a ARGB pixel.
+         * \brief Functor converting a line of RGB pixels to ARGB pixels.
          */
         class RGB_to_pixel32
         {
         public:
-          rgba_pixel_8 operator()(const JSAMPLE* pixel) const;
+          void operator()(rgba_pixel_8* dest, const JSAMPLE* src,
+                          unsigned int n) const;
         }; // class RGB_to_pixel32
 
         /**
-         * \brief Functor converting a grey level pixel to a ARGB pixel.
+         * \brief Functor converting a line of grey level pixels to ARGB
+         *        pixels.
          */
         class grayscale_to_pixel32
         {
         public:
-          rgba_pixel_8 operator()(const JSAMPLE* pixel) const;
+          void operator()(rgba_pixel_8* dest, const JSAMPLE* src,
+                          unsigned int n) const;
         }; // class grayscale_to_pixel32
 
       public:
@@ -214,8 +217,8 @@ namespace claw
         }; // struct destination_manager
 
       public:
-        writer(const image& img);
-        writer(const image& img, std::ostream& f,
+        writer(const const_image_view& img);
+        writer(const const_image_view& img, std::ostream& f,
                const options& opt = options());
 
         void save(std::ostream& f, const options& opt = options()) const;
@@ -232,7 +235,7 @@ namespace claw
 
       private:
         /** \brief The image from which we thake the data to save. */
-        const image& m_image;
+        const_image_view m_image;
 
         /** \brief Size, in bytes, of a red/green/blue pixel in a jpeg
             file. */
@@ -60,11 +60,8 @@ void claw::graphic::jpeg::reader::read_data(jpeg_decompress_struct& cinfo,
     {
       jpeg_read_scanlines(&cinfo, &buffer, 1);
 
-      scanline::iterator pixel = m_image[cinfo.output_scanline - 1].begin();
-
-      for(unsigned int i = 0; i != pixel_size * m_image.width();
-          i += pixel_size, ++pixel)
-        *pixel = pixel_convert(&buffer[i]);
+      pixel_convert(m_image[cinfo.output_scanline - 1].begin(), buffer,
+                    m_image.width());
     }
 
   delete[] buffer;
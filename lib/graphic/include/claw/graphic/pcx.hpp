@@ -39,6 +39,7 @@
 #include <claw/types.hpp>
 
 #include <iostream>
+#include <vector>
 namespace claw
 {
   namespace graphic
@@ -184,17 +185,22 @@ namespace claw
         }; // class rle_pcx_output_buffer
 
         /**
-         * \brief RLE decoder for pcx RLE format
+         * \brief Policy of claw::rle_decoder reading the header of the
+         *        packets of the pcx RLE format.
          */
-        class rle_pcx_decoder
-          : public rle_decoder<u_int_8, rle_pcx_input_buffer,
-                               rle_pcx_output_buffer>
+        class rle_pcx_mode_reader
         {
-        private:
-          virtual void read_mode(input_buffer_type& input,
-                                 output_buffer_type& output);
+        public:
+          void read_mode(rle_pcx_input_buffer& input,
+                         rle_pcx_output_buffer& output,
+                         rle_packet<u_int_8>& packet) const;
+
+        }; // class rle_pcx_mode_reader
 
-        }; // class rle_pcx_decoder
+        /** \brief RLE decoder for pcx RLE format. */
+        typedef rle_decoder<u_int_8, rle_pcx_input_buffer,
+                            rle_pcx_output_buffer, rle_pcx_mode_reader>
+            rle_pcx_decoder;
 
         /**
          * \brief Function object that converts a scanline of a monochrome pcx
@@ -255,7 +261,9 @@ namespace claw
 
       public:
         reader(image& img);
+        reader(image& img, std::vector<char>& buffer);
         reader(image& img, std::istream& f);
+        reader(image& img, std::istream& f, std::vector<char>& buffer);
 
         void load(std::istream& f);
 
@@ -267,7 +275,7 @@ namespace claw
         void load_true_color(const header& h, std::istream& f);
         void load_256_color_mapped(const header& h, std::istream& f);
 
-        void decompress_line(std::istream& f,
+        void decompress_line(rle_pcx_input_buffer& input,
                              color_plane_type& scanline) const;
 
         template <typename Converter>
@@ -278,6 +286,13 @@ namespace claw
         /** \brief The image in which we store the data we read. */
         image& m_image;
 
+        /** \brief The storage of the input buffers when not provided by the
+            caller. */
+        std::vector<char> m_own_buffer;
+
+        /** \brief The storage of the input buffers. */
+        std::vector<char>& m_buffer;
+
       }; // class reader
 
       /**
@@ -320,8 +335,8 @@ namespace claw
         typedef rle_encoder<file_output_buffer> rle_pcx_encoder;
 
       public:
-        writer(const image& img);
-        writer(const image& img, std::ostream& f);
+        writer(const const_image_view& img);
+        writer(const const_image_view& img, std::ostream& f);
 
         void save(std::ostream& os) const;
 
@@ -332,7 +347,7 @@ namespace claw
 
       private:
         /** \brief The image from which we read the data. */
-        const image& m_image;
+        const_image_view m_image;
 
       }; // class writer
 
@@ -42,10 +42,17 @@ void claw::graphic::pcx::reader::decompress(const header& h, std::istream& f,
   std::vector<color_plane_type> scanline(h.color_planes,
                                          color_plane_type(h.bytes_per_line));
 
+  // The scan lines are contiguous in the file, thus a single buffer is used
+  // for all of them.
+  if(m_buffer.size() < 16384)
+    m_buffer.resize(16384);
+
+  rle_pcx_input_buffer input(f, m_buffer);
+
   for(unsigned int y = 0; y != m_image.height(); ++y)
     {
       for(unsigned int i = 0; i != h.color_planes; ++i)
-        decompress_line(f, scanline[i]);
+        decompress_line(input, scanline[i]);
 
       convert(scanline, m_image, y);
     }
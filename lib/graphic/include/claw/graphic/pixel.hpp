@@ -30,6 +30,8 @@
 #ifndef __CLAW_PIXEL_HPP_
 #define __CLAW_PIXEL_HPP_
 
+#include <claw/run_length.hpp>
+
 #include <string>
 
 namespace claw
@@ -159,6 +161,14 @@ namespace claw
     /** \} */
 
   }
+
+  /**
+   * \brief The rgba pixels are compared with their compressed
+   *        representation, thus their runs can be searched bytewise.
+   */
+  template <>
+  struct is_bitwise_comparable<graphic::rgba_pixel> : public std::true_type
+  {}; // struct is_bitwise_comparable
 }
 
 #endif // __CLAW_PIXEL_HPP__
@@ -0,0 +1,225 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file pixel_kernels.hpp
+ * \brief Functions processing spans of pixels, with SIMD instructions when
+ *        they are available.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_PIXEL_KERNELS_HPP__
+#define __CLAW_PIXEL_KERNELS_HPP__
+
+#include <claw/graphic/pixel.hpp>
+
+#include <cstddef>
+
+namespace claw
+{
+  namespace graphic
+  {
+    /**
+     * \brief Functions processing spans of pixels, with SIMD instructions
+     *        when they are available.
+     *
+     * Each kernel has a scalar implementation, which is the reference, and
+     * SSE2 and AVX2 implementations giving exactly the same results. The
+     * fastest implementation supported by the processor running the program
+     * is used, unless an implementation is explicitly requested.
+     *
+     * The conversions of the colors accept the same span as source and
+     * destination, to convert the pixels in place.
+     *
+     * \author Julien Jorge
+     */
+    class pixel_kernels
+    {
+    public:
+      /** \brief The implementations of the kernels. */
+      enum implementation
+      {
+        /** \brief Process the pixels one by one. */
+        scalar,
+
+        /** \brief Process the pixels with the SSE2 instructions. */
+        sse2,
+
+        /** \brief Process the pixels with the AVX2 instructions. */
+        avx2
+
+      }; // enum implementation
+
+      /** \brief The layouts of the pixels in the buffers of bytes. */
+      enum pixel_format
+      {
+        /** \brief Four bytes per pixel: red, green, blue, alpha. */
+        rgba32,
+
+        /** \brief Four bytes per pixel: blue, green, red, alpha. */
+        bgra32,
+
+        /** \brief Four bytes per pixel: alpha, red, green, blue. */
+        argb32,
+
+        /** \brief Three bytes per pixel: red, green, blue. */
+        rgb24,
+
+        /** \brief Three bytes per pixel: blue, green, red. */
+        bgr24
+
+      }; // enum pixel_format
+
+    public:
+      static implementation best_implementation();
+
+      static void merge(rgba_pixel* dest, const rgba_pixel* src,
+                        std::size_t n);
+      static void merge(rgba_pixel* dest, const rgba_pixel* src, std::size_t n,
+                        implementation impl);
+
+      static void merge_premultiplied(rgba_pixel* dest, const rgba_pixel* src,
+                                      std::size_t n);
+      static void merge_premultiplied(rgba_pixel* dest, const rgba_pixel* src,
+                                      std::size_t n, implementation impl);
+
+      static void add(rgba_pixel* dest, std::size_t n, const rgba_pixel& c);
+      static void add(rgba_pixel* dest, std::size_t n, const rgba_pixel& c,
+                      implementation impl);
+
+      static void fill(rgba_pixel* dest, std::size_t n, const rgba_pixel& c);
+      static void fill(rgba_pixel* dest, std::size_t n, const rgba_pixel& c,
+                       implementation impl);
+
+      static void grayscale(rgba_pixel* dest, const rgba_pixel* src,
+                            std::size_t n);
+      static void grayscale(rgba_pixel* dest, const rgba_pixel* src,
+                            std::size_t n, implementation impl);
+
+      static void premultiply(rgba_pixel* dest, const rgba_pixel* src,
+                              std::size_t n);
+      static void premultiply(rgba_pixel* dest, const rgba_pixel* src,
+                              std::size_t n, implementation impl);
+
+      static void unpremultiply(rgba_pixel* dest, const rgba_pixel* src,
+                                std::size_t n);
+      static void unpremultiply(rgba_pixel* dest, const rgba_pixel* src,
+                                std::size_t n, implementation impl);
+
+      static std::size_t bytes_per_pixel(pixel_format f);
+
+      static void convert_to(unsigned char* dest, pixel_format f,
+                             const rgba_pixel* src, std::size_t n);
+      static void convert_to(unsigned char* dest, pixel_format f,
+                             const rgba_pixel* src, std::size_t n,
+                             implementation impl);
+
+      static void convert_from(rgba_pixel* dest, const unsigned char* src,
+                               pixel_format f, std::size_t n);
+      static void convert_from(rgba_pixel* dest, const unsigned char* src,
+                               pixel_format f, std::size_t n,
+                               implementation impl);
+
+    private:
+      static std::size_t merge_sse2(rgba_pixel* dest, const rgba_pixel* src,
+                                    std::size_t n);
+      static std::size_t merge_avx2(rgba_pixel* dest, const rgba_pixel* src,
+                                    std::size_t n);
+      static void merge_scalar(rgba_pixel* dest, const rgba_pixel* src,
+                               std::size_t n);
+
+      static std::size_t merge_premultiplied_sse2(rgba_pixel* dest,
+                                                  const rgba_pixel* src,
+                                                  std::size_t n);
+      static std::size_t merge_premultiplied_avx2(rgba_pixel* dest,
+                                                  const rgba_pixel* src,
+                                                  std::size_t n);
+      static void merge_premultiplied_scalar(rgba_pixel* dest,
+                                             const rgba_pixel* src,
+                                             std::size_t n);
+
+      static std::size_t add_sse2(rgba_pixel* dest, std::size_t n,
+                                  const rgba_pixel& c);
+      static std::size_t add_avx2(rgba_pixel* dest, std::size_t n,
+                                  const rgba_pixel& c);
+      static void add_scalar(rgba_pixel* dest, std::size_t n,
+                             const rgba_pixel& c);
+
+      static std::size_t fill_sse2(rgba_pixel* dest, std::size_t n,
+                                   const rgba_pixel& c);
+      static std::size_t fill_avx2(rgba_pixel* dest, std::size_t n,
+                                   const rgba_pixel& c);
+      static void fill_scalar(rgba_pixel* dest, std::size_t n,
+                              const rgba_pixel& c);
+
+      static std::size_t grayscale_sse2(rgba_pixel* dest,
+                                        const rgba_pixel* src, std::size_t n);
+      static std::size_t grayscale_avx2(rgba_pixel* dest,
+                                        const rgba_pixel* src, std::size_t n);
+      static void grayscale_scalar(rgba_pixel* dest, const rgba_pixel* src,
+                                   std::size_t n);
+
+      static std::size_t premultiply_sse2(rgba_pixel* dest,
+                                          const rgba_pixel* src,
+                                          std::size_t n);
+      static std::size_t premultiply_avx2(rgba_pixel* dest,
+                                          const rgba_pixel* src,
+                                          std::size_t n);
+      static void premultiply_scalar(rgba_pixel* dest, const rgba_pixel* src,
+                                     std::size_t n);
+
+      static std::size_t unpremultiply_sse2(rgba_pixel* dest,
+                                            const rgba_pixel* src,
+                                            std::size_t n);
+      static std::size_t unpremultiply_avx2(rgba_pixel* dest,
+                                            const rgba_pixel* src,
+                                            std::size_t n);
+      static void unpremultiply_scalar(rgba_pixel* dest,
+                                       const rgba_pixel* src, std::size_t n);
+
+      static std::size_t convert_to_sse2(unsigned char* dest, pixel_format f,
+                                         const rgba_pixel* src,
+                                         std::size_t n);
+      static std::size_t convert_to_avx2(unsigned char* dest, pixel_format f,
+                                         const rgba_pixel* src,
+                                         std::size_t n);
+      static void convert_to_scalar(unsigned char* dest, pixel_format f,
+                                    const rgba_pixel* src, std::size_t n);
+
+      static std::size_t convert_from_sse2(rgba_pixel* dest,
+                                           const unsigned char* src,
+                                           pixel_format f, std::size_t n);
+      static std::size_t convert_from_avx2(rgba_pixel* dest,
+                                           const unsigned char* src,
+                                           pixel_format f, std::size_t n);
+      static void convert_from_scalar(rgba_pixel* dest,
+                                      const unsigned char* src,
+                                      pixel_format f, std::size_t n);
+
+      static bool has_avx2();
+
+    }; // class pixel_kernels
+  }
+}
+
+#endif // __CLAW_PIXEL_KERNELS_HPP__
@@ -173,8 +173,8 @@ namespace claw
         }; // struct target_manager
 
       public:
-        writer(const image& img);
-        writer(const image& img, std::ostream& f,
+        writer(const const_image_view& img);
+        writer(const const_image_view& img, std::ostream& f,
                const options& opt = options());
 
         void save(std::ostream& f, const options& opt = options()) const;
@@ -191,7 +191,7 @@ namespace claw
 
       private:
         /** \brief The image from which we thake the data to save. */
-        const image& m_image;
+        const_image_view m_image;
 
         /** \brief Size, in bytes, of a red/green/blue/alpha pixel in a png
             file. */
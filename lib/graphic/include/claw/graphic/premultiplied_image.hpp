@@ -0,0 +1,106 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file premultiplied_image.hpp
+ * \brief An image whose colors are multiplied by their alpha.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_PREMULTIPLIED_IMAGE_HPP__
+#define __CLAW_PREMULTIPLIED_IMAGE_HPP__
+
+#include <claw/graphic/image.hpp>
+#include <claw/graphic/image_view.hpp>
+
+#include <cstddef>
+#include <iostream>
+
+namespace claw
+{
+  namespace graphic
+  {
+    /**
+     * \brief An image whose colors are multiplied by their alpha.
+     *
+     * The pixels of a claw::graphic::image have straight alpha: their colors
+     * are weighted by their alpha each time they are composed. Here, the
+     * weighting is done once, when the pixels enter the image, and a merge
+     * only adds the source pixel to the destination pixel reduced by the
+     * transparency of the source, component by component.
+     *
+     * The pixels are premultiplied when they are assigned from a straight
+     * alpha image or loaded from a stream, and restored by to_image(), whose
+     * result can be given to the writers. This round trip is exact for the
+     * opaque pixels. The colors of the translucent pixels lose some
+     * precision, and the ones of the fully transparent pixels are lost.
+     *
+     * \author Julien Jorge
+     */
+    class premultiplied_image
+    {
+    public:
+      premultiplied_image();
+      premultiplied_image(unsigned int w, unsigned int h);
+      explicit premultiplied_image(const const_image_view& straight);
+      explicit premultiplied_image(std::istream& f);
+
+      void swap(premultiplied_image& that);
+
+      unsigned int width() const;
+      unsigned int height() const;
+
+      image_view view();
+      const_image_view view() const;
+
+      void assign(const const_image_view& straight);
+      image to_image() const;
+
+      void load(std::istream& f);
+      void load(const char* data, std::size_t size);
+
+      void merge(const premultiplied_image& that,
+                 const math::coordinate_2d<int>& pos);
+      void merge(const premultiplied_image& that,
+                 const math::coordinate_2d<int>& pos, thread_pool& pool);
+
+      void fill(const math::rectangle<int>& r, const rgba_pixel& c);
+      void fill(const math::rectangle<int>& r, const rgba_pixel& c,
+                thread_pool& pool);
+
+    private:
+      void merge_bands(const premultiplied_image& that,
+                       const math::coordinate_2d<int>& pos,
+                       thread_pool* pool);
+      void fill_bands(const math::rectangle<int>& r, const rgba_pixel& c,
+                      thread_pool* pool);
+
+    private:
+      /** \brief The premultiplied pixels. */
+      image m_pixels;
+
+    }; // class premultiplied_image
+  }
+}
+
+#endif // __CLAW_PREMULTIPLIED_IMAGE_HPP__
@@ -0,0 +1,180 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file resampler.hpp
+ * \brief Resize images with a filter.
+ * \author Julien Jorge
+ */
+#ifndef __CLAW_RESAMPLER_HPP__
+#define __CLAW_RESAMPLER_HPP__
+
+#include <claw/graphic/image.hpp>
+#include <claw/graphic/pixel_kernels.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace claw
+{
+  namespace graphic
+  {
+    /**
+     * \brief Resize images with a filter.
+     *
+     * The pixels are resampled in two separable passes: the lines are first
+     * resized horizontally, then the columns of the result are resized
+     * vertically. The weights of the source pixels are computed once per
+     * resize for each axis and stored as fixed point numbers, such that the
+     * passes only do integer operations, with the SIMD instructions of the
+     * processor when they are available. All the implementations give
+     * exactly the same result.
+     *
+     * The components of the pixels are filtered independently, the alpha
+     * being processed like the colors.
+     *
+     * \author Julien Jorge
+     */
+    class resampler
+    {
+    public:
+      /** \brief The filters used to compute the destination pixels. */
+      enum filter_type
+      {
+        /** \brief The average of the source pixels covered by the
+            destination pixel. */
+        box,
+
+        /** \brief A linear interpolation of the nearest source pixels. */
+        bilinear,
+
+        /** \brief A cubic interpolation of the 4x4 nearest source pixels
+            (Keys' kernel, with a = -0.5). */
+        bicubic,
+
+        /** \brief A windowed sinc on the 6x6 nearest source pixels. */
+        lanczos
+
+      }; // enum filter_type
+
+    private:
+      /**
+       * \brief The weights of the source pixels for each destination pixel,
+       *        on one axis.
+       */
+      struct weights
+      {
+        /** \brief The first source pixel contributing to each destination
+            pixel. */
+        std::vector<unsigned int> first;
+
+        /** \brief The number of source pixels contributing to each
+            destination pixel. */
+        std::vector<unsigned int> count;
+
+        /** \brief The weights of the contributing source pixels, by groups
+            of taps values for each destination pixel. */
+        std::vector<std::int16_t> values;
+
+        /** \brief The maximum number of source pixels contributing to a
+            destination pixel. */
+        unsigned int taps;
+
+      }; // struct weights
+
+    public:
+      /** \brief The number of bits of the fractional part of the weights. */
+      static const unsigned int precision_bits = 14;
+
+    public:
+      explicit resampler(filter_type f = bicubic);
+      resampler(filter_type f, pixel_kernels::implementation impl);
+
+      image scale(const const_image_view& src, unsigned int w,
+                  unsigned int h) const;
+      image scale(const const_image_view& src, unsigned int w, unsigned int h,
+                  thread_pool& pool) const;
+
+      void resample(const const_image_view& src, const image_view& dest) const;
+      void resample(const const_image_view& src, const image_view& dest,
+                    thread_pool& pool) const;
+
+    private:
+      void resample(const const_image_view& src, const image_view& dest,
+                    thread_pool* pool) const;
+
+      void horizontal_pass(const const_image_view& src,
+                           const image_view& dest, const weights& w,
+                           thread_pool* pool) const;
+      void vertical_pass(const const_image_view& src, const image_view& dest,
+                         unsigned int first_line, const weights& w,
+                         thread_pool* pool) const;
+
+      void compute_weights(unsigned int in, unsigned int out,
+                           weights& w) const;
+      double support() const;
+      double kernel(double x) const;
+
+      void resample_line(rgba_pixel* dest, const rgba_pixel* src,
+                         const weights& w) const;
+      static void resample_line_sse2(rgba_pixel* dest, const rgba_pixel* src,
+                                     const weights& w);
+      static void resample_line_scalar(rgba_pixel* dest,
+                                       const rgba_pixel* src,
+                                       const weights& w);
+
+      void combine_lines(rgba_pixel* dest, const rgba_pixel* const* lines,
+                         const std::int16_t* w, unsigned int count,
+                         std::size_t n) const;
+      static std::size_t combine_lines_sse2(rgba_pixel* dest,
+                                            const rgba_pixel* const* lines,
+                                            const std::int16_t* w,
+                                            unsigned int count,
+                                            std::size_t first,
+                                            std::size_t last);
+      static std::size_t combine_lines_avx2(rgba_pixel* dest,
+                                            const rgba_pixel* const* lines,
+                                            const std::int16_t* w,
+                                            unsigned int count,
+                                            std::size_t first,
+                                            std::size_t last);
+      static void combine_lines_scalar(rgba_pixel* dest,
+                                       const rgba_pixel* const* lines,
+                                       const std::int16_t* w,
+                                       unsigned int count, std::size_t first,
+                                       std::size_t last);
+
+    private:
+      /** \brief The filter used to compute the destination pixels. */
+      const filter_type m_filter;
+
+      /** \brief The implementation of the passes. */
+      const pixel_kernels::implementation m_implementation;
+
+    }; // class resampler
+  }
+}
+
+#endif // __CLAW_RESAMPLER_HPP__
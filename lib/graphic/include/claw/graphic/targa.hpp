@@ -38,6 +38,7 @@
 #include <claw/rle_encoder.hpp>
 
 #include <iostream>
+#include <vector>
 
 namespace claw
 {
@@ -220,7 +221,7 @@ namespace claw
           typedef Pixel pixel_type;
 
         public:
-          file_input_buffer(std::istream& f);
+          file_input_buffer(std::istream& f, std::vector<char>& buffer);
           rgba_pixel_8 get_pixel();
 
         }; // class file_input_buffer
@@ -240,7 +241,8 @@ namespace claw
           typedef Pixel pixel_type;
 
         public:
-          mapped_file_input_buffer(std::istream& f, const color_palette32& p);
+          mapped_file_input_buffer(std::istream& f, const color_palette32& p,
+                                   std::vector<char>& buffer);
           rgba_pixel_8 get_pixel();
 
         private:
@@ -296,11 +298,26 @@ namespace claw
 
         }; // class rle_targa_output_buffer
 
+        /**
+         * \brief Policy of claw::rle_decoder reading the header of the
+         *        packets of the targa RLE format.
+         *
+         * \author Julien Jorge
+         */
+        class rle_targa_mode_reader
+        {
+        public:
+          template <typename InputBuffer, typename OutputBuffer>
+          void read_mode(InputBuffer& input, OutputBuffer& output,
+                         rle_packet<rgba_pixel_8>& packet) const;
+
+        }; // class rle_targa_mode_reader
+
         /**
          * \brief RLE decoder for targa RLE format
          *
          * \b Template \b parameters :
-         * - \a Pixel, the type of the pixels in the file.
+         * - \a InputBuffer, the type of the input buffer.
          * - \a OutputBuffer, the type of the output buffer.
          *
          * The \a OutputBuffer type must match the type requirements of the
@@ -312,20 +329,9 @@ namespace claw
                   typename OutputBuffer
                   = rle_targa_output_buffer<InputBuffer> >
         class rle_targa_decoder
-          : public rle_decoder<rgba_pixel_8, InputBuffer, OutputBuffer>
-        {
-        public:
-          /** \brief Type of the input buffer. */
-          typedef InputBuffer input_buffer_type;
-
-          /** \brief Type of the output buffer. */
-          typedef OutputBuffer output_buffer_type;
-
-        private:
-          virtual void read_mode(input_buffer_type& input,
-                                 output_buffer_type& output);
-
-        }; // class rle_targa_decoder
+          : public rle_decoder<rgba_pixel_8, InputBuffer, OutputBuffer,
+                               rle_targa_mode_reader>
+        {}; // class rle_targa_decoder
 
         /** \brief RLE decoder for 32 bpp targa images. */
         typedef rle_targa_decoder<file_input_buffer<rgba_pixel_8> >
@@ -344,7 +350,9 @@ namespace claw
 
       public:
         reader(image& img);
+        reader(image& img, std::vector<char>& buffer);
         reader(image& img, std::istream& f);
+        reader(image& img, std::istream& f, std::vector<char>& buffer);
 
         void load(std::istream& f);
 
@@ -381,6 +389,13 @@ namespace claw
         /** \brief The image in which we store the data we read. */
         image& m_image;
 
+        /** \brief The storage of the input buffers when not provided by the
+            caller. */
+        std::vector<char> m_own_buffer;
+
+        /** \brief The storage of the input buffers. */
+        std::vector<char>& m_buffer;
+
       }; // class reader
 
       /**
@@ -417,12 +432,16 @@ namespace claw
           unsigned int min_interesting() const;
           unsigned int max_encodable() const;
 
+          void order_pixel_bytes(const pixel_type& p);
+
+        private:
           /**
-           * \brief Write a pixel in the stream and set its value in the good
-           *        order.
-           * \param p The pixel to write.
+           * \brief Store the bytes of a pixel in the order of the file.
+           * \param p The pixel to store.
+           * \param out Where the bytes are stored.
+           * \return The position after the last stored byte.
            */
-          void order_pixel_bytes(const pixel_type& p);
+          char* store_pixel_bytes(const pixel_type& p, char* out) const;
 
         private:
           /** \brief The stream in which we write. */
@@ -452,8 +471,8 @@ namespace claw
         typedef rle_targa_encoder<rgba_pixel_8> rle32_encoder;
 
       public:
-        writer(const image& img);
-        writer(const image& img, std::ostream& f, bool rle);
+        writer(const const_image_view& img);
+        writer(const const_image_view& img, std::ostream& f, bool rle);
 
         void save(std::ostream& f, bool rle) const;
 
@@ -463,7 +482,7 @@ namespace claw
 
       private:
         /** \brief The image from which we read the data. */
-        const image& m_image;
+        const_image_view m_image;
 
       }; // class writer
 
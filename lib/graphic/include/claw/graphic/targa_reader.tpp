@@ -28,17 +28,19 @@
  *        subclasses.
  * \author Julien Jorge
  */
+#include <algorithm>
 #include <iterator>
 #include <limits>
 
 /**
  * \brief Constructor.
  * \param f The file to read.
+ * \param buffer The storage of the buffer.
  */
 template <typename Pixel>
 claw::graphic::targa::reader::file_input_buffer<Pixel>::file_input_buffer(
-    std::istream& f)
-  : buffered_istream<std::istream>(f)
+    std::istream& f, std::vector<char>& buffer)
+  : buffered_istream<std::istream>(f, buffer)
 {}
 
 //*****************************************************************************/
@@ -47,11 +49,13 @@ claw::graphic::targa::reader::file_input_buffer<Pixel>::file_input_buffer(
  * \brief Constructor.
  * \param f The file to read.
  * \param p The color palette.
+ * \param buffer The storage of the buffer.
  */
 template <typename Pixel>
 claw::graphic::targa::reader::mapped_file_input_buffer<
-    Pixel>::mapped_file_input_buffer(std::istream& f, const color_palette32& p)
-  : buffered_istream<std::istream>(f)
+    Pixel>::mapped_file_input_buffer(std::istream& f, const color_palette32& p,
+                                     std::vector<char>& buffer)
+  : buffered_istream<std::istream>(f, buffer)
   , m_palette(p)
 {}
 
@@ -97,8 +101,15 @@ void claw::graphic::targa::reader::rle_targa_output_buffer<InputBuffer>::fill(
   const int bound = (int)m_x + m_x_inc * n;
   int x = m_x;
 
-  for(; x != bound; x += m_x_inc)
-    m_image[m_y][x] = pattern;
+  if(m_x_inc == 1)
+    {
+      rgba_pixel_8* const line = &m_image[m_y][0];
+      std::fill(line + x, line + bound, pattern);
+      x = bound;
+    }
+  else
+    for(; x != bound; x += m_x_inc)
+      m_image[m_y][x] = pattern;
 
   adjust_position(x);
 }
@@ -167,13 +178,14 @@ void claw::graphic::targa::reader::rle_targa_output_buffer<
  * \brief Get the type of the following data in the input buffer.
  * \param input The input stream (the targa file).
  * \param output The output stream (the targa image).
+ * \param packet (out) The header of the next packet.
  */
 template <typename InputBuffer, typename OutputBuffer>
-void claw::graphic::targa::reader::rle_targa_decoder<
-    InputBuffer, OutputBuffer>::read_mode(input_buffer_type& input,
-                                          output_buffer_type& output)
+void claw::graphic::targa::reader::rle_targa_mode_reader::read_mode(
+    InputBuffer& input, OutputBuffer& output,
+    rle_packet<rgba_pixel_8>& packet) const
 {
-  this->m_mode = this->stop;
+  packet.mode = packet.stop;
   bool ok = !output.completed();
 
   if(ok && (input.remaining() < 1))
@@ -183,15 +195,15 @@ void claw::graphic::targa::reader::rle_targa_decoder<
     {
       char key = input.get_next();
 
-      this->m_count = (key & 0x7F) + 1;
+      packet.count = (key & 0x7F) + 1;
 
       if(key & 0x80) // compressed
         {
-          this->m_mode = this->compressed;
-          this->m_pattern = input.get_pixel();
+          packet.mode = packet.compressed;
+          packet.pattern = input.get_pixel();
         }
       else
-        this->m_mode = this->raw;
+        packet.mode = packet.raw;
     }
 }
 
@@ -216,7 +228,7 @@ void claw::graphic::targa::reader::load_color_mapped_raw(
   rle_targa_output_buffer<input_buffer_type> output(
       m_image, h.image_specification.up_down_oriented(),
       h.image_specification.left_right_oriented());
-  input_buffer_type input(f, palette);
+  input_buffer_type input(f, palette, m_buffer);
 
   for(unsigned int i = 0; i != m_image.height(); ++i)
     output.copy(m_image.width(), input);
@@ -237,7 +249,7 @@ void claw::graphic::targa::reader::decompress_rle_color_mapped(
   typename Decoder::output_buffer_type output_buffer(
       m_image, h.image_specification.up_down_oriented(),
       h.image_specification.left_right_oriented());
-  typename Decoder::input_buffer_type input_buffer(f, palette);
+  typename Decoder::input_buffer_type input_buffer(f, palette, m_buffer);
 
   decoder.decode(input_buffer, output_buffer);
 }
@@ -262,7 +274,7 @@ void claw::graphic::targa::reader::load_true_color_raw(const header& h,
   rle_targa_output_buffer<input_buffer_type> output(
       m_image, h.image_specification.up_down_oriented(),
       h.image_specification.left_right_oriented());
-  input_buffer_type input(f);
+  input_buffer_type input(f, m_buffer);
 
   for(unsigned int i = 0; i != m_image.height(); ++i)
     output.copy(m_image.width(), input);
@@ -284,7 +296,7 @@ void claw::graphic::targa::reader::decompress_rle_true_color(const header& h,
   typename Decoder::output_buffer_type output_buffer(
       m_image, h.image_specification.up_down_oriented(),
       h.image_specification.left_right_oriented());
-  typename Decoder::input_buffer_type input_buffer(f);
+  typename Decoder::input_buffer_type input_buffer(f, m_buffer);
 
   decoder.decode(input_buffer, output_buffer);
 }
@@ -298,7 +310,7 @@ template <typename Pixel>
 void claw::graphic::targa::reader::load_palette_content(
     std::istream& f, color_palette32& palette) const
 {
-  file_input_buffer<Pixel> input(f);
+  file_input_buffer<Pixel> input(f, m_buffer);
 
   for(unsigned int i = 0; i != palette.size(); ++i)
     palette[i] = input.get_pixel();
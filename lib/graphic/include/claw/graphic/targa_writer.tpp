@@ -28,6 +28,7 @@
  *        subclasses.
  * \author Julien Jorge
  */
+#include <algorithm>
 #include <iterator>
 #include <limits>
 
@@ -56,10 +57,10 @@ void claw::graphic::targa::writer::file_output_buffer<Pixel>::encode(
   assert(n <= max_encodable());
   assert(n >= min_interesting());
 
-  unsigned char key = (n - 1) | 0x80;
+  char packet[1 + sizeof(pixel_type)];
 
-  m_stream << key;
-  order_pixel_bytes(pattern);
+  packet[0] = (n - 1) | 0x80;
+  m_stream.write(packet, store_pixel_bytes(pattern, packet + 1) - packet);
 }
 
 /**
@@ -72,28 +73,23 @@ template <typename Iterator>
 void claw::graphic::targa::writer::file_output_buffer<Pixel>::raw(
     Iterator first, Iterator last)
 {
+  // The packets are built in memory and written with a single call.
+  char packet[1 + 0x80 * sizeof(pixel_type)];
   unsigned int n = std::distance(first, last);
 
-  unsigned int full = n / max_encodable();
-  unsigned int remaining = n % max_encodable();
-
-  unsigned char key = max_encodable() - 1;
-
-  for(unsigned int i = 0; i != full; ++i)
+  while(n != 0)
     {
-      m_stream << key;
+      const unsigned int count = std::min(n, max_encodable());
+      char* p = packet;
 
-      for(unsigned int j = 0; j != max_encodable(); ++j, ++first)
-        order_pixel_bytes(*first);
-    }
+      *p = count - 1;
+      ++p;
 
-  if(remaining)
-    {
-      key = remaining - 1;
-      m_stream << key;
+      for(unsigned int j = 0; j != count; ++j, ++first)
+        p = store_pixel_bytes(*first, p);
 
-      for(unsigned int j = 0; j != remaining; ++j, ++first)
-        order_pixel_bytes(*first);
+      m_stream.write(packet, p - packet);
+      n -= count;
     }
 }
 
@@ -117,3 +113,15 @@ claw::graphic::targa::writer::file_output_buffer<Pixel>::max_encodable() const
 {
   return 0x80;
 }
+
+/**
+ * \brief Write a pixel in the stream and set its value in the good order.
+ * \param p The pixel to write.
+ */
+template <typename Pixel>
+void claw::graphic::targa::writer::file_output_buffer<
+    Pixel>::order_pixel_bytes(const pixel_type& p)
+{
+  char bytes[sizeof(pixel_type)];
+  m_stream.write(bytes, store_pixel_bytes(p, bytes) - bytes);
+}
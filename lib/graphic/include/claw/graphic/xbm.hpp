@@ -113,8 +113,8 @@ namespace claw
         }; // options
 
       public:
-        writer(const image& img);
-        writer(const image& img, std::ostream& f,
+        writer(const const_image_view& img);
+        writer(const const_image_view& img, std::ostream& f,
                const options& opt = options());
 
         void save(std::ostream& f, const options& opt = options()) const;
@@ -124,7 +124,7 @@ namespace claw
 
       private:
         /** \brief The image from which we take the data to save. */
-        const image& m_image;
+        const_image_view m_image;
 
       }; // class writer
 
@@ -0,0 +1,229 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file batch_loader.cpp
+ * \brief Implementation of the claw::graphic::batch_loader class.
+ * \author Julien Jorge
+ */
+#include <claw/graphic/batch_loader.hpp>
+
+#include <claw/assert.hpp>
+#include <claw/parallel_for.hpp>
+
+#include <chrono>
+#include <exception>
+#include <fstream>
+
+/**
+ * \brief Get the number of images loaded per second.
+ */
+double claw::graphic::batch_loader::statistics::images_per_second() const
+{
+  if(duration == 0)
+    return 0;
+  else
+    return loaded_count / duration;
+}
+
+/**
+ * \brief Get the number of pixels loaded per second.
+ */
+double claw::graphic::batch_loader::statistics::pixels_per_second() const
+{
+  if(duration == 0)
+    return 0;
+  else
+    return pixel_count / duration;
+}
+
+/**
+ * \brief Constructor.
+ * \param formats The formats of the images. This registry must live longer
+ *        than the loader.
+ */
+claw::graphic::batch_loader::batch_loader(const format_registry& formats)
+  : m_formats(formats)
+{}
+
+/**
+ * \brief Load the images of some files, one after the other.
+ * \param paths The paths of the files.
+ * \param result (out) The images of the files, in the order of \a paths.
+ */
+claw::graphic::batch_loader::statistics
+claw::graphic::batch_loader::load(const std::vector<std::string>& paths,
+                                  std::vector<item>& result) const
+{
+  return load_all(paths, result, NULL);
+}
+
+/**
+ * \brief Load the images of some files, concurrently on a thread pool.
+ * \param paths The paths of the files.
+ * \param result (out) The images of the files, in the order of \a paths.
+ * \param pool The threads loading the images.
+ */
+claw::graphic::batch_loader::statistics
+claw::graphic::batch_loader::load(const std::vector<std::string>& paths,
+                                  std::vector<item>& result,
+                                  thread_pool& pool) const
+{
+  return load_all(paths, result, &pool);
+}
+
+/**
+ * \brief Load the images of some streams, one after the other.
+ * \param streams The streams.
+ * \param result (out) The images of the streams, in the order of \a streams.
+ * \pre None of the streams is NULL.
+ */
+claw::graphic::batch_loader::statistics
+claw::graphic::batch_loader::load(const std::vector<std::istream*>& streams,
+                                  std::vector<item>& result) const
+{
+  return load_all(streams, result, NULL);
+}
+
+/**
+ * \brief Load the images of some streams, concurrently on a thread pool.
+ * \param streams The streams, each of them being read by a single thread.
+ * \param result (out) The images of the streams, in the order of \a streams.
+ * \param pool The threads loading the images.
+ * \pre None of the streams is NULL.
+ */
+claw::graphic::batch_loader::statistics
+claw::graphic::batch_loader::load(const std::vector<std::istream*>& streams,
+                                  std::vector<item>& result,
+                                  thread_pool& pool) const
+{
+  return load_all(streams, result, &pool);
+}
+
+/**
+ * \brief Load the images of some sources.
+ * \param sources The sources.
+ * \param result (out) The images of the sources, in the order of
+ *        \a sources.
+ * \param pool The threads loading the images, NULL to load them in the
+ *        calling thread.
+ */
+template <typename Source>
+claw::graphic::batch_loader::statistics
+claw::graphic::batch_loader::load_all(const std::vector<Source>& sources,
+                                      std::vector<item>& result,
+                                      thread_pool* pool) const
+{
+  const std::chrono::steady_clock::time_point begin =
+      std::chrono::steady_clock::now();
+
+  result.clear();
+  result.resize(sources.size());
+
+  // Each source is loaded in its own item, thus the bands never write the
+  // same data. The buffer of the readers is shared by the images of a band.
+  const auto load_band = [&](std::size_t first, std::size_t last) -> void
+  {
+    std::vector<char> buffer;
+
+    for(std::size_t i = first; i != last; ++i)
+      load_item(sources[i], buffer, result[i]);
+  };
+
+  parallel_for_lines(pool, sources.size(), 1, load_band);
+
+  statistics stats;
+  stats.loaded_count = 0;
+  stats.failed_count = 0;
+  stats.pixel_count = 0;
+
+  for(std::size_t i = 0; i != result.size(); ++i)
+    if(result[i].loaded)
+      {
+        ++stats.loaded_count;
+        stats.pixel_count += (std::size_t)result[i].picture.width()
+                             * result[i].picture.height();
+      }
+    else
+      ++stats.failed_count;
+
+  const std::chrono::duration<double> d(std::chrono::steady_clock::now()
+                                        - begin);
+  stats.duration = d.count();
+
+  return stats;
+}
+
+/**
+ * \brief Load the image of a file.
+ * \param path The path of the file.
+ * \param buffer The storage used by the readers to buffer the file.
+ * \param result (out) The image of the file.
+ */
+void claw::graphic::batch_loader::load_item(const std::string& path,
+                                            std::vector<char>& buffer,
+                                            item& result) const
+{
+  std::ifstream f(path.c_str(), std::ios_base::binary);
+
+  if(f)
+    load_item(&f, buffer, result);
+  else
+    {
+      result.loaded = false;
+      result.error = "Can't open file '" + path + "'.";
+    }
+}
+
+/**
+ * \brief Load the image of a stream.
+ * \param f The stream.
+ * \param buffer The storage used by the readers to buffer the stream.
+ * \param result (out) The image of the stream.
+ */
+void claw::graphic::batch_loader::load_item(std::istream* f,
+                                            std::vector<char>& buffer,
+                                            item& result) const
+{
+  CLAW_PRECOND(f != NULL);
+
+  result.loaded = false;
+
+  try
+    {
+      m_formats.load(result.picture, *f, buffer);
+      result.loaded = true;
+    }
+  catch(const std::exception& e)
+    {
+      result.error = e.what();
+    }
+  catch(...)
+    {
+      result.error = "Unknown error.";
+    }
+
+  if(!result.loaded)
+    result.picture = image();
+}
@@ -29,6 +29,8 @@
  */
 #include <claw/graphic/bitmap.hpp>
 
+#include <claw/graphic/pixel_kernels.hpp>
+
 #include <algorithm>
 
 namespace claw
@@ -72,17 +74,20 @@ namespace claw
     {
       assert(m_x + n <= m_image.width());
 
-      for(unsigned int i = 0; i != n / 2; ++i, m_x += 2)
+      const rgba_pixel_8 first = m_palette[(pattern & 0xF0) >> 4];
+      const rgba_pixel_8 second = m_palette[pattern & 0x0F];
+      rgba_pixel_8* p = &m_image[m_y][m_x];
+
+      for(unsigned int i = 0; i != n / 2; ++i, p += 2)
         {
-          m_image[m_y][m_x] = m_palette[(pattern & 0xF0) >> 4];
-          m_image[m_y][m_x + 1] = m_palette[pattern & 0x0F];
+          p[0] = first;
+          p[1] = second;
         }
 
       if(n % 2)
-        {
-          m_image[m_y][m_x] = m_palette[(pattern & 0xF0) >> 4];
-          ++m_x;
-        }
+        *p = first;
+
+      m_x += n;
     }
   }
 }
@@ -255,18 +260,9 @@ void claw::graphic::bitmap::reader::pixel8_to_pixel32::operator()(
 void claw::graphic::bitmap::reader::pixel24_to_pixel32::operator()(
     scanline& dest, const char* src, const color_palette_type& palette) const
 {
-  scanline::iterator it(dest.begin());
-  const unsigned int upper_bound = 3 * dest.size();
-
-  for(unsigned int i = 0; i != upper_bound; i += 3)
-    {
-      it->components.alpha = 255;
-      it->components.blue = src[i];
-      it->components.green = src[i + 1];
-      it->components.red = src[i + 2];
-
-      ++it;
-    }
+  pixel_kernels::convert_from(dest.begin(),
+                              reinterpret_cast<const unsigned char*>(src),
+                              pixel_kernels::bgr24, dest.size());
 }
 
 /**
@@ -275,6 +271,18 @@ void claw::graphic::bitmap::reader::pixel24_to_pixel32::operator()(
  */
 claw::graphic::bitmap::reader::reader(image& img)
   : m_image(img)
+  , m_buffer(m_own_buffer)
+{}
+
+/**
+ * \brief Constructor.
+ * \param img The image in which the data will be stored.
+ * \param buffer The storage of the input buffers, reused for each file read
+ *        by this reader. It must outlive this instance.
+ */
+claw::graphic::bitmap::reader::reader(image& img, std::vector<char>& buffer)
+  : m_image(img)
+  , m_buffer(buffer)
 {}
 
 /**
@@ -285,6 +293,23 @@ claw::graphic::bitmap::reader::reader(image& img)
  */
 claw::graphic::bitmap::reader::reader(image& img, std::istream& f)
   : m_image(img)
+  , m_buffer(m_own_buffer)
+{
+  load(f);
+}
+
+/**
+ * \brief Constructor.
+ * \param img The image in which the data will be stored.
+ * \param f The file from which we read the data.
+ * \param buffer The storage of the input buffers. It must outlive this
+ *        instance.
+ * \post img contains the data from \a f.
+ */
+claw::graphic::bitmap::reader::reader(image& img, std::istream& f,
+                                       std::vector<char>& buffer)
+  : m_image(img)
+  , m_buffer(buffer)
 {
   load(f);
 }
@@ -486,7 +511,7 @@ void claw::graphic::bitmap::reader::load_4bpp_rle(
 
   rle4_decoder decoder;
   rle4_decoder::output_buffer_type output_buffer(palette, m_image);
-  file_input_buffer input_buffer(f);
+  file_input_buffer input_buffer(f, m_buffer);
 
   decoder.decode(input_buffer, output_buffer);
 }
@@ -532,7 +557,7 @@ void claw::graphic::bitmap::reader::load_8bpp_rle(
 
   rle8_decoder decoder;
   rle8_decoder::output_buffer_type output_buffer(palette, m_image);
-  file_input_buffer input_buffer(f);
+  file_input_buffer input_buffer(f, m_buffer);
 
   decoder.decode(input_buffer, output_buffer);
 }
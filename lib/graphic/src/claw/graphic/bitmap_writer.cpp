@@ -29,13 +29,15 @@
  */
 #include <claw/graphic/bitmap.hpp>
 
+#include <claw/graphic/pixel_kernels.hpp>
+
 #include <algorithm>
 
 /**
  * \brief Constructor.
  * \param img The image to save.
  */
-claw::graphic::bitmap::writer::writer(const image& img)
+claw::graphic::bitmap::writer::writer(const const_image_view& img)
   : m_image(img)
 {}
 
@@ -44,7 +46,8 @@ claw::graphic::bitmap::writer::writer(const image& img)
  * \param img The image to save.
  * \param f The file in which we save the data.
  */
-claw::graphic::bitmap::writer::writer(const image& img, std::ostream& f)
+claw::graphic::bitmap::writer::writer(const const_image_view& img,
+                                      std::ostream& f)
   : m_image(img)
 {
   save(f);
@@ -80,36 +83,21 @@ void claw::graphic::bitmap::writer::save_data(std::ostream& f) const
 
   char* buffer = new char[buffer_size];
 
+  // The padding is the same for every line.
+  std::fill(buffer + m_image.width() * 3, buffer + buffer_size, 0);
+
   for(line = m_image.height(); line > 0;)
     {
       --line;
-      pixel32_to_pixel24(buffer, m_image[line]);
+      pixel_kernels::convert_to(reinterpret_cast<unsigned char*>(buffer),
+                                pixel_kernels::bgr24, m_image[line],
+                                m_image.width());
       f.write(buffer, buffer_size);
     }
 
   delete[] buffer;
 }
 
-/**
- * \brief Converts a pixel32 scanline to a BGR array.
- * \param dest (out) Filled array.
- * \param src Scanline to convert.
- */
-void claw::graphic::bitmap::writer::pixel32_to_pixel24(
-    char* dest, const scanline& src) const
-{
-  unsigned int i24 = 0;
-  scanline::const_iterator first(src.begin());
-  scanline::const_iterator last(src.end());
-
-  for(; first != last; ++first)
-    {
-      dest[i24++] = first->components.blue;
-      dest[i24++] = first->components.green;
-      dest[i24++] = first->components.red;
-    }
-}
-
 /**
  * \brief Initialize header's data, for saving.
  * \param h Header to initialize.
@@ -0,0 +1,285 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file format_registry.cpp
+ * \brief Implementation of the claw::graphic::format_registry class.
+ * \author Julien Jorge
+ */
+#include <claw/graphic/format_registry.hpp>
+
+#include <claw/assert.hpp>
+#include <claw/exception.hpp>
+#include <claw/graphic/bitmap.hpp>
+#include <claw/graphic/gif.hpp>
+#include <claw/graphic/pcx.hpp>
+#include <claw/graphic/targa.hpp>
+#include <claw/graphic/xbm.hpp>
+
+/* The png.h file must be included before any other file that includes setjmp.h
+   (as jpeg.hpp). */
+#include <claw/graphic/png.hpp>
+
+#include <claw/graphic/jpeg.hpp>
+
+#include <algorithm>
+
+namespace claw
+{
+  namespace graphic
+  {
+    namespace
+    {
+      /**
+       * \brief Read an image with a given reader, not buffering the stream.
+       * \param img The image in which the data will be stored.
+       * \param f The stream from which we read the data.
+       */
+      template <typename Reader>
+      void read_with(image& img, std::istream& f, std::vector<char>&)
+      {
+        Reader(img, f);
+      }
+
+      /**
+       * \brief Read an image with a given reader, buffering the stream in a
+       *        storage provided by the caller.
+       * \param img The image in which the data will be stored.
+       * \param f The stream from which we read the data.
+       * \param buffer The storage of the buffer of the reader.
+       */
+      template <typename Reader>
+      void read_buffered_with(image& img, std::istream& f,
+                              std::vector<char>& buffer)
+      {
+        Reader(img, f, buffer);
+      }
+
+      /**
+       * \brief Create a registry of the formats supported by claw::graphic.
+       */
+      format_registry make_default_registry()
+      {
+        format_registry result;
+
+        result.add_format("jpeg", { "\xFF\xD8\xFF" },
+                          &read_with<jpeg::reader>);
+        result.add_format("png", { "\x89PNG\r\n\x1A\n" },
+                          &read_with<png::reader>);
+        result.add_format("bitmap", { "BM" },
+                          &read_buffered_with<bitmap::reader>);
+        result.add_format("targa", &read_buffered_with<targa::reader>);
+        result.add_format("gif", { "GIF87a", "GIF89a" },
+                          &read_with<gif::reader>);
+        result.add_format("pcx", { "\x0A" }, &read_buffered_with<pcx::reader>);
+        result.add_format("xbm", &read_with<xbm::reader>);
+
+        return result;
+      }
+    }
+  }
+}
+
+/**
+ * \brief Constructor. Creates a registry without any format.
+ */
+claw::graphic::format_registry::format_registry()
+  : m_header_length(0)
+{}
+
+/**
+ * \brief Register a format identified by the first bytes of its files.
+ * \param name The name of the format.
+ * \param signatures The first bytes of the files of this format, any of them
+ *        identifying the format.
+ * \param read The function reading the files of this format.
+ * \pre signatures is not empty.
+ */
+void claw::graphic::format_registry::add_format(
+    const std::string& name, const std::vector<std::string>& signatures,
+    const reader_function& read)
+{
+  CLAW_PRECOND(!signatures.empty());
+
+  format fmt;
+  fmt.name = name;
+  fmt.signatures = signatures;
+  fmt.read = read;
+
+  for(std::size_t i = 0; i != signatures.size(); ++i)
+    m_header_length = std::max(m_header_length, signatures[i].size());
+
+  m_formats.push_back(fmt);
+}
+
+/**
+ * \brief Register a format whose files can't be identified by their first
+ *        bytes.
+ * \param name The name of the format.
+ * \param read The function reading the files of this format.
+ *
+ * The reader of this format is tried only when the ones of the formats whose
+ * signature matches the stream have failed.
+ */
+void claw::graphic::format_registry::add_format(const std::string& name,
+                                                const reader_function& read)
+{
+  format fmt;
+  fmt.name = name;
+  fmt.read = read;
+
+  m_formats.push_back(fmt);
+}
+
+/**
+ * \brief Get the name of the first format whose signature matches the first
+ *        bytes of a stream, or an empty string if there is no such format.
+ * \param f The stream to check. Its position is restored before returning.
+ */
+std::string claw::graphic::format_registry::detect(std::istream& f) const
+{
+  const std::string header(read_header(f));
+
+  for(std::size_t i = 0; i != m_formats.size(); ++i)
+    if(matches(m_formats[i], header))
+      return m_formats[i].name;
+
+  return std::string();
+}
+
+/**
+ * \brief Read an image from a stream, with the reader of the format of the
+ *        stream.
+ * \param img The image in which the data will be stored.
+ * \param f The stream from which we read the data.
+ */
+void claw::graphic::format_registry::load(image& img, std::istream& f) const
+{
+  std::vector<char> buffer;
+  load(img, f, buffer);
+}
+
+/**
+ * \brief Read an image from a stream, with the reader of the format of the
+ *        stream.
+ * \param img The image in which the data will be stored.
+ * \param f The stream from which we read the data.
+ * \param buffer The storage used by the readers to buffer the stream. It
+ *        keeps its size after the call, so passing the same vector for
+ *        several images avoids allocating a buffer for each of them.
+ */
+void claw::graphic::format_registry::load(image& img, std::istream& f,
+                                          std::vector<char>& buffer) const
+{
+  const std::string header(read_header(f));
+
+  for(std::size_t i = 0; i != m_formats.size(); ++i)
+    if(matches(m_formats[i], header)
+       && try_read(m_formats[i], img, f, buffer))
+      return;
+
+  for(std::size_t i = 0; i != m_formats.size(); ++i)
+    if(m_formats[i].signatures.empty()
+       && try_read(m_formats[i], img, f, buffer))
+      return;
+
+  throw claw::bad_format("image::load: file format isn't supported.");
+}
+
+/**
+ * \brief Get the registry of the formats supported by claw::graphic, used by
+ *        image::load().
+ *
+ * The formats added to this registry are also loaded by image::load(). The
+ * formats supported by claw::graphic are registered on the first call.
+ */
+claw::graphic::format_registry& claw::graphic::format_registry::get_default()
+{
+  static format_registry result(make_default_registry());
+
+  return result;
+}
+
+/**
+ * \brief Read the bytes compared with the signatures at the beginning of a
+ *        stream.
+ * \param f The stream to read. Its position is restored before returning.
+ */
+std::string
+claw::graphic::format_registry::read_header(std::istream& f) const
+{
+  const std::istream::pos_type init_pos = f.tellg();
+  std::string result(m_header_length, '\0');
+
+  f.read(&result[0], m_header_length);
+  result.resize(f.gcount());
+
+  f.clear();
+  f.seekg(init_pos, std::ios_base::beg);
+
+  return result;
+}
+
+/**
+ * \brief Tell if a header begins with one of the signatures of a format.
+ * \param fmt The format.
+ * \param header The first bytes of the stream.
+ */
+bool claw::graphic::format_registry::matches(const format& fmt,
+                                             const std::string& header) const
+{
+  for(std::size_t i = 0; i != fmt.signatures.size(); ++i)
+    if(header.compare(0, fmt.signatures[i].size(), fmt.signatures[i]) == 0)
+      return true;
+
+  return false;
+}
+
+/**
+ * \brief Read an image with the reader of a format.
+ * \param fmt The format.
+ * \param img The image in which the data will be stored.
+ * \param f The stream from which we read the data. Its position is restored
+ *        if the reader fails.
+ * \param buffer The storage used by the reader to buffer the stream.
+ * \return true if the reader succeeded.
+ */
+bool claw::graphic::format_registry::try_read(const format& fmt, image& img,
+                                              std::istream& f,
+                                              std::vector<char>& buffer) const
+{
+  const std::istream::pos_type init_pos = f.tellg();
+
+  try
+    {
+      fmt.read(img, f, buffer);
+      return true;
+    }
+  catch(...)
+    {
+      f.clear();
+      f.seekg(init_pos, std::ios_base::beg);
+      return false;
+    }
+}
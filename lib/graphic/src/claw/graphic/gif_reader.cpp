@@ -358,6 +358,7 @@ void claw::graphic::gif::reader::inside_load(std::istream& f)
   std::istream::pos_type init_pos = f.tellg();
   reader_info info;
   info.palette = NULL;
+  info.transparent_color_index = -1;
 
   try
     {
@@ -696,10 +697,10 @@ void claw::graphic::gif::reader::decode_data(std::istream& f,
   f.read(reinterpret_cast<char*>(&code_size), sizeof(code_size));
   input_buffer input(f, code_size);
   output_buffer output(palette, id, transparent_color_index, the_frame);
+  gif_lzw_decoder decoder;
 
   do
     {
-      gif_lzw_decoder decoder;
       input.reset();
       decoder.decode(input, output);
     }
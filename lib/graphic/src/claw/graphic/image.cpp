@@ -29,90 +29,88 @@
  */
 #include <claw/graphic/image.hpp>
 
-#include <claw/exception.hpp>
-#include <claw/graphic/bitmap.hpp>
-#include <claw/graphic/gif.hpp>
-#include <claw/graphic/pcx.hpp>
-#include <claw/graphic/targa.hpp>
-#include <claw/graphic/xbm.hpp>
-
-/* The png.h file must be included before any other file that includes setjmp.h
-   (as jpeg.hpp). */
-#include <claw/graphic/png.hpp>
-
-#include <claw/graphic/jpeg.hpp>
+#include <claw/imemory_stream.hpp>
+#include <claw/graphic/format_registry.hpp>
+#include <claw/graphic/image_view.hpp>
 
 #include <algorithm>
+#include <cstdint>
 
-/**
- * \brief Get an iterator on the first pixel.
- */
-claw::graphic::image::scanline::iterator
-claw::graphic::image::scanline::begin()
-{
-  return super::begin();
-}
+const std::size_t claw::graphic::image::alignment;
 
 /**
- * \brief Get en iterator past the last pixel.
+ * \brief Constructor. Creates an image without datas.
+ * \post width() == height() == 0
  */
-claw::graphic::image::scanline::iterator claw::graphic::image::scanline::end()
-{
-  return super::end();
-}
+claw::graphic::image::image()
+  : m_pixels(NULL)
+  , m_width(0)
+  , m_height(0)
+{}
 
 /**
- * \brief Get an iterator on constant data on the first pixel.
+ * \brief Constructor. Reads an image from an input stream.
+ * \param f The stream to read from.
  */
-claw::graphic::image::scanline::const_iterator
-claw::graphic::image::scanline::begin() const
+claw::graphic::image::image(std::istream& f)
+  : m_pixels(NULL)
+  , m_width(0)
+  , m_height(0)
 {
-  return super::begin();
+  load(f);
 }
 
 /**
- * \brief Get an iterator on constant data past the last pixel.
+ * \brief Constructor. Creates an empty image.
+ * \param w Image's width.
+ * \param h Image's height.
+ * \pre w > 0 and h > 0
  */
-claw::graphic::image::scanline::const_iterator
-claw::graphic::image::scanline::end() const
+claw::graphic::image::image(unsigned int w, unsigned int h)
+  : m_pixels(NULL)
+  , m_width(0)
+  , m_height(0)
 {
-  return super::end();
+  set_size(w, h);
 }
 
 /**
- * \brief Get the length of the line.
+ * \brief Copy constructor.
+ * \param that The pixels to copy.
  */
-claw::graphic::image::scanline::size_type
-claw::graphic::image::scanline::size() const
+claw::graphic::image::image(const image& that)
+  : m_pixels(NULL)
+  , m_width(0)
+  , m_height(0)
 {
-  return super::size();
+  if((that.m_width != 0) && (that.m_height != 0))
+    {
+      allocate(that.m_width, that.m_height);
+      std::copy(that.m_pixels,
+                that.m_pixels + (std::size_t)m_width * m_height, m_pixels);
+    }
 }
 
 /**
- * \brief Constructor. Creates an image without datas.
- * \post width() == height() == 0
+ * \brief Move constructor.
+ * \param that The image whose pixels are taken. It is left empty.
  */
-claw::graphic::image::image()
-{}
-
-/**
- * \brief Constructor. Reads an image from an input stream.
- * \param f The stream to read from.
- */
-claw::graphic::image::image(std::istream& f)
+claw::graphic::image::image(image&& that)
+  : m_pixels(NULL)
+  , m_width(0)
+  , m_height(0)
 {
-  load(f);
+  swap(that);
 }
 
 /**
- * \brief Constructor. Creates an empty image.
- * \param w Image's width.
- * \param h Image's height.
- * \pre w > 0 and h > 0
+ * \brief Assignment.
+ * \param that The pixels to copy.
  */
-claw::graphic::image::image(unsigned int w, unsigned int h)
+claw::graphic::image& claw::graphic::image::operator=(image that)
 {
-  set_size(w, h);
+  swap(that);
+  return *this;
 }
 
 /**
@@ -121,7 +119,11 @@ claw::graphic::image::image(unsigned int w, unsigned int h)
  */
 void claw::graphic::image::swap(image& that)
 {
-  std::swap(m_data, that.m_data);
+  std::swap(m_memory, that.m_memory);
+  std::swap(m_pixels, that.m_pixels);
+  std::swap(m_width, that.m_width);
+  std::swap(m_height, that.m_height);
+  std::swap(m_lines, that.m_lines);
 }
 
 /**
@@ -129,10 +131,7 @@ void claw::graphic::image::swap(image& that)
  */
 unsigned int claw::graphic::image::width() const
 {
-  if(m_data.empty())
-    return 0;
-  else
-    return m_data[0].size();
+  return m_width;
 }
 
 /**
@@ -140,7 +139,7 @@ unsigned int claw::graphic::image::width() const
  */
 unsigned int claw::graphic::image::height() const
 {
-  return m_data.size();
+  return m_height;
 }
 
 /**
@@ -177,96 +176,61 @@ claw::graphic::image::const_iterator claw::graphic::image::end() const
 
 /**
  * \brief Merge an image on the current image.
- * \param that The image to merge.
+ * \param that The pixels to merge.
  */
-void claw::graphic::image::merge(const image& that)
+void claw::graphic::image::merge(const const_image_view& that)
 {
   merge(that, math::coordinate_2d<int>(0, 0));
 }
 
 /**
  * \brief Merge an image on the current image.
- * \param that The image to merge.
+ * \param that The pixels to merge.
  * \param pos The position of the top left corner.
  */
-void claw::graphic::image::merge(const image& that,
+void claw::graphic::image::merge(const const_image_view& that,
                                  const math::coordinate_2d<int>& pos)
 {
-  math::rectangle<int> my_box(0, 0, width(), height());
-  math::rectangle<int> his_box(pos.x, pos.y, that.width(), that.height());
+  image_view(*this).merge(that, pos);
+}
 
-  if(my_box.intersects(his_box))
-    {
-      math::rectangle<int> intersection;
-      unsigned int that_y = pos.y < 0 ? -pos.y : 0;
-      unsigned int that_x = pos.x < 0 ? -pos.x : 0;
-      const double max_comp(
-          std::numeric_limits<rgba_pixel::component_type>::max());
-
-      intersection = my_box.intersection(his_box);
-
-      for(int y = 0; y != intersection.height; ++y)
-        {
-          scanline::const_iterator first = that[y + that_y].begin() + that_x;
-          scanline::const_iterator last = first + intersection.width;
-          scanline::iterator dest
-              = (*this)[y + intersection.position.y].begin()
-                + intersection.position.x;
-
-          for(; first != last; ++first, ++dest)
-            {
-              const double src_alpha(first->components.alpha);
-              const double dest_alpha(dest->components.alpha
-                                      * (max_comp - src_alpha));
-
-              const double red = (double)first->components.red * src_alpha
-                                 + (double)dest->components.red * dest_alpha;
-              const double green
-                  = (double)first->components.green * src_alpha
-                    + (double)dest->components.green * dest_alpha;
-              const double blue = (double)first->components.blue * src_alpha
-                                  + (double)dest->components.blue * dest_alpha;
-              const double alpha = src_alpha + dest_alpha;
-
-              dest->components.red = std::min(red, max_comp);
-              dest->components.green = std::min(green, max_comp);
-              dest->components.blue = std::min(blue, max_comp);
-              dest->components.alpha = std::min(alpha, max_comp);
-            }
-        }
-    }
+/**
+ * \brief Merge an image on the current image, the lines being processed
+ *        concurrently on a thread pool.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner.
+ * \param pool The threads processing the lines.
+ */
+void claw::graphic::image::merge(const const_image_view& that,
+                                 const math::coordinate_2d<int>& pos,
+                                 thread_pool& pool)
+{
+  image_view(*this).merge(that, pos, pool);
 }
 
 /**
  * \brief Copy an image on the current image.
- * \param that The image to copy.
+ * \param that The pixels to copy.
  * \param pos The position of the top left corner.
  */
-void claw::graphic::image::partial_copy(const image& that,
+void claw::graphic::image::partial_copy(const const_image_view& that,
                                         const math::coordinate_2d<int>& pos)
 {
-  math::rectangle<int> my_box(0, 0, width(), height());
-  math::rectangle<int> his_box(pos.x, pos.y, that.width(), that.height());
+  image_view(*this).partial_copy(that, pos);
+}
 
-  if(my_box.intersects(his_box))
-    {
-      math::rectangle<int> intersection;
-      unsigned int that_y = pos.y < 0 ? -pos.y : 0;
-      unsigned int that_x = pos.x < 0 ? -pos.x : 0;
-
-      intersection = my_box.intersection(his_box);
-
-      for(int y = 0; y != intersection.height; ++y)
-        {
-          scanline::const_iterator first = that[y + that_y].begin() + that_x;
-          scanline::const_iterator last = first + intersection.width;
-          scanline::iterator dest
-              = (*this)[y + intersection.position.y].begin()
-                + intersection.position.x;
-
-          std::copy(first, last, dest);
-        }
-    }
+/**
+ * \brief Copy an image on the current image, the lines being processed
+ *        concurrently on a thread pool.
+ * \param that The pixels to copy.
+ * \param pos The position of the top left corner.
+ * \param pool The threads processing the lines.
+ */
+void claw::graphic::image::partial_copy(const const_image_view& that,
+                                        const math::coordinate_2d<int>& pos,
+                                        thread_pool& pool)
+{
+  image_view(*this).partial_copy(that, pos, pool);
 }
 
 /**
@@ -275,7 +239,8 @@ void claw::graphic::image::partial_copy(const image& that,
 void claw::graphic::image::flip()
 {
   for(unsigned int y = 0; y != height() / 2; ++y)
-    std::swap(m_data[y], m_data[height() - y - 1]);
+    std::swap_ranges(m_lines[y].begin(), m_lines[y].end(),
+                     m_lines[height() - y - 1].begin());
 }
 
 /**
@@ -286,42 +251,20 @@ void claw::graphic::image::flip()
 void claw::graphic::image::fill(const math::rectangle<int> r,
                                 const pixel_type& c)
 {
-  math::rectangle<int> my_box(0, 0, width(), height());
+  image_view(*this).fill(r, c);
+}
 
-  if(my_box.intersects(r))
-    {
-      const math::rectangle<int> intersection(my_box.intersection(r));
-      const double max_comp(
-          std::numeric_limits<rgba_pixel::component_type>::max());
-
-      for(int y = 0; y != intersection.height; ++y)
-        {
-          scanline::iterator first
-              = (*this)[intersection.position.y + y].begin()
-                + intersection.position.x;
-          const scanline::iterator last = first + intersection.width;
-
-          for(; first != last; ++first)
-            {
-              const double src_alpha(c.components.alpha);
-
-              double red = (double)first->components.red
-                           + src_alpha * (double)c.components.red / max_comp;
-              double green
-                  = (double)first->components.green
-                    + src_alpha * (double)c.components.green / max_comp;
-              double blue = (double)first->components.blue
-                            + src_alpha * (double)c.components.blue / max_comp;
-              double alpha = (double)first->components.alpha
-                             + (max_comp - src_alpha) / max_comp;
-
-              first->components.red = std::min(red, max_comp);
-              first->components.green = std::min(green, max_comp);
-              first->components.blue = std::min(blue, max_comp);
-              first->components.alpha = std::min(alpha, max_comp);
-            }
-        }
-    }
+/**
+ * \brief Fill an area of the image with a given color, the lines being
+ *        processed concurrently on a thread pool.
+ * \param r The area to fill.
+ * \param c The color to fill with.
+ * \param pool The threads processing the lines.
+ */
+void claw::graphic::image::fill(const math::rectangle<int> r,
+                                const pixel_type& c, thread_pool& pool)
+{
+  image_view(*this).fill(r, c, pool);
 }
 
 /**
@@ -332,90 +275,79 @@ void claw::graphic::image::fill(const math::rectangle<int> r,
  */
 void claw::graphic::image::set_size(unsigned int w, unsigned int h)
 {
-  if(w == 0)
-    m_data.clear();
-  else
+  if((w == m_width) && (h == m_height))
+    return;
+
+  image result;
+
+  if((w != 0) && (h != 0))
     {
-      m_data.resize(h);
+      result.allocate(w, h);
 
-      for(unsigned int y = 0; y != height(); ++y)
-        m_data[y].resize(w);
+      const unsigned int copy_width = std::min(w, m_width);
+      const unsigned int copy_height = std::min(h, m_height);
+
+      for(unsigned int y = 0; y != copy_height; ++y)
+        std::copy(m_lines[y].begin(), m_lines[y].begin() + copy_width,
+                  result.m_lines[y].begin());
     }
+
+  swap(result);
+}
+
+/**
+ * \brief Allocate the memory for the pixels and set up the lines, without
+ *        initializing the pixels.
+ * \param w The width of the image.
+ * \param h The height of the image.
+ * \pre (w!=0) && (h!=0) and the image has no pixels.
+ */
+void claw::graphic::image::allocate(unsigned int w, unsigned int h)
+{
+  CLAW_PRECOND(m_pixels == NULL);
+
+  const std::size_t count = (std::size_t)w * h;
+
+  m_memory.reset(new char[count * sizeof(pixel_type) + alignment - 1]);
+
+  const std::uintptr_t address =
+      reinterpret_cast<std::uintptr_t>(m_memory.get());
+  m_pixels = reinterpret_cast<pixel_type*>((address + alignment - 1)
+                                           & ~(std::uintptr_t)(alignment - 1));
+  m_width = w;
+  m_height = h;
+
+  m_lines.reserve(h);
+
+  for(unsigned int y = 0; y != h; ++y)
+    m_lines.push_back(scanline(m_pixels + (std::size_t)y * w, w));
 }
 
 /**
  * \brief Read the image from a stream.
  * \param f The stream to read from.
+ *
+ * The format of the stream is detected from its first bytes, with the formats
+ * of format_registry::get_default().
  */
 void claw::graphic::image::load(std::istream& f)
 {
-  bool ok = false;
-
-  if(!ok)
-    try
-      {
-        jpeg::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    try
-      {
-        png::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    try
-      {
-        bitmap::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    try
-      {
-        targa::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    try
-      {
-        gif::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    try
-      {
-        pcx::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    try
-      {
-        xbm::reader(*this, f);
-        ok = true;
-      }
-    catch(...)
-      {}
-
-  if(!ok)
-    throw claw::bad_format("image::load: file format isn't supported.");
+  format_registry::get_default().load(*this, f);
+}
+
+/**
+ * \brief Read the image from a memory area, for example the content of a
+ *        claw::memory_mapped_file.
+ * \param data The encoded image.
+ * \param size The size of the encoded image.
+ *
+ * The memory area is read through a claw::imemory_stream, thus the readers
+ * still copy the data in their own buffers, as for any other stream.
+ */
+void claw::graphic::image::load(const char* data, std::size_t size)
+{
+  imemory_stream f(data, size);
+  load(f);
 }
 
 /**
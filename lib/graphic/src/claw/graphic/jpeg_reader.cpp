@@ -30,6 +30,7 @@
 #include <claw/graphic/jpeg.hpp>
 
 #include <claw/graphic/jpeg_error_manager.hpp>
+#include <claw/graphic/pixel_kernels.hpp>
 
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
@@ -163,37 +164,33 @@ void claw::graphic::jpeg::reader::source_manager::skip_input_data(
 }
 
 /**
- * \brief Convert a RGB pixel to a ARGB pixel.
+ * \brief Convert a line of RGB pixels to ARGB pixels.
+ * \param dest (out) The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the line.
  */
-claw::graphic::rgba_pixel_8
-claw::graphic::jpeg::reader::RGB_to_pixel32::operator()(
-    const JSAMPLE* pixel) const
+void claw::graphic::jpeg::reader::RGB_to_pixel32::operator()(
+    rgba_pixel_8* dest, const JSAMPLE* src, unsigned int n) const
 {
-  rgba_pixel_8 result;
-
-  result.components.alpha = 255;
-  result.components.red = pixel[0];
-  result.components.green = pixel[1];
-  result.components.blue = pixel[2];
-
-  return result;
+  pixel_kernels::convert_from(dest, src, pixel_kernels::rgb24, n);
 }
 
 /**
- * \brief Convert a grey level pixel to a ARGB pixel.
+ * \brief Convert a line of grey level pixels to ARGB pixels.
+ * \param dest (out) The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the line.
  */
-claw::graphic::rgba_pixel_8
-claw::graphic::jpeg::reader::grayscale_to_pixel32::operator()(
-    const JSAMPLE* pixel) const
+void claw::graphic::jpeg::reader::grayscale_to_pixel32::operator()(
+    rgba_pixel_8* dest, const JSAMPLE* src, unsigned int n) const
 {
-  rgba_pixel_8 result;
-
-  result.components.alpha = 255;
-  result.components.red = pixel[0];
-  result.components.green = pixel[0];
-  result.components.blue = pixel[0];
-
-  return result;
+  for(unsigned int i = 0; i != n; ++i)
+    {
+      dest[i].components.alpha = 255;
+      dest[i].components.red = src[i];
+      dest[i].components.green = src[i];
+      dest[i].components.blue = src[i];
+    }
 }
 
 /**
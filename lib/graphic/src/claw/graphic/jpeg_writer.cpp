@@ -30,6 +30,7 @@
 #include <claw/graphic/jpeg.hpp>
 
 #include <claw/graphic/jpeg_error_manager.hpp>
+#include <claw/graphic/pixel_kernels.hpp>
 
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
@@ -147,7 +148,7 @@ const unsigned int claw::graphic::jpeg::writer::s_rgb_pixel_size = 3;
  * \brief Constructor.
  * \param img The image in which the data will be stored.
  */
-claw::graphic::jpeg::writer::writer(const image& img)
+claw::graphic::jpeg::writer::writer(const const_image_view& img)
   : m_image(img)
 {}
 
@@ -157,8 +158,8 @@ claw::graphic::jpeg::writer::writer(const image& img)
  * \param f The file in which we write the data.
  * \param opt Options about the saved file.
  */
-claw::graphic::jpeg::writer::writer(const image& img, std::ostream& f,
-                                    const options& opt)
+claw::graphic::jpeg::writer::writer(const const_image_view& img,
+                                    std::ostream& f, const options& opt)
   : m_image(img)
 {
   save(f, opt);
@@ -272,12 +273,8 @@ void claw::graphic::jpeg::writer::copy_pixel_line(JSAMPLE* data,
   CLAW_PRECOND(y < m_image.height());
 
   // three bytes for each pixel in the line
-  for(unsigned int x = 0; x != m_image.width(); ++x, data += s_rgb_pixel_size)
-    {
-      data[0] = m_image[y][x].components.red;
-      data[1] = m_image[y][x].components.green;
-      data[2] = m_image[y][x].components.blue;
-    }
+  pixel_kernels::convert_to(data, pixel_kernels::rgb24, m_image[y],
+                            m_image.width());
 }
 
 /**
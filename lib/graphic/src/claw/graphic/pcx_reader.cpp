@@ -31,6 +31,7 @@
 
 #include <claw/exception.hpp>
 
+#include <algorithm>
 #include <limits>
 
 /**
@@ -172,8 +173,8 @@ void claw::graphic::pcx::reader::rle_pcx_output_buffer::fill(unsigned int n,
 {
   CLAW_PRECOND(m_position + n <= m_result.size());
 
-  for(unsigned int i = 0; i != n; ++i)
-    m_result[m_position + i] = pattern;
+  std::fill(m_result.begin() + m_position, m_result.begin() + m_position + n,
+            pattern);
 
   m_position += n;
 }
@@ -201,11 +202,13 @@ bool claw::graphic::pcx::reader::rle_pcx_output_buffer::completed() const
  * \brief Get the type of the following data in the input buffer.
  * \param input The input stream (the pcx file).
  * \param output The output stream (the pcx image).
+ * \param packet (out) The header of the next packet.
  */
-void claw::graphic::pcx::reader::rle_pcx_decoder::read_mode(
-    input_buffer_type& input, output_buffer_type& output)
+void claw::graphic::pcx::reader::rle_pcx_mode_reader::read_mode(
+    rle_pcx_input_buffer& input, rle_pcx_output_buffer& output,
+    rle_packet<u_int_8>& packet) const
 {
-  this->m_mode = this->stop;
+  packet.mode = packet.stop;
   bool ok = !output.completed();
 
   if(ok && (input.remaining() < 1))
@@ -214,21 +217,21 @@ void claw::graphic::pcx::reader::rle_pcx_decoder::read_mode(
   if(ok)
     {
       unsigned char key = input.get_next();
-      this->m_mode = this->compressed;
+      packet.mode = packet.compressed;
 
       if((key & 0xC0) == 0xC0)
         {
-          this->m_count = key & 0x3F;
+          packet.count = key & 0x3F;
 
           if(input.remaining() < 1)
             input.read_more(1);
 
-          this->m_pattern = input.get_next();
+          packet.pattern = input.get_next();
         }
       else
         {
-          this->m_count = 1;
-          this->m_pattern = key;
+          packet.count = 1;
+          packet.pattern = key;
         }
     }
 }
@@ -239,6 +242,18 @@ void claw::graphic::pcx::reader::rle_pcx_decoder::read_mode(
  */
 claw::graphic::pcx::reader::reader(image& img)
   : m_image(img)
+  , m_buffer(m_own_buffer)
+{}
+
+/**
+ * \brief Constructor.
+ * \param img The image in which the data will be stored.
+ * \param buffer The storage of the input buffers, reused for each file read
+ *        by this reader. It must outlive this instance.
+ */
+claw::graphic::pcx::reader::reader(image& img, std::vector<char>& buffer)
+  : m_image(img)
+  , m_buffer(buffer)
 {}
 
 /**
@@ -249,6 +264,23 @@ claw::graphic::pcx::reader::reader(image& img)
  */
 claw::graphic::pcx::reader::reader(image& img, std::istream& f)
   : m_image(img)
+  , m_buffer(m_own_buffer)
+{
+  load(f);
+}
+
+/**
+ * \brief Constructor.
+ * \param img The image in which the data will be stored.
+ * \param f The file from which we read the data.
+ * \param buffer The storage of the input buffers. It must outlive this
+ *        instance.
+ * \post img contains the data from \a f.
+ */
+claw::graphic::pcx::reader::reader(image& img, std::istream& f,
+                                    std::vector<char>& buffer)
+  : m_image(img)
+  , m_buffer(buffer)
 {
   load(f);
 }
@@ -410,14 +442,13 @@ void claw::graphic::pcx::reader::load_256_color_mapped(const header& h,
 }
 
 /**
- * \brief Load the 8 bpp color mapped pcx content.
- * \param f The file from which we read.
+ * \brief Decompress a scan line.
+ * \param input The buffer from which we read the compressed data.
  * \param scanline (out) Uncompressed scan line.
  */
 void claw::graphic::pcx::reader::decompress_line(
-    std::istream& f, color_plane_type& scanline) const
+    rle_pcx_input_buffer& input, color_plane_type& scanline) const
 {
-  rle_pcx_input_buffer input(f);
   rle_pcx_output_buffer output(scanline);
 
   rle_pcx_decoder decoder;
@@ -46,13 +46,19 @@ claw::graphic::pcx::writer::file_output_buffer::file_output_buffer(
 void claw::graphic::pcx::writer::file_output_buffer::encode(
     unsigned int n, pattern_type pattern)
 {
+  u_int_8 packet[2];
+  std::size_t length = 0;
+
   if((pattern > 63) || (n > 1))
     {
-      u_int_8 cnt = 0xC0 | (u_int_8)n;
-      m_stream.write(reinterpret_cast<char*>(&cnt), sizeof(u_int_8));
+      packet[length] = 0xC0 | (u_int_8)n;
+      ++length;
     }
 
-  m_stream.write(reinterpret_cast<char*>(&pattern), sizeof(u_int_8));
+  packet[length] = pattern;
+  ++length;
+
+  m_stream.write(reinterpret_cast<char*>(packet), length);
 }
 
 /**
@@ -77,7 +83,7 @@ claw::graphic::pcx::writer::file_output_buffer::max_encodable() const
  * \brief Constructor.
  * \param img The image to save.
  */
-claw::graphic::pcx::writer::writer(const image& img)
+claw::graphic::pcx::writer::writer(const const_image_view& img)
   : m_image(img)
 {}
 
@@ -86,7 +92,8 @@ claw::graphic::pcx::writer::writer(const image& img)
  * \param img The image to save.
  * \param f The file in which we save the data.
  */
-claw::graphic::pcx::writer::writer(const image& img, std::ostream& f)
+claw::graphic::pcx::writer::writer(const const_image_view& img,
+                                   std::ostream& f)
   : m_image(img)
 {
   save(f);
@@ -155,18 +162,18 @@ void claw::graphic::pcx::writer::save_rle_true_color(
       for(unsigned int x = 0; x != m_image.width(); ++x)
         data[x] = m_image[y][x].components.red;
 
-      encoder.encode(data.begin(), data.end(), output);
+      encoder.encode(data.data(), data.data() + data.size(), output);
 
       // green
       for(unsigned int x = 0; x != m_image.width(); ++x)
         data[x] = m_image[y][x].components.green;
 
-      encoder.encode(data.begin(), data.end(), output);
+      encoder.encode(data.data(), data.data() + data.size(), output);
 
       // blue
       for(unsigned int x = 0; x != m_image.width(); ++x)
         data[x] = m_image[y][x].components.blue;
 
-      encoder.encode(data.begin(), data.end(), output);
+      encoder.encode(data.data(), data.data() + data.size(), output);
     }
 }
@@ -0,0 +1,1860 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file pixel_kernels.cpp
+ * \brief Implementation of the claw::graphic::pixel_kernels class.
+ * \author Julien Jorge
+ */
+#include <claw/graphic/pixel_kernels.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CLAW_PIXEL_KERNELS_AVX2
+#endif
+
+namespace claw
+{
+  namespace graphic
+  {
+#if defined(__SSE2__)
+    /**
+     * \brief Blend four components of two pixels with the formula of
+     *        pixel_kernels::merge_scalar().
+     * \param s The components of the source pixels, on 16 bits.
+     * \param d The components of the destination pixels, on 16 bits.
+     *
+     * The color components are multiplied by the alpha of their pixel while
+     * the alpha components are multiplied by one, such that a single
+     * sequence of operations computes all the components. The products
+     * exceeding 16 bits are saturated, which does not change the result since
+     * it is clamped to 255 anyway.
+     */
+    static inline __m128i blend_sse2(__m128i s, __m128i d)
+    {
+      const __m128i zero(_mm_setzero_si128());
+      const __m128i ones(_mm_cmpeq_epi16(zero, zero));
+      const __m128i max_comp(_mm_set1_epi16(255));
+      const __m128i color_mask(_mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1));
+      const __m128i alpha_one(_mm_set_epi16(1, 0, 0, 0, 1, 0, 0, 0));
+
+      const __m128i src_alpha(
+          _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF));
+      const __m128i dest_alpha(
+          _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xFF), 0xFF));
+      const __m128i k(_mm_sub_epi16(max_comp, src_alpha));
+
+      const __m128i src_term(_mm_mullo_epi16(
+          s, _mm_or_si128(_mm_and_si128(src_alpha, color_mask), alpha_one)));
+      const __m128i dest_weight(_mm_mullo_epi16(
+          d, _mm_or_si128(_mm_and_si128(dest_alpha, color_mask), alpha_one)));
+
+      const __m128i high(_mm_mulhi_epu16(dest_weight, k));
+      const __m128i dest_term(
+          _mm_or_si128(_mm_mullo_epi16(dest_weight, k),
+                       _mm_andnot_si128(_mm_cmpeq_epi16(high, zero), ones)));
+
+      const __m128i sum(_mm_adds_epu16(src_term, dest_term));
+
+      return _mm_sub_epi16(sum, _mm_subs_epu16(sum, max_comp));
+    }
+#endif
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+    /**
+     * \brief Blend eight components of four pixels with the formula of
+     *        pixel_kernels::merge_scalar().
+     * \param s The components of the source pixels, on 16 bits.
+     * \param d The components of the destination pixels, on 16 bits.
+     *
+     * See blend_sse2() for the details.
+     */
+    __attribute__((target("avx2"))) static inline __m256i
+    blend_avx2(__m256i s, __m256i d)
+    {
+      const __m256i zero(_mm256_setzero_si256());
+      const __m256i ones(_mm256_cmpeq_epi16(zero, zero));
+      const __m256i max_comp(_mm256_set1_epi16(255));
+      const __m256i color_mask(_mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1,
+                                                0, -1, -1, -1, 0, -1, -1, -1));
+      const __m256i alpha_one(_mm256_set_epi16(1, 0, 0, 0, 1, 0, 0, 0, 1, 0,
+                                               0, 0, 1, 0, 0, 0));
+
+      const __m256i src_alpha(
+          _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF));
+      const __m256i dest_alpha(
+          _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(d, 0xFF), 0xFF));
+      const __m256i k(_mm256_sub_epi16(max_comp, src_alpha));
+
+      const __m256i src_term(_mm256_mullo_epi16(
+          s, _mm256_or_si256(_mm256_and_si256(src_alpha, color_mask),
+                             alpha_one)));
+      const __m256i dest_weight(_mm256_mullo_epi16(
+          d, _mm256_or_si256(_mm256_and_si256(dest_alpha, color_mask),
+                             alpha_one)));
+
+      const __m256i high(_mm256_mulhi_epu16(dest_weight, k));
+      const __m256i dest_term(_mm256_or_si256(
+          _mm256_mullo_epi16(dest_weight, k),
+          _mm256_andnot_si256(_mm256_cmpeq_epi16(high, zero), ones)));
+
+      const __m256i sum(_mm256_adds_epu16(src_term, dest_term));
+
+      return _mm256_sub_epi16(sum, _mm256_subs_epu16(sum, max_comp));
+    }
+#endif
+
+    /**
+     * \brief The factors by which the components of a premultiplied pixel
+     *        are multiplied to restore its colors, for each alpha.
+     *
+     * The factor of an alpha a is ceil(255 * 256 / a), such that the color
+     * is (c * factor) >> 8 and a color equal to the alpha gives 255. The
+     * factor of the null alpha is zero, giving black transparent pixels.
+     */
+    class unpremultiply_factors
+    {
+    public:
+      unpremultiply_factors()
+      {
+        factor[0] = 0;
+
+        for(unsigned int a = 1; a != 256; ++a)
+          factor[a] = (255 * 256 + a - 1) / a;
+      }
+
+    public:
+      /** \brief The factor of each alpha. */
+      std::uint16_t factor[256];
+
+    }; // class unpremultiply_factors
+
+    /** \brief The factors restoring the colors of premultiplied pixels. */
+    static const unpremultiply_factors g_unpremultiply;
+
+#if defined(__SSE2__)
+    /**
+     * \brief Compute the luminosity of four pixels with the formula of
+     *        rgba_pixel::luminosity().
+     * \param p The pixels.
+     * \return The luminosity of each pixel, in the 32 bits lanes.
+     */
+    static inline __m128i luminosity_sse2(__m128i p)
+    {
+      const __m128i zero(_mm_setzero_si128());
+      const __m128i weights(_mm_set_epi16(0, 18, 54, 183, 0, 18, 54, 183));
+
+      // The weighted red and green are summed in the even 32 bits lanes and
+      // the weighted blue is alone in the odd lanes.
+      __m128i low(_mm_madd_epi16(_mm_unpacklo_epi8(p, zero), weights));
+      __m128i high(_mm_madd_epi16(_mm_unpackhi_epi8(p, zero), weights));
+
+      low = _mm_add_epi32(low, _mm_srli_epi64(low, 32));
+      high = _mm_add_epi32(high, _mm_srli_epi64(high, 32));
+
+      const __m128i sum(
+          _mm_unpacklo_epi64(_mm_shuffle_epi32(low, _MM_SHUFFLE(3, 3, 2, 0)),
+                             _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 2, 0))));
+
+      return _mm_srli_epi32(sum, 8);
+    }
+
+    /**
+     * \brief Multiply the colors of eight components of two pixels by their
+     *        alpha with the formula of pixel_kernels::premultiply_scalar().
+     * \param p The components of the pixels, on 16 bits.
+     */
+    static inline __m128i premultiply_components_sse2(__m128i p)
+    {
+      const __m128i color_mask(_mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1));
+      const __m128i alpha_one(_mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+      const __m128i rounding(_mm_set1_epi16(128));
+
+      const __m128i alpha(
+          _mm_shufflehi_epi16(_mm_shufflelo_epi16(p, 0xFF), 0xFF));
+      const __m128i t(_mm_add_epi16(
+          _mm_mullo_epi16(
+              p, _mm_or_si128(_mm_and_si128(alpha, color_mask), alpha_one)),
+          rounding));
+
+      return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+#endif
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+    /**
+     * \brief Compute the luminosity of eight pixels with the formula of
+     *        rgba_pixel::luminosity().
+     * \param p The pixels.
+     * \return The luminosity of each pixel, in the 32 bits lanes.
+     *
+     * See luminosity_sse2() for the details.
+     */
+    __attribute__((target("avx2"))) static inline __m256i
+    luminosity_avx2(__m256i p)
+    {
+      const __m256i zero(_mm256_setzero_si256());
+      const __m256i weights(_mm256_set_epi16(0, 18, 54, 183, 0, 18, 54, 183,
+                                             0, 18, 54, 183, 0, 18, 54, 183));
+
+      __m256i low(_mm256_madd_epi16(_mm256_unpacklo_epi8(p, zero), weights));
+      __m256i high(_mm256_madd_epi16(_mm256_unpackhi_epi8(p, zero), weights));
+
+      low = _mm256_add_epi32(low, _mm256_srli_epi64(low, 32));
+      high = _mm256_add_epi32(high, _mm256_srli_epi64(high, 32));
+
+      const __m256i sum(_mm256_unpacklo_epi64(
+          _mm256_shuffle_epi32(low, _MM_SHUFFLE(3, 3, 2, 0)),
+          _mm256_shuffle_epi32(high, _MM_SHUFFLE(3, 3, 2, 0))));
+
+      return _mm256_srli_epi32(sum, 8);
+    }
+
+    /**
+     * \brief Multiply the colors of sixteen components of four pixels by
+     *        their alpha with the formula of
+     *        pixel_kernels::premultiply_scalar().
+     * \param p The components of the pixels, on 16 bits.
+     */
+    __attribute__((target("avx2"))) static inline __m256i
+    premultiply_components_avx2(__m256i p)
+    {
+      const __m256i color_mask(_mm256_set_epi16(0, -1, -1, -1, 0, -1, -1, -1,
+                                                0, -1, -1, -1, 0, -1, -1, -1));
+      const __m256i alpha_one(_mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0,
+                                               255, 0, 0, 0, 255, 0, 0, 0));
+      const __m256i rounding(_mm256_set1_epi16(128));
+
+      const __m256i alpha(
+          _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(p, 0xFF), 0xFF));
+      const __m256i t(_mm256_add_epi16(
+          _mm256_mullo_epi16(p, _mm256_or_si256(
+                                    _mm256_and_si256(alpha, color_mask),
+                                    alpha_one)),
+          rounding));
+
+      return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)),
+                               8);
+    }
+#endif
+
+#if defined(__SSE2__)
+    /**
+     * \brief Compute the part of eight components of two premultiplied
+     *        pixels remaining under other pixels, with the formula of
+     *        pixel_kernels::merge_premultiplied_scalar().
+     * \param s The components of the pixels put over, on 16 bits.
+     * \param d The components of the pixels under them, on 16 bits.
+     */
+    static inline __m128i uncovered_sse2(__m128i s, __m128i d)
+    {
+      const __m128i max_comp(_mm_set1_epi16(255));
+      const __m128i rounding(_mm_set1_epi16(128));
+
+      const __m128i k(_mm_sub_epi16(
+          max_comp, _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF)));
+      const __m128i t(_mm_add_epi16(_mm_mullo_epi16(d, k), rounding));
+
+      return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+#endif
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+    /**
+     * \brief Compute the part of sixteen components of four premultiplied
+     *        pixels remaining under other pixels, with the formula of
+     *        pixel_kernels::merge_premultiplied_scalar().
+     * \param s The components of the pixels put over, on 16 bits.
+     * \param d The components of the pixels under them, on 16 bits.
+     */
+    __attribute__((target("avx2"))) static inline __m256i
+    uncovered_avx2(__m256i s, __m256i d)
+    {
+      const __m256i max_comp(_mm256_set1_epi16(255));
+      const __m256i rounding(_mm256_set1_epi16(128));
+
+      const __m256i k(_mm256_sub_epi16(
+          max_comp,
+          _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF)));
+      const __m256i t(_mm256_add_epi16(_mm256_mullo_epi16(d, k), rounding));
+
+      return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)),
+                               8);
+    }
+#endif
+  }
+}
+
+/**
+ * \brief Get the fastest implementation supported by the processor running
+ *        the program.
+ */
+claw::graphic::pixel_kernels::implementation
+claw::graphic::pixel_kernels::best_implementation()
+{
+  if(has_avx2())
+    return avx2;
+
+#if defined(__SSE2__)
+  return sse2;
+#else
+  return scalar;
+#endif
+}
+
+/**
+ * \brief Merge some pixels on other pixels, with the fastest implementation.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels to merge.
+ *
+ * See merge_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::merge(rgba_pixel* dest,
+                                         const rgba_pixel* src, std::size_t n)
+{
+  merge(dest, src, n, avx2);
+}
+
+/**
+ * \brief Merge some pixels on other pixels.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels to merge.
+ * \param impl The fastest implementation allowed. A slower one is used if the
+ *        processor does not support it.
+ *
+ * See merge_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::merge(rgba_pixel* dest,
+                                         const rgba_pixel* src, std::size_t n,
+                                         implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = merge_avx2(dest, src, n);
+
+  if(impl >= sse2)
+    i += merge_sse2(dest + i, src + i, n - i);
+
+  merge_scalar(dest + i, src + i, n - i);
+}
+
+/**
+ * \brief Merge the blocks of four pixels of a span with the SSE2
+ *        instructions.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels in the span.
+ * \return The number of merged pixels.
+ */
+std::size_t claw::graphic::pixel_kernels::merge_sse2(rgba_pixel* dest,
+                                                     const rgba_pixel* src,
+                                                     std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+
+  for(; n - i >= 4; i += 4)
+    {
+      const __m128i s(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+      const __m128i d(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i)));
+
+      const __m128i low(blend_sse2(_mm_unpacklo_epi8(s, zero),
+                                   _mm_unpacklo_epi8(d, zero)));
+      const __m128i high(blend_sse2(_mm_unpackhi_epi8(s, zero),
+                                    _mm_unpackhi_epi8(d, zero)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                       _mm_packus_epi16(low, high));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Merge the blocks of eight pixels of a span with the AVX2
+ *        instructions.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels in the span.
+ * \return The number of merged pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::merge_avx2(rgba_pixel* dest,
+                                         const rgba_pixel* src, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i zero(_mm256_setzero_si256());
+
+  for(; n - i >= 8; i += 8)
+    {
+      const __m256i s(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+      const __m256i d(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i)));
+
+      const __m256i low(blend_avx2(_mm256_unpacklo_epi8(s, zero),
+                                   _mm256_unpacklo_epi8(d, zero)));
+      const __m256i high(blend_avx2(_mm256_unpackhi_epi8(s, zero),
+                                    _mm256_unpackhi_epi8(d, zero)));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                          _mm256_packus_epi16(low, high));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Merge some pixels on other pixels, one by one.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels to merge.
+ *
+ * With the components in [0, 255] and k = 255 - src.alpha, each color
+ * component c becomes min(255, src.c * src.alpha + dest.c * dest.alpha * k)
+ * and the alpha becomes min(255, src.alpha + dest.alpha * k). All the terms
+ * are integers, thus this is exactly what image::merge() used to compute in
+ * double precision.
+ */
+void claw::graphic::pixel_kernels::merge_scalar(rgba_pixel* dest,
+                                                const rgba_pixel* src,
+                                                std::size_t n)
+{
+  const unsigned int max_comp(255);
+
+  for(std::size_t i = 0; i != n; ++i)
+    {
+      const unsigned int src_alpha(src[i].components.alpha);
+      const unsigned int dest_alpha(dest[i].components.alpha
+                                    * (max_comp - src_alpha));
+
+      const unsigned int red(src[i].components.red * src_alpha
+                             + dest[i].components.red * dest_alpha);
+      const unsigned int green(src[i].components.green * src_alpha
+                               + dest[i].components.green * dest_alpha);
+      const unsigned int blue(src[i].components.blue * src_alpha
+                              + dest[i].components.blue * dest_alpha);
+      const unsigned int alpha(src_alpha + dest_alpha);
+
+      dest[i].components.red = std::min(red, max_comp);
+      dest[i].components.green = std::min(green, max_comp);
+      dest[i].components.blue = std::min(blue, max_comp);
+      dest[i].components.alpha = std::min(alpha, max_comp);
+    }
+}
+
+/**
+ * \brief Merge some premultiplied pixels on other premultiplied pixels, with
+ *        the fastest implementation.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels to merge.
+ *
+ * See merge_premultiplied_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::merge_premultiplied(rgba_pixel* dest,
+                                                       const rgba_pixel* src,
+                                                       std::size_t n)
+{
+  merge_premultiplied(dest, src, n, avx2);
+}
+
+/**
+ * \brief Merge some premultiplied pixels on other premultiplied pixels.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels to merge.
+ * \param impl The fastest implementation allowed. A slower one is used if the
+ *        processor does not support it.
+ *
+ * See merge_premultiplied_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::merge_premultiplied(rgba_pixel* dest,
+                                                       const rgba_pixel* src,
+                                                       std::size_t n,
+                                                       implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = merge_premultiplied_avx2(dest, src, n);
+
+  if(impl >= sse2)
+    i += merge_premultiplied_sse2(dest + i, src + i, n - i);
+
+  merge_premultiplied_scalar(dest + i, src + i, n - i);
+}
+
+/**
+ * \brief Merge the blocks of four premultiplied pixels of a span with the
+ *        SSE2 instructions.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels in the span.
+ * \return The number of merged pixels.
+ */
+std::size_t claw::graphic::pixel_kernels::merge_premultiplied_sse2(
+    rgba_pixel* dest, const rgba_pixel* src, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+
+  for(; n - i >= 4; i += 4)
+    {
+      const __m128i s(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+      const __m128i d(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i)));
+
+      const __m128i low(uncovered_sse2(_mm_unpacklo_epi8(s, zero),
+                                       _mm_unpacklo_epi8(d, zero)));
+      const __m128i high(uncovered_sse2(_mm_unpackhi_epi8(s, zero),
+                                        _mm_unpackhi_epi8(d, zero)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                       _mm_adds_epu8(s, _mm_packus_epi16(low, high)));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Merge the blocks of eight premultiplied pixels of a span with the
+ *        AVX2 instructions.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels in the span.
+ * \return The number of merged pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t claw::graphic::pixel_kernels::merge_premultiplied_avx2(
+    rgba_pixel* dest, const rgba_pixel* src, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i zero(_mm256_setzero_si256());
+
+  for(; n - i >= 8; i += 8)
+    {
+      const __m256i s(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+      const __m256i d(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i)));
+
+      const __m256i low(uncovered_avx2(_mm256_unpacklo_epi8(s, zero),
+                                       _mm256_unpacklo_epi8(d, zero)));
+      const __m256i high(uncovered_avx2(_mm256_unpackhi_epi8(s, zero),
+                                        _mm256_unpackhi_epi8(d, zero)));
+
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(dest + i),
+          _mm256_adds_epu8(s, _mm256_packus_epi16(low, high)));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Merge some premultiplied pixels on other premultiplied pixels, one
+ *        by one.
+ * \param dest The pixels on which the merge is done.
+ * \param src The pixels to merge.
+ * \param n The number of pixels to merge.
+ *
+ * Each component d of a destination pixel, the alpha included, becomes
+ * s + d * (255 - a) / 255, where s is the same component of the source pixel
+ * and a its alpha. The division is rounded to the nearest integer and the
+ * sum is saturated at 255, which only happens if a color of a pixel is
+ * greater than its alpha.
+ */
+void claw::graphic::pixel_kernels::merge_premultiplied_scalar(
+    rgba_pixel* dest, const rgba_pixel* src, std::size_t n)
+{
+  const unsigned int max_comp(255);
+
+  for(std::size_t i = 0; i != n; ++i)
+    {
+      const unsigned int k(max_comp - src[i].components.alpha);
+
+      const unsigned int red(dest[i].components.red * k + 128);
+      const unsigned int green(dest[i].components.green * k + 128);
+      const unsigned int blue(dest[i].components.blue * k + 128);
+      const unsigned int alpha(dest[i].components.alpha * k + 128);
+
+      dest[i].components.red = std::min(
+          max_comp, src[i].components.red + ((red + (red >> 8)) >> 8));
+      dest[i].components.green = std::min(
+          max_comp, src[i].components.green + ((green + (green >> 8)) >> 8));
+      dest[i].components.blue = std::min(
+          max_comp, src[i].components.blue + ((blue + (blue >> 8)) >> 8));
+      dest[i].components.alpha = std::min(
+          max_comp, src[i].components.alpha + ((alpha + (alpha >> 8)) >> 8));
+    }
+}
+
+/**
+ * \brief Add a color to some pixels, component by component, with the
+ *        fastest implementation.
+ * \param dest The pixels to which the color is added.
+ * \param n The number of pixels.
+ * \param c The color to add.
+ *
+ * The components are saturated at 255.
+ */
+void claw::graphic::pixel_kernels::add(rgba_pixel* dest, std::size_t n,
+                                       const rgba_pixel& c)
+{
+  add(dest, n, c, avx2);
+}
+
+/**
+ * \brief Add a color to some pixels, component by component.
+ * \param dest The pixels to which the color is added.
+ * \param n The number of pixels.
+ * \param c The color to add.
+ * \param impl The fastest implementation allowed. A slower one is used if the
+ *        processor does not support it.
+ *
+ * The components are saturated at 255.
+ */
+void claw::graphic::pixel_kernels::add(rgba_pixel* dest, std::size_t n,
+                                       const rgba_pixel& c,
+                                       implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = add_avx2(dest, n, c);
+
+  if(impl >= sse2)
+    i += add_sse2(dest + i, n - i, c);
+
+  add_scalar(dest + i, n - i, c);
+}
+
+/**
+ * \brief Set some pixels to a color, with the fastest implementation.
+ * \param dest The pixels to set.
+ * \param n The number of pixels.
+ * \param c The color of the pixels.
+ */
+void claw::graphic::pixel_kernels::fill(rgba_pixel* dest, std::size_t n,
+                                        const rgba_pixel& c)
+{
+  fill(dest, n, c, avx2);
+}
+
+/**
+ * \brief Set some pixels to a color.
+ * \param dest The pixels to set.
+ * \param n The number of pixels.
+ * \param c The color of the pixels.
+ * \param impl The fastest implementation allowed. A slower one is used if the
+ *        processor does not support it.
+ */
+void claw::graphic::pixel_kernels::fill(rgba_pixel* dest, std::size_t n,
+                                        const rgba_pixel& c,
+                                        implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = fill_avx2(dest, n, c);
+
+  if(impl >= sse2)
+    i += fill_sse2(dest + i, n - i, c);
+
+  fill_scalar(dest + i, n - i, c);
+}
+
+/**
+ * \brief Add a color to the blocks of four pixels of a span with the SSE2
+ *        instructions.
+ * \param dest The pixels to which the color is added.
+ * \param n The number of pixels in the span.
+ * \param c The color to add.
+ * \return The number of processed pixels.
+ */
+std::size_t claw::graphic::pixel_kernels::add_sse2(rgba_pixel* dest,
+                                                   std::size_t n,
+                                                   const rgba_pixel& c)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i color(_mm_set1_epi32(c.pixel));
+
+  for(; n - i >= 4; i += 4)
+    {
+      __m128i* const p(reinterpret_cast<__m128i*>(dest + i));
+      _mm_storeu_si128(p, _mm_adds_epu8(_mm_loadu_si128(p), color));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Add a color to the blocks of eight pixels of a span with the AVX2
+ *        instructions.
+ * \param dest The pixels to which the color is added.
+ * \param n The number of pixels in the span.
+ * \param c The color to add.
+ * \return The number of processed pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::add_avx2(rgba_pixel* dest, std::size_t n,
+                                       const rgba_pixel& c)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i color(_mm256_set1_epi32(c.pixel));
+
+  for(; n - i >= 8; i += 8)
+    {
+      __m256i* const p(reinterpret_cast<__m256i*>(dest + i));
+      _mm256_storeu_si256(p, _mm256_adds_epu8(_mm256_loadu_si256(p), color));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Add a color to some pixels, one by one.
+ * \param dest The pixels to which the color is added.
+ * \param n The number of pixels.
+ * \param c The color to add.
+ */
+void claw::graphic::pixel_kernels::add_scalar(rgba_pixel* dest, std::size_t n,
+                                              const rgba_pixel& c)
+{
+  const unsigned int max_comp(255);
+
+  for(std::size_t i = 0; i != n; ++i)
+    {
+      dest[i].components.red = std::min(
+          max_comp, (unsigned int)dest[i].components.red + c.components.red);
+      dest[i].components.green =
+          std::min(max_comp, (unsigned int)dest[i].components.green
+                                 + c.components.green);
+      dest[i].components.blue = std::min(
+          max_comp, (unsigned int)dest[i].components.blue + c.components.blue);
+      dest[i].components.alpha =
+          std::min(max_comp, (unsigned int)dest[i].components.alpha
+                                 + c.components.alpha);
+    }
+}
+
+/**
+ * \brief Set the blocks of four pixels of a span to a color with the SSE2
+ *        instructions.
+ * \param dest The pixels to set.
+ * \param n The number of pixels in the span.
+ * \param c The color of the pixels.
+ * \return The number of processed pixels.
+ */
+std::size_t claw::graphic::pixel_kernels::fill_sse2(rgba_pixel* dest,
+                                                    std::size_t n,
+                                                    const rgba_pixel& c)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i color(_mm_set1_epi32(c.pixel));
+
+  for(; n - i >= 4; i += 4)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), color);
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Set the blocks of eight pixels of a span to a color with the AVX2
+ *        instructions.
+ * \param dest The pixels to set.
+ * \param n The number of pixels in the span.
+ * \param c The color of the pixels.
+ * \return The number of processed pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::fill_avx2(rgba_pixel* dest, std::size_t n,
+                                        const rgba_pixel& c)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i color(_mm256_set1_epi32(c.pixel));
+
+  for(; n - i >= 8; i += 8)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), color);
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Set some pixels to a color, one by one.
+ * \param dest The pixels to set.
+ * \param n The number of pixels.
+ * \param c The color of the pixels.
+ */
+void claw::graphic::pixel_kernels::fill_scalar(rgba_pixel* dest, std::size_t n,
+                                               const rgba_pixel& c)
+{
+  for(std::size_t i = 0; i != n; ++i)
+    dest[i].pixel = c.pixel;
+}
+
+/**
+ * \brief Convert some pixels to gray levels, with the fastest
+ *        implementation.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ *
+ * See grayscale_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::grayscale(rgba_pixel* dest,
+                                             const rgba_pixel* src,
+                                             std::size_t n)
+{
+  grayscale(dest, src, n, avx2);
+}
+
+/**
+ * \brief Convert some pixels to gray levels.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ * \param impl The implementation to use. If the processor does not support
+ *        it, the fastest supported implementation is used.
+ *
+ * See grayscale_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::grayscale(rgba_pixel* dest,
+                                             const rgba_pixel* src,
+                                             std::size_t n,
+                                             implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = grayscale_avx2(dest, src, n);
+
+  if(impl >= sse2)
+    i += grayscale_sse2(dest + i, src + i, n - i);
+
+  grayscale_scalar(dest + i, src + i, n - i);
+}
+
+/**
+ * \brief Multiply the colors of some pixels by their alpha, with the fastest
+ *        implementation.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ *
+ * See premultiply_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::premultiply(rgba_pixel* dest,
+                                               const rgba_pixel* src,
+                                               std::size_t n)
+{
+  premultiply(dest, src, n, avx2);
+}
+
+/**
+ * \brief Multiply the colors of some pixels by their alpha.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ * \param impl The implementation to use. If the processor does not support
+ *        it, the fastest supported implementation is used.
+ *
+ * See premultiply_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::premultiply(rgba_pixel* dest,
+                                               const rgba_pixel* src,
+                                               std::size_t n,
+                                               implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = premultiply_avx2(dest, src, n);
+
+  if(impl >= sse2)
+    i += premultiply_sse2(dest + i, src + i, n - i);
+
+  premultiply_scalar(dest + i, src + i, n - i);
+}
+
+/**
+ * \brief Divide the colors of some premultiplied pixels by their alpha, with
+ *        the fastest implementation.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ *
+ * See unpremultiply_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::unpremultiply(rgba_pixel* dest,
+                                                 const rgba_pixel* src,
+                                                 std::size_t n)
+{
+  unpremultiply(dest, src, n, avx2);
+}
+
+/**
+ * \brief Divide the colors of some premultiplied pixels by their alpha.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ * \param impl The implementation to use. If the processor does not support
+ *        it, the fastest supported implementation is used.
+ *
+ * See unpremultiply_scalar() for the formula.
+ */
+void claw::graphic::pixel_kernels::unpremultiply(rgba_pixel* dest,
+                                                 const rgba_pixel* src,
+                                                 std::size_t n,
+                                                 implementation impl)
+{
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = unpremultiply_avx2(dest, src, n);
+
+  if(impl >= sse2)
+    i += unpremultiply_sse2(dest + i, src + i, n - i);
+
+  unpremultiply_scalar(dest + i, src + i, n - i);
+}
+
+/**
+ * \brief Get the number of bytes of a pixel in a given format.
+ * \param f The format of the pixel.
+ */
+std::size_t claw::graphic::pixel_kernels::bytes_per_pixel(pixel_format f)
+{
+  if((f == rgb24) || (f == bgr24))
+    return 3;
+  else
+    return 4;
+}
+
+/**
+ * \brief Write some pixels in a buffer of bytes, with the fastest
+ *        implementation.
+ * \param dest The buffer receiving the pixels.
+ * \param f The format of the pixels in \a dest.
+ * \param src The pixels to write.
+ * \param n The number of pixels.
+ * \pre \a dest can receive n * bytes_per_pixel(f) bytes.
+ */
+void claw::graphic::pixel_kernels::convert_to(unsigned char* dest,
+                                              pixel_format f,
+                                              const rgba_pixel* src,
+                                              std::size_t n)
+{
+  convert_to(dest, f, src, n, avx2);
+}
+
+/**
+ * \brief Write some pixels in a buffer of bytes.
+ * \param dest The buffer receiving the pixels.
+ * \param f The format of the pixels in \a dest.
+ * \param src The pixels to write.
+ * \param n The number of pixels.
+ * \param impl The implementation to use. If the processor does not support
+ *        it, the fastest supported implementation is used.
+ * \pre \a dest can receive n * bytes_per_pixel(f) bytes.
+ */
+void claw::graphic::pixel_kernels::convert_to(unsigned char* dest,
+                                              pixel_format f,
+                                              const rgba_pixel* src,
+                                              std::size_t n,
+                                              implementation impl)
+{
+  const std::size_t size = bytes_per_pixel(f);
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = convert_to_avx2(dest, f, src, n);
+
+  if(impl >= sse2)
+    i += convert_to_sse2(dest + i * size, f, src + i, n - i);
+
+  convert_to_scalar(dest + i * size, f, src + i, n - i);
+}
+
+/**
+ * \brief Read some pixels from a buffer of bytes, with the fastest
+ *        implementation.
+ * \param dest The pixels read.
+ * \param src The buffer containing the pixels.
+ * \param f The format of the pixels in \a src.
+ * \param n The number of pixels.
+ *
+ * The alpha of the pixels is 255 when the format has no alpha.
+ */
+void claw::graphic::pixel_kernels::convert_from(rgba_pixel* dest,
+                                                const unsigned char* src,
+                                                pixel_format f, std::size_t n)
+{
+  convert_from(dest, src, f, n, avx2);
+}
+
+/**
+ * \brief Read some pixels from a buffer of bytes.
+ * \param dest The pixels read.
+ * \param src The buffer containing the pixels.
+ * \param f The format of the pixels in \a src.
+ * \param n The number of pixels.
+ * \param impl The implementation to use. If the processor does not support
+ *        it, the fastest supported implementation is used.
+ *
+ * The alpha of the pixels is 255 when the format has no alpha.
+ */
+void claw::graphic::pixel_kernels::convert_from(rgba_pixel* dest,
+                                                const unsigned char* src,
+                                                pixel_format f, std::size_t n,
+                                                implementation impl)
+{
+  const std::size_t size = bytes_per_pixel(f);
+  std::size_t i = 0;
+
+  if(impl >= avx2)
+    i = convert_from_avx2(dest, src, f, n);
+
+  if(impl >= sse2)
+    i += convert_from_sse2(dest + i, src + i * size, f, n - i);
+
+  convert_from_scalar(dest + i, src + i * size, f, n - i);
+}
+
+/**
+ * \brief Convert the blocks of four pixels of a span to gray levels with the
+ *        SSE2 instructions.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the span.
+ * \return The number of converted pixels.
+ */
+std::size_t claw::graphic::pixel_kernels::grayscale_sse2(rgba_pixel* dest,
+                                                         const rgba_pixel* src,
+                                                         std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i alpha_mask(_mm_set1_epi32(0xFF000000));
+
+  for(; n - i >= 4; i += 4)
+    {
+      const __m128i p(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+      const __m128i gray(luminosity_sse2(p));
+      const __m128i colors(_mm_or_si128(
+          gray, _mm_or_si128(_mm_slli_epi32(gray, 8),
+                             _mm_slli_epi32(gray, 16))));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                       _mm_or_si128(colors, _mm_and_si128(p, alpha_mask)));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Convert the blocks of eight pixels of a span to gray levels with the
+ *        AVX2 instructions.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the span.
+ * \return The number of converted pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::grayscale_avx2(rgba_pixel* dest,
+                                             const rgba_pixel* src,
+                                             std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i alpha_mask(_mm256_set1_epi32(0xFF000000));
+
+  for(; n - i >= 8; i += 8)
+    {
+      const __m256i p(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+      const __m256i gray(luminosity_avx2(p));
+      const __m256i colors(_mm256_or_si256(
+          gray, _mm256_or_si256(_mm256_slli_epi32(gray, 8),
+                                _mm256_slli_epi32(gray, 16))));
+
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i*>(dest + i),
+          _mm256_or_si256(colors, _mm256_and_si256(p, alpha_mask)));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Convert some pixels to gray levels, one by one.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ *
+ * The red, green and blue components of each pixel are replaced by its
+ * luminosity, as computed by rgba_pixel::luminosity(). The alpha is kept.
+ */
+void claw::graphic::pixel_kernels::grayscale_scalar(rgba_pixel* dest,
+                                                    const rgba_pixel* src,
+                                                    std::size_t n)
+{
+  for(std::size_t i = 0; i != n; ++i)
+    {
+      const rgba_pixel::component_type gray(src[i].luminosity());
+
+      dest[i].components.red = gray;
+      dest[i].components.green = gray;
+      dest[i].components.blue = gray;
+      dest[i].components.alpha = src[i].components.alpha;
+    }
+}
+
+/**
+ * \brief Multiply the colors of the blocks of four pixels of a span by their
+ *        alpha with the SSE2 instructions.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the span.
+ * \return The number of converted pixels.
+ */
+std::size_t claw::graphic::pixel_kernels::premultiply_sse2(
+    rgba_pixel* dest, const rgba_pixel* src, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+
+  for(; n - i >= 4; i += 4)
+    {
+      const __m128i p(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+      const __m128i low(
+          premultiply_components_sse2(_mm_unpacklo_epi8(p, zero)));
+      const __m128i high(
+          premultiply_components_sse2(_mm_unpackhi_epi8(p, zero)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                       _mm_packus_epi16(low, high));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Multiply the colors of the blocks of eight pixels of a span by their
+ *        alpha with the AVX2 instructions.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the span.
+ * \return The number of converted pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::premultiply_avx2(rgba_pixel* dest,
+                                               const rgba_pixel* src,
+                                               std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i zero(_mm256_setzero_si256());
+
+  for(; n - i >= 8; i += 8)
+    {
+      const __m256i p(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+      const __m256i low(
+          premultiply_components_avx2(_mm256_unpacklo_epi8(p, zero)));
+      const __m256i high(
+          premultiply_components_avx2(_mm256_unpackhi_epi8(p, zero)));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                          _mm256_packus_epi16(low, high));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Multiply the colors of some pixels by their alpha, one by one.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ *
+ * Each color c of a pixel of alpha a becomes c * a / 255, rounded to the
+ * nearest integer. The alpha is kept.
+ */
+void claw::graphic::pixel_kernels::premultiply_scalar(rgba_pixel* dest,
+                                                      const rgba_pixel* src,
+                                                      std::size_t n)
+{
+  for(std::size_t i = 0; i != n; ++i)
+    {
+      const unsigned int alpha(src[i].components.alpha);
+      const unsigned int red(src[i].components.red * alpha + 128);
+      const unsigned int green(src[i].components.green * alpha + 128);
+      const unsigned int blue(src[i].components.blue * alpha + 128);
+
+      // (t + (t >> 8)) >> 8 is the exact rounded division by 255 for these
+      // values.
+      dest[i].components.red = (red + (red >> 8)) >> 8;
+      dest[i].components.green = (green + (green >> 8)) >> 8;
+      dest[i].components.blue = (blue + (blue >> 8)) >> 8;
+      dest[i].components.alpha = alpha;
+    }
+}
+
+/**
+ * \brief Divide the colors of the blocks of four premultiplied pixels of a
+ *        span by their alpha with the SSE2 instructions.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the span.
+ * \return The number of converted pixels.
+ *
+ * The factors of the pixels are loaded from the table, then the components
+ * are multiplied by their factor in 16 bits lanes.
+ */
+std::size_t claw::graphic::pixel_kernels::unpremultiply_sse2(
+    rgba_pixel* dest, const rgba_pixel* src, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+  const __m128i max_comp(_mm_set1_epi16(255));
+  const std::uint16_t* const factor(g_unpremultiply.factor);
+
+  for(; n - i >= 4; i += 4)
+    {
+      const __m128i p(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+      const std::uint16_t f0(factor[src[i].components.alpha]);
+      const std::uint16_t f1(factor[src[i + 1].components.alpha]);
+      const std::uint16_t f2(factor[src[i + 2].components.alpha]);
+      const std::uint16_t f3(factor[src[i + 3].components.alpha]);
+
+      // The alpha is multiplied by 256 / 256.
+      __m128i low(_mm_mulhi_epu16(
+          _mm_slli_epi16(_mm_unpacklo_epi8(p, zero), 8),
+          _mm_set_epi16(256, f1, f1, f1, 256, f0, f0, f0)));
+      __m128i high(_mm_mulhi_epu16(
+          _mm_slli_epi16(_mm_unpackhi_epi8(p, zero), 8),
+          _mm_set_epi16(256, f3, f3, f3, 256, f2, f2, f2)));
+
+      // The unsigned minimum with 255, since the colors may be greater
+      // than the alpha.
+      low = _mm_sub_epi16(low, _mm_subs_epu16(low, max_comp));
+      high = _mm_sub_epi16(high, _mm_subs_epu16(high, max_comp));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                       _mm_packus_epi16(low, high));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Divide the colors of the blocks of eight premultiplied pixels of a
+ *        span by their alpha with the AVX2 instructions.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels in the span.
+ * \return The number of converted pixels, zero if the processor does not
+ *         support AVX2.
+ *
+ * See unpremultiply_sse2() for the details.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::unpremultiply_avx2(rgba_pixel* dest,
+                                                 const rgba_pixel* src,
+                                                 std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i zero(_mm256_setzero_si256());
+  const __m256i max_comp(_mm256_set1_epi16(255));
+  const std::uint16_t* const factor(g_unpremultiply.factor);
+
+  for(; n - i >= 8; i += 8)
+    {
+      const __m256i p(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+      std::uint16_t f[8];
+
+      for(unsigned int j = 0; j != 8; ++j)
+        f[j] = factor[src[i + j].components.alpha];
+
+      // The unpacking works in 128 bits lanes: the low part contains the
+      // pixels 0, 1, 4 and 5, the high part contains the others.
+      __m256i low(_mm256_mulhi_epu16(
+          _mm256_slli_epi16(_mm256_unpacklo_epi8(p, zero), 8),
+          _mm256_set_epi16(256, f[5], f[5], f[5], 256, f[4], f[4], f[4], 256,
+                           f[1], f[1], f[1], 256, f[0], f[0], f[0])));
+      __m256i high(_mm256_mulhi_epu16(
+          _mm256_slli_epi16(_mm256_unpackhi_epi8(p, zero), 8),
+          _mm256_set_epi16(256, f[7], f[7], f[7], 256, f[6], f[6], f[6], 256,
+                           f[3], f[3], f[3], 256, f[2], f[2], f[2])));
+
+      low = _mm256_sub_epi16(low, _mm256_subs_epu16(low, max_comp));
+      high = _mm256_sub_epi16(high, _mm256_subs_epu16(high, max_comp));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                          _mm256_packus_epi16(low, high));
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Divide the colors of some premultiplied pixels by their alpha, one
+ *        by one.
+ * \param dest The converted pixels.
+ * \param src The pixels to convert.
+ * \param n The number of pixels.
+ *
+ * Each color c of a pixel of alpha a becomes approximately c * 255 / a,
+ * computed as (c * ceil(255 * 256 / a)) >> 8 and clamped to 255. The colors
+ * of the transparent pixels become zero. The alpha is kept.
+ */
+void claw::graphic::pixel_kernels::unpremultiply_scalar(rgba_pixel* dest,
+                                                        const rgba_pixel* src,
+                                                        std::size_t n)
+{
+  const unsigned int max_comp(255);
+
+  for(std::size_t i = 0; i != n; ++i)
+    {
+      const unsigned int alpha(src[i].components.alpha);
+      const unsigned int factor(g_unpremultiply.factor[alpha]);
+
+      dest[i].components.red =
+          std::min(max_comp, (src[i].components.red * factor) >> 8);
+      dest[i].components.green =
+          std::min(max_comp, (src[i].components.green * factor) >> 8);
+      dest[i].components.blue =
+          std::min(max_comp, (src[i].components.blue * factor) >> 8);
+      dest[i].components.alpha = alpha;
+    }
+}
+
+/**
+ * \brief Write the blocks of four pixels of a span in a buffer of bytes with
+ *        the SSE2 instructions.
+ * \param dest The buffer receiving the pixels.
+ * \param f The format of the pixels in \a dest.
+ * \param src The pixels to write.
+ * \param n The number of pixels in the span.
+ * \return The number of written pixels, zero for the formats of three bytes
+ *         per pixel, which need to shuffle the bytes, and for rgba32, which
+ *         is a plain copy.
+ */
+std::size_t claw::graphic::pixel_kernels::convert_to_sse2(
+    unsigned char* dest, pixel_format f, const rgba_pixel* src, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i green_alpha(_mm_set1_epi32(0xFF00FF00));
+  const __m128i low_byte(_mm_set1_epi32(0xFF));
+
+  if(f == bgra32)
+    for(; n - i >= 4; i += 4)
+      {
+        const __m128i p(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest + 4 * i),
+            _mm_or_si128(
+                _mm_and_si128(p, green_alpha),
+                _mm_or_si128(
+                    _mm_and_si128(_mm_srli_epi32(p, 16), low_byte),
+                    _mm_slli_epi32(_mm_and_si128(p, low_byte), 16))));
+      }
+  else if(f == argb32)
+    for(; n - i >= 4; i += 4)
+      {
+        const __m128i p(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest + 4 * i),
+            _mm_or_si128(_mm_slli_epi32(p, 8), _mm_srli_epi32(p, 24)));
+      }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Write the blocks of eight pixels of a span in a buffer of bytes with
+ *        the AVX2 instructions.
+ * \param dest The buffer receiving the pixels.
+ * \param f The format of the pixels in \a dest.
+ * \param src The pixels to write.
+ * \param n The number of pixels in the span.
+ * \return The number of written pixels, zero if the processor does not
+ *         support AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::convert_to_avx2(unsigned char* dest,
+                                              pixel_format f,
+                                              const rgba_pixel* src,
+                                              std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i green_alpha(_mm256_set1_epi32(0xFF00FF00));
+  const __m256i low_byte(_mm256_set1_epi32(0xFF));
+
+  if(f == bgra32)
+    for(; n - i >= 8; i += 8)
+      {
+        const __m256i p(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest + 4 * i),
+            _mm256_or_si256(
+                _mm256_and_si256(p, green_alpha),
+                _mm256_or_si256(
+                    _mm256_and_si256(_mm256_srli_epi32(p, 16), low_byte),
+                    _mm256_slli_epi32(_mm256_and_si256(p, low_byte), 16))));
+      }
+  else if(f == argb32)
+    for(; n - i >= 8; i += 8)
+      {
+        const __m256i p(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest + 4 * i),
+            _mm256_or_si256(_mm256_slli_epi32(p, 8),
+                            _mm256_srli_epi32(p, 24)));
+      }
+  else if((f == rgb24) || (f == bgr24))
+    {
+      // The three color bytes of each pixel are packed at the beginning of
+      // each 128 bits lane, then the two lanes are joined.
+      const __m256i shuffle(
+          (f == rgb24) ? _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13,
+                                          14, -1, -1, -1, -1, 0, 1, 2, 4, 5,
+                                          6, 8, 9, 10, 12, 13, 14, -1, -1,
+                                          -1, -1)
+                       : _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13,
+                                          12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+                                          4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                          -1, -1));
+      const __m256i join(_mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+      for(; n - i >= 8; i += 8)
+        {
+          const __m256i pixels(
+              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+          const __m256i p(_mm256_permutevar8x32_epi32(
+              _mm256_shuffle_epi8(pixels, shuffle), join));
+
+          _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 3 * i),
+                           _mm256_castsi256_si128(p));
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + 3 * i + 16),
+                           _mm256_extracti128_si256(p, 1));
+        }
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Write some pixels in a buffer of bytes, one by one.
+ * \param dest The buffer receiving the pixels.
+ * \param f The format of the pixels in \a dest.
+ * \param src The pixels to write.
+ * \param n The number of pixels.
+ */
+void claw::graphic::pixel_kernels::convert_to_scalar(unsigned char* dest,
+                                                     pixel_format f,
+                                                     const rgba_pixel* src,
+                                                     std::size_t n)
+{
+  switch(f)
+    {
+    case rgba32:
+      {
+        const unsigned char* const bytes(
+            reinterpret_cast<const unsigned char*>(src));
+        std::copy(bytes, bytes + n * sizeof(rgba_pixel), dest);
+      }
+      break;
+    case bgra32:
+      for(std::size_t i = 0; i != n; ++i, dest += 4)
+        {
+          dest[0] = src[i].components.blue;
+          dest[1] = src[i].components.green;
+          dest[2] = src[i].components.red;
+          dest[3] = src[i].components.alpha;
+        }
+      break;
+    case argb32:
+      for(std::size_t i = 0; i != n; ++i, dest += 4)
+        {
+          dest[0] = src[i].components.alpha;
+          dest[1] = src[i].components.red;
+          dest[2] = src[i].components.green;
+          dest[3] = src[i].components.blue;
+        }
+      break;
+    case rgb24:
+      for(std::size_t i = 0; i != n; ++i, dest += 3)
+        {
+          dest[0] = src[i].components.red;
+          dest[1] = src[i].components.green;
+          dest[2] = src[i].components.blue;
+        }
+      break;
+    case bgr24:
+      for(std::size_t i = 0; i != n; ++i, dest += 3)
+        {
+          dest[0] = src[i].components.blue;
+          dest[1] = src[i].components.green;
+          dest[2] = src[i].components.red;
+        }
+      break;
+    }
+}
+
+/**
+ * \brief Read the blocks of four pixels of a span from a buffer of bytes with
+ *        the SSE2 instructions.
+ * \param dest The pixels read.
+ * \param src The buffer containing the pixels.
+ * \param f The format of the pixels in \a src.
+ * \param n The number of pixels in the span.
+ * \return The number of read pixels, zero for the formats of three bytes per
+ *         pixel, which need to shuffle the bytes, and for rgba32, which is a
+ *         plain copy.
+ */
+std::size_t claw::graphic::pixel_kernels::convert_from_sse2(
+    rgba_pixel* dest, const unsigned char* src, pixel_format f, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i green_alpha(_mm_set1_epi32(0xFF00FF00));
+  const __m128i low_byte(_mm_set1_epi32(0xFF));
+
+  if(f == bgra32)
+    // Swapping the red and the blue is its own inverse.
+    for(; n - i >= 4; i += 4)
+      {
+        const __m128i p(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i)));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest + i),
+            _mm_or_si128(
+                _mm_and_si128(p, green_alpha),
+                _mm_or_si128(
+                    _mm_and_si128(_mm_srli_epi32(p, 16), low_byte),
+                    _mm_slli_epi32(_mm_and_si128(p, low_byte), 16))));
+      }
+  else if(f == argb32)
+    for(; n - i >= 4; i += 4)
+      {
+        const __m128i p(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i)));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest + i),
+            _mm_or_si128(_mm_srli_epi32(p, 8), _mm_slli_epi32(p, 24)));
+      }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Read the blocks of eight pixels of a span from a buffer of bytes
+ *        with the AVX2 instructions.
+ * \param dest The pixels read.
+ * \param src The buffer containing the pixels.
+ * \param f The format of the pixels in \a src.
+ * \param n The number of pixels in the span.
+ * \return The number of read pixels, zero if the processor does not support
+ *         AVX2.
+ */
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t
+claw::graphic::pixel_kernels::convert_from_avx2(rgba_pixel* dest,
+                                                const unsigned char* src,
+                                                pixel_format f, std::size_t n)
+{
+  std::size_t i = 0;
+
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  if(!has_avx2())
+    return 0;
+
+  const __m256i green_alpha(_mm256_set1_epi32(0xFF00FF00));
+  const __m256i low_byte(_mm256_set1_epi32(0xFF));
+
+  if(f == bgra32)
+    for(; n - i >= 8; i += 8)
+      {
+        const __m256i p(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(src + 4 * i)));
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest + i),
+            _mm256_or_si256(
+                _mm256_and_si256(p, green_alpha),
+                _mm256_or_si256(
+                    _mm256_and_si256(_mm256_srli_epi32(p, 16), low_byte),
+                    _mm256_slli_epi32(_mm256_and_si256(p, low_byte), 16))));
+      }
+  else if(f == argb32)
+    for(; n - i >= 8; i += 8)
+      {
+        const __m256i p(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(src + 4 * i)));
+
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest + i),
+            _mm256_or_si256(_mm256_srli_epi32(p, 8),
+                            _mm256_slli_epi32(p, 24)));
+      }
+  else if((f == rgb24) || (f == bgr24))
+    {
+      // The twenty four bytes of eight pixels are split in the two 128 bits
+      // lanes, then the bytes of each pixel are spread in a 32 bits lane.
+      const __m256i split(_mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0));
+      const __m256i shuffle(
+          (f == rgb24) ? _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8,
+                                          -1, 9, 10, 11, -1, 0, 1, 2, -1, 3,
+                                          4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                                          -1)
+                       : _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6,
+                                          -1, 11, 10, 9, -1, 2, 1, 0, -1, 5,
+                                          4, 3, -1, 8, 7, 6, -1, 11, 10, 9,
+                                          -1));
+      const __m256i alpha(_mm256_set1_epi32(0xFF000000));
+
+      for(; n - i >= 8; i += 8)
+        {
+          const __m256i p(_mm256_inserti128_si256(
+              _mm256_castsi128_si256(_mm_loadu_si128(
+                  reinterpret_cast<const __m128i*>(src + 3 * i))),
+              _mm_loadl_epi64(
+                  reinterpret_cast<const __m128i*>(src + 3 * i + 16)),
+              1));
+
+          _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(dest + i),
+              _mm256_or_si256(
+                  _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(p, split),
+                                      shuffle),
+                  alpha));
+        }
+    }
+#endif
+
+  return i;
+}
+
+/**
+ * \brief Read some pixels from a buffer of bytes, one by one.
+ * \param dest The pixels read.
+ * \param src The buffer containing the pixels.
+ * \param f The format of the pixels in \a src.
+ * \param n The number of pixels.
+ */
+void claw::graphic::pixel_kernels::convert_from_scalar(
+    rgba_pixel* dest, const unsigned char* src, pixel_format f, std::size_t n)
+{
+  switch(f)
+    {
+    case rgba32:
+      std::copy(src, src + n * sizeof(rgba_pixel),
+                reinterpret_cast<unsigned char*>(dest));
+      break;
+    case bgra32:
+      for(std::size_t i = 0; i != n; ++i, src += 4)
+        {
+          dest[i].components.red = src[2];
+          dest[i].components.green = src[1];
+          dest[i].components.blue = src[0];
+          dest[i].components.alpha = src[3];
+        }
+      break;
+    case argb32:
+      for(std::size_t i = 0; i != n; ++i, src += 4)
+        {
+          dest[i].components.red = src[1];
+          dest[i].components.green = src[2];
+          dest[i].components.blue = src[3];
+          dest[i].components.alpha = src[0];
+        }
+      break;
+    case rgb24:
+      for(std::size_t i = 0; i != n; ++i, src += 3)
+        {
+          dest[i].components.red = src[0];
+          dest[i].components.green = src[1];
+          dest[i].components.blue = src[2];
+          dest[i].components.alpha = 255;
+        }
+      break;
+    case bgr24:
+      for(std::size_t i = 0; i != n; ++i, src += 3)
+        {
+          dest[i].components.red = src[2];
+          dest[i].components.green = src[1];
+          dest[i].components.blue = src[0];
+          dest[i].components.alpha = 255;
+        }
+      break;
+    }
+}
+
+/**
+ * \brief Tell if the processor running the program supports the AVX2
+ *        instructions.
+ */
+bool claw::graphic::pixel_kernels::has_avx2()
+{
+#if defined(CLAW_PIXEL_KERNELS_AVX2)
+  // The processor is checked once, on the first call.
+  static const bool result((__builtin_cpu_init(),
+                            __builtin_cpu_supports("avx2")));
+  return result;
+#else
+  return false;
+#endif
+}
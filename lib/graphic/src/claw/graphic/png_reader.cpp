@@ -29,6 +29,8 @@
  */
 #include <claw/graphic/png.hpp>
 
+#include <claw/graphic/pixel_kernels.hpp>
+
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
 
@@ -316,14 +318,8 @@ void claw::graphic::png::reader::copy_pixel_line(png_byte color_type,
       }
   else
     // There is four bytes for each pixel in the line.
-    for(unsigned int x = 0; x != m_image.width();
-        ++x, data += s_rgba_pixel_size)
-      {
-        m_image[y][x].components.red = data[0];
-        m_image[y][x].components.green = data[1];
-        m_image[y][x].components.blue = data[2];
-        m_image[y][x].components.alpha = data[3];
-      }
+    pixel_kernels::convert_from(m_image[y].begin(), data,
+                                pixel_kernels::rgba32, m_image.width());
 }
 
 /**
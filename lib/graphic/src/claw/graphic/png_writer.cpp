@@ -29,6 +29,8 @@
  */
 #include <claw/graphic/png.hpp>
 
+#include <claw/graphic/pixel_kernels.hpp>
+
 #include <claw/assert.hpp>
 #include <claw/exception.hpp>
 
@@ -114,7 +116,7 @@ const unsigned int claw::graphic::png::writer::s_rgba_pixel_size = 4;
  * \brief Constructor.
  * \param img The image in which the data will be stored.
  */
-claw::graphic::png::writer::writer(const image& img)
+claw::graphic::png::writer::writer(const const_image_view& img)
   : m_image(img)
 {}
 
@@ -124,8 +126,8 @@ claw::graphic::png::writer::writer(const image& img)
  * \param f The file in which we write the data.
  * \param opt Saving options.
  */
-claw::graphic::png::writer::writer(const image& img, std::ostream& f,
-                                   const options& opt)
+claw::graphic::png::writer::writer(const const_image_view& img,
+                                   std::ostream& f, const options& opt)
   : m_image(img)
 {
   save(f, opt);
@@ -245,13 +247,8 @@ void claw::graphic::png::writer::copy_pixel_line(png_bytep data,
   CLAW_PRECOND(y < m_image.height());
 
   // four bytes for each pixel in the line
-  for(unsigned int x = 0; x != m_image.width(); ++x, data += s_rgba_pixel_size)
-    {
-      data[0] = m_image[y][x].components.red;
-      data[1] = m_image[y][x].components.green;
-      data[2] = m_image[y][x].components.blue;
-      data[3] = m_image[y][x].components.alpha;
-    }
+  pixel_kernels::convert_to(data, pixel_kernels::rgba32, m_image[y],
+                            m_image.width());
 }
 
 /**
@@ -0,0 +1,300 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file premultiplied_image.cpp
+ * \brief Implementation of the claw::graphic::premultiplied_image class.
+ * \author Julien Jorge
+ */
+#include <claw/graphic/premultiplied_image.hpp>
+
+#include <claw/imemory_stream.hpp>
+#include <claw/parallel_for.hpp>
+#include <claw/graphic/format_registry.hpp>
+#include <claw/graphic/pixel_kernels.hpp>
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * \brief Constructor. Creates an image without pixels.
+ * \post width() == height() == 0
+ */
+claw::graphic::premultiplied_image::premultiplied_image()
+{}
+
+/**
+ * \brief Constructor. Creates an image whose pixels are not initialized.
+ * \param w The width of the image.
+ * \param h The height of the image.
+ */
+claw::graphic::premultiplied_image::premultiplied_image(unsigned int w,
+                                                        unsigned int h)
+  : m_pixels(w, h)
+{}
+
+/**
+ * \brief Constructor. Premultiplies the pixels of an image.
+ * \param straight The pixels to premultiply, with straight alpha.
+ */
+claw::graphic::premultiplied_image::premultiplied_image(
+    const const_image_view& straight)
+{
+  assign(straight);
+}
+
+/**
+ * \brief Constructor. Reads an image from a stream and premultiplies its
+ *        pixels.
+ * \param f The stream to read from.
+ */
+claw::graphic::premultiplied_image::premultiplied_image(std::istream& f)
+{
+  load(f);
+}
+
+/**
+ * \brief Swap the content of two images.
+ * \param that The image to swap with.
+ */
+void claw::graphic::premultiplied_image::swap(premultiplied_image& that)
+{
+  m_pixels.swap(that.m_pixels);
+}
+
+/**
+ * \brief Get the width of the image.
+ */
+unsigned int claw::graphic::premultiplied_image::width() const
+{
+  return m_pixels.width();
+}
+
+/**
+ * \brief Get the height of the image.
+ */
+unsigned int claw::graphic::premultiplied_image::height() const
+{
+  return m_pixels.height();
+}
+
+/**
+ * \brief Get a view on the premultiplied pixels of the image.
+ */
+claw::graphic::image_view claw::graphic::premultiplied_image::view()
+{
+  return image_view(m_pixels);
+}
+
+/**
+ * \brief Get a view on the premultiplied pixels of the image.
+ */
+claw::graphic::const_image_view
+claw::graphic::premultiplied_image::view() const
+{
+  return const_image_view(m_pixels);
+}
+
+/**
+ * \brief Replace the pixels of the image with the premultiplied pixels of an
+ *        other image.
+ * \param straight The pixels to premultiply, with straight alpha.
+ */
+void claw::graphic::premultiplied_image::assign(
+    const const_image_view& straight)
+{
+  image result(straight.width(), straight.height());
+
+  for(unsigned int y = 0; y != straight.height(); ++y)
+    pixel_kernels::premultiply(result[y].begin(), straight[y],
+                               straight.width());
+
+  m_pixels.swap(result);
+}
+
+/**
+ * \brief Get a copy of the image with straight alpha, as expected by the
+ *        writers.
+ */
+claw::graphic::image claw::graphic::premultiplied_image::to_image() const
+{
+  image result(width(), height());
+
+  for(unsigned int y = 0; y != height(); ++y)
+    pixel_kernels::unpremultiply(result[y].begin(), m_pixels[y].begin(),
+                                 width());
+
+  return result;
+}
+
+/**
+ * \brief Read the image from a stream and premultiply its pixels.
+ * \param f The stream to read from.
+ *
+ * The format of the stream is detected as in image::load().
+ */
+void claw::graphic::premultiplied_image::load(std::istream& f)
+{
+  image result;
+  format_registry::get_default().load(result, f);
+
+  for(unsigned int y = 0; y != result.height(); ++y)
+    pixel_kernels::premultiply(result[y].begin(), result[y].begin(),
+                               result.width());
+
+  m_pixels.swap(result);
+}
+
+/**
+ * \brief Read the image from a memory area and premultiply its pixels.
+ * \param data The content of the file.
+ * \param size The size of \a data, in bytes.
+ */
+void claw::graphic::premultiplied_image::load(const char* data,
+                                              std::size_t size)
+{
+  imemory_stream f(data, size);
+  load(f);
+}
+
+/**
+ * \brief Merge an image on the current image.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner.
+ */
+void claw::graphic::premultiplied_image::merge(
+    const premultiplied_image& that, const math::coordinate_2d<int>& pos)
+{
+  merge_bands(that, pos, NULL);
+}
+
+/**
+ * \brief Merge an image on the current image, the lines being processed
+ *        concurrently on a thread pool.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner.
+ * \param pool The threads processing the lines.
+ */
+void claw::graphic::premultiplied_image::merge(
+    const premultiplied_image& that, const math::coordinate_2d<int>& pos,
+    thread_pool& pool)
+{
+  merge_bands(that, pos, &pool);
+}
+
+/**
+ * \brief Draw a color over an area of the image.
+ * \param r The area to fill.
+ * \param c The color to draw, with straight alpha.
+ */
+void claw::graphic::premultiplied_image::fill(const math::rectangle<int>& r,
+                                              const rgba_pixel& c)
+{
+  fill_bands(r, c, NULL);
+}
+
+/**
+ * \brief Draw a color over an area of the image, the lines being processed
+ *        concurrently on a thread pool.
+ * \param r The area to fill.
+ * \param c The color to draw, with straight alpha.
+ * \param pool The threads processing the lines.
+ */
+void claw::graphic::premultiplied_image::fill(const math::rectangle<int>& r,
+                                              const rgba_pixel& c,
+                                              thread_pool& pool)
+{
+  fill_bands(r, c, &pool);
+}
+
+/**
+ * \brief Merge an image on the current image.
+ * \param that The pixels to merge.
+ * \param pos The position of the top left corner.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+void claw::graphic::premultiplied_image::merge_bands(
+    const premultiplied_image& that, const math::coordinate_2d<int>& pos,
+    thread_pool* pool)
+{
+  const image_view dest(view().sub_view(
+      math::rectangle<int>(pos.x, pos.y, that.width(), that.height())));
+
+  if(dest.empty())
+    return;
+
+  const const_image_view src(that.view().sub_view(math::rectangle<int>(
+      std::max(-pos.x, 0), std::max(-pos.y, 0), dest.width(), dest.height())));
+
+  parallel_for_lines(
+      pool, dest.height(), detail::min_band_height(dest.width()),
+      [&](std::size_t first_line, std::size_t last_line) -> void
+      {
+        for(std::size_t y = first_line; y != last_line; ++y)
+          pixel_kernels::merge_premultiplied(dest[y], src[y], dest.width());
+      });
+}
+
+/**
+ * \brief Draw a color over an area of the image.
+ * \param r The area to fill.
+ * \param c The color to draw, with straight alpha.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+void claw::graphic::premultiplied_image::fill_bands(
+    const math::rectangle<int>& r, const rgba_pixel& c, thread_pool* pool)
+{
+  const image_view dest(view().sub_view(r));
+
+  if(dest.empty() || (c.components.alpha == 0))
+    return;
+
+  rgba_pixel color;
+  pixel_kernels::premultiply(&color, &c, 1);
+
+  if(color.components.alpha == 255)
+    parallel_for_lines(
+        pool, dest.height(), detail::min_band_height(dest.width()),
+        [&](std::size_t first_line, std::size_t last_line) -> void
+        {
+          for(std::size_t y = first_line; y != last_line; ++y)
+            pixel_kernels::fill(dest[y], dest.width(), color);
+        });
+  else
+    {
+      // The color is merged as a line of pixels of this color.
+      const std::vector<rgba_pixel> line(dest.width(), color);
+
+      parallel_for_lines(
+          pool, dest.height(), detail::min_band_height(dest.width()),
+          [&](std::size_t first_line, std::size_t last_line) -> void
+          {
+            for(std::size_t y = first_line; y != last_line; ++y)
+              pixel_kernels::merge_premultiplied(dest[y], line.data(),
+                                                 dest.width());
+          });
+    }
+}
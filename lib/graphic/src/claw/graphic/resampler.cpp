@@ -0,0 +1,786 @@
+/*
+  CLAW - a C++ Library Absolutely Wonderful
+
+  CLAW is a free library without any particular aim but being useful to
+  anyone.
+
+  Copyright (C) 2005-2011 Julien Jorge
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+  contact: julien.jorge@stuff-o-matic.com
+*/
+/**
+ * \file resampler.cpp
+ * \brief Implementation of the claw::graphic::resampler class.
+ * \author Julien Jorge
+ */
+#include <claw/graphic/resampler.hpp>
+
+#include <claw/assert.hpp>
+#include <claw/parallel_for.hpp>
+#include <claw/graphic/image_view.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define CLAW_RESAMPLER_AVX2
+#endif
+
+namespace claw
+{
+  namespace graphic
+  {
+    /**
+     * \brief Convert a sum of weighted components to a component.
+     * \param sum The sum, including the rounding of the fixed point value.
+     */
+    static inline rgba_pixel::component_type clamp_component(int sum)
+    {
+      const int result = sum >> resampler::precision_bits;
+
+      if(result < 0)
+        return 0;
+      else if(result > 255)
+        return 255;
+      else
+        return result;
+    }
+
+#if defined(__SSE2__)
+    /**
+     * \brief Put two weights in each 32 bits lane of a register, for
+     *        _mm_madd_epi16().
+     * \param a The weight of the even 16 bits lanes.
+     * \param b The weight of the odd 16 bits lanes.
+     */
+    static inline __m128i weight_pair_sse2(std::int16_t a, std::int16_t b)
+    {
+      return _mm_set1_epi32((std::uint16_t)a
+                            | ((std::uint32_t)(std::uint16_t)b << 16));
+    }
+#endif
+
+#if defined(CLAW_RESAMPLER_AVX2)
+    /**
+     * \brief Put two weights in each 32 bits lane of a register, for
+     *        _mm256_madd_epi16().
+     * \param a The weight of the even 16 bits lanes.
+     * \param b The weight of the odd 16 bits lanes.
+     */
+    __attribute__((target("avx2"))) static inline __m256i
+    weight_pair_avx2(std::int16_t a, std::int16_t b)
+    {
+      return _mm256_set1_epi32((std::uint16_t)a
+                               | ((std::uint32_t)(std::uint16_t)b << 16));
+    }
+#endif
+  }
+}
+
+const unsigned int claw::graphic::resampler::precision_bits;
+
+/**
+ * \brief Constructor.
+ * \param f The filter used to compute the destination pixels.
+ */
+claw::graphic::resampler::resampler(filter_type f)
+  : m_filter(f)
+  , m_implementation(pixel_kernels::best_implementation())
+{}
+
+/**
+ * \brief Constructor.
+ * \param f The filter used to compute the destination pixels.
+ * \param impl The implementation of the passes. The fastest implementation
+ *        supported by the processor is used if \a impl is not supported.
+ */
+claw::graphic::resampler::resampler(filter_type f,
+                                    pixel_kernels::implementation impl)
+  : m_filter(f)
+  , m_implementation(std::min(impl, pixel_kernels::best_implementation()))
+{}
+
+/**
+ * \brief Create an image by resizing some pixels.
+ * \param src The pixels to resize.
+ * \param w The width of the resulting image.
+ * \param h The height of the resulting image.
+ * \pre !src.empty() && (w != 0) && (h != 0)
+ */
+claw::graphic::image
+claw::graphic::resampler::scale(const const_image_view& src, unsigned int w,
+                                unsigned int h) const
+{
+  image result(w, h);
+  resample(src, result, NULL);
+  return result;
+}
+
+/**
+ * \brief Create an image by resizing some pixels, the lines being processed
+ *        concurrently on a thread pool.
+ * \param src The pixels to resize.
+ * \param w The width of the resulting image.
+ * \param h The height of the resulting image.
+ * \param pool The threads processing the lines.
+ * \pre !src.empty() && (w != 0) && (h != 0)
+ */
+claw::graphic::image
+claw::graphic::resampler::scale(const const_image_view& src, unsigned int w,
+                                unsigned int h, thread_pool& pool) const
+{
+  image result(w, h);
+  resample(src, result, &pool);
+  return result;
+}
+
+/**
+ * \brief Resize some pixels in other pixels.
+ * \param src The pixels to resize.
+ * \param dest The pixels receiving the result. They must not overlap \a src.
+ * \pre !src.empty() || dest.empty()
+ */
+void claw::graphic::resampler::resample(const const_image_view& src,
+                                        const image_view& dest) const
+{
+  resample(src, dest, NULL);
+}
+
+/**
+ * \brief Resize some pixels in other pixels, the lines being processed
+ *        concurrently on a thread pool.
+ * \param src The pixels to resize.
+ * \param dest The pixels receiving the result. They must not overlap \a src.
+ * \param pool The threads processing the lines.
+ * \pre !src.empty() || dest.empty()
+ */
+void claw::graphic::resampler::resample(const const_image_view& src,
+                                        const image_view& dest,
+                                        thread_pool& pool) const
+{
+  resample(src, dest, &pool);
+}
+
+/**
+ * \brief Resize some pixels in other pixels.
+ * \param src The pixels to resize.
+ * \param dest The pixels receiving the result.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+void claw::graphic::resampler::resample(const const_image_view& src,
+                                        const image_view& dest,
+                                        thread_pool* pool) const
+{
+  CLAW_PRECOND(!src.empty() || dest.empty());
+
+  if(dest.empty())
+    return;
+
+  if((src.width() == dest.width()) && (src.height() == dest.height()))
+    {
+      // Nothing to resize, the lines are copied as they are.
+      const math::coordinate_2d<int> origin(0, 0);
+
+      if(pool == NULL)
+        dest.partial_copy(src, origin);
+      else
+        dest.partial_copy(src, origin, *pool);
+
+      return;
+    }
+
+  weights horizontal;
+  weights vertical;
+
+  compute_weights(src.width(), dest.width(), horizontal);
+  compute_weights(src.height(), dest.height(), vertical);
+
+  if(src.height() == dest.height())
+    horizontal_pass(src, dest, horizontal, pool);
+  else
+    {
+      // Only the source lines contributing to the destination are resized
+      // horizontally.
+      const unsigned int first_line = vertical.first.front();
+      const unsigned int last_line =
+          vertical.first.back() + vertical.count.back();
+      const math::rectangle<int> lines(0, first_line, src.width(),
+                                       last_line - first_line);
+
+      if(src.width() == dest.width())
+        vertical_pass(src.sub_view(lines), dest, first_line, vertical, pool);
+      else
+        {
+          image buffer(dest.width(), last_line - first_line);
+
+          horizontal_pass(src.sub_view(lines), buffer, horizontal, pool);
+          vertical_pass(buffer, dest, first_line, vertical, pool);
+        }
+    }
+}
+
+/**
+ * \brief Resize the lines of some pixels.
+ * \param src The lines to resize.
+ * \param dest The resized lines, as many as in \a src.
+ * \param w The weights of the source pixels.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+void claw::graphic::resampler::horizontal_pass(const const_image_view& src,
+                                               const image_view& dest,
+                                               const weights& w,
+                                               thread_pool* pool) const
+{
+  CLAW_PRECOND(src.height() == dest.height());
+
+  parallel_for_lines(
+      pool, dest.height(), detail::min_band_height(dest.width()),
+      [&](std::size_t first, std::size_t last) -> void
+      {
+        for(std::size_t y = first; y != last; ++y)
+          resample_line(dest[y], src[y], w);
+      });
+}
+
+/**
+ * \brief Resize the columns of some pixels.
+ * \param src The lines contributing to the destination.
+ * \param dest The resized columns.
+ * \param first_line The index of the first line of \a src in the whole
+ *        source, to which the weights are relative.
+ * \param w The weights of the source lines.
+ * \param pool The threads processing the lines, NULL to process them in the
+ *        calling thread.
+ */
+void claw::graphic::resampler::vertical_pass(const const_image_view& src,
+                                             const image_view& dest,
+                                             unsigned int first_line,
+                                             const weights& w,
+                                             thread_pool* pool) const
+{
+  CLAW_PRECOND(src.width() == dest.width());
+
+  parallel_for_lines(
+      pool, dest.height(), detail::min_band_height(dest.width()),
+      [&](std::size_t first, std::size_t last) -> void
+      {
+        std::vector<const rgba_pixel*> lines(w.taps);
+
+        for(std::size_t y = first; y != last; ++y)
+          {
+            for(unsigned int k = 0; k != w.count[y]; ++k)
+              lines[k] = src[w.first[y] - first_line + k];
+
+            combine_lines(dest[y], lines.data(),
+                          &w.values[y * w.taps], w.count[y],
+                          dest.width());
+          }
+      });
+}
+
+/**
+ * \brief Compute the weights of the source pixels for each destination
+ *        pixel, on one axis.
+ * \param in The number of source pixels.
+ * \param out The number of destination pixels.
+ * \param w (out) The weights.
+ *
+ * The weights of a destination pixel are the values of the filter at the
+ * distance of the centers of the source pixels from the center of the
+ * destination pixel. When the pixels are reduced, the filter is stretched
+ * such that every source pixel contributes to the result. The weights are
+ * normalized such that their sum is exactly one in fixed point, a uniform
+ * area thus keeping its color.
+ */
+void claw::graphic::resampler::compute_weights(unsigned int in,
+                                               unsigned int out,
+                                               weights& w) const
+{
+  CLAW_PRECOND(in != 0);
+  CLAW_PRECOND(out != 0);
+
+  const double scale = (double)in / out;
+  const double filter_scale = std::max(scale, 1.0);
+  const double radius = support() * filter_scale;
+  const int one = 1 << precision_bits;
+
+  w.taps = (unsigned int)std::ceil(radius) * 2 + 1;
+  w.first.resize(out);
+  w.count.resize(out);
+  w.values.assign((std::size_t)out * w.taps, 0);
+
+  std::vector<double> d(w.taps);
+
+  for(unsigned int i = 0; i != out; ++i)
+    {
+      const double center = (i + 0.5) * scale;
+      const unsigned int low =
+          (unsigned int)std::max(std::floor(center - radius + 0.5), 0.0);
+      const unsigned int high =
+          (unsigned int)std::min(std::floor(center + radius + 0.5), (double)in);
+      const unsigned int n = high - low;
+
+      CLAW_ASSERT(n <= w.taps, "too many source pixels.");
+
+      double total = 0;
+
+      for(unsigned int j = 0; j != n; ++j)
+        {
+          d[j] = kernel((low + j - center + 0.5) / filter_scale);
+          total += d[j];
+        }
+
+      std::int16_t* const v = &w.values[(std::size_t)i * w.taps];
+      int sum = 0;
+      unsigned int largest = 0;
+
+      for(unsigned int j = 0; j != n; ++j)
+        {
+          v[j] = (std::int16_t)std::lround(d[j] / total * one);
+          sum += v[j];
+
+          if(std::abs(v[j]) > std::abs(v[largest]))
+            largest = j;
+        }
+
+      // The rounding error goes in the largest weight.
+      v[largest] += one - sum;
+
+      // The source pixels with a null weight are not read.
+      unsigned int b = 0;
+      unsigned int e = n;
+
+      while(v[b] == 0)
+        ++b;
+
+      while(v[e - 1] == 0)
+        --e;
+
+      std::copy(v + b, v + e, v);
+      std::fill(v + e - b, v + w.taps, 0);
+
+      w.first[i] = low + b;
+      w.count[i] = e - b;
+    }
+}
+
+/**
+ * \brief Get the half width of the filter, for a scale of one.
+ */
+double claw::graphic::resampler::support() const
+{
+  switch(m_filter)
+    {
+    case box:
+      return 0.5;
+    case bilinear:
+      return 1;
+    case bicubic:
+      return 2;
+    case lanczos:
+      return 3;
+    }
+
+  CLAW_FAIL("unknown filter.");
+  return 0;
+}
+
+/**
+ * \brief Get the value of the filter.
+ * \param x The distance from the center of the filter.
+ */
+double claw::graphic::resampler::kernel(double x) const
+{
+  const double pi = 3.14159265358979323846;
+
+  switch(m_filter)
+    {
+    case box:
+      return ((x > -0.5) && (x <= 0.5)) ? 1 : 0;
+    case bilinear:
+      x = std::abs(x);
+      return (x < 1) ? 1 - x : 0;
+    case bicubic:
+      {
+        const double a = -0.5;
+        x = std::abs(x);
+
+        if(x < 1)
+          return ((a + 2) * x - (a + 3)) * x * x + 1;
+        else if(x < 2)
+          return ((a * x - 5 * a) * x + 8 * a) * x - 4 * a;
+        else
+          return 0;
+      }
+    case lanczos:
+      if(x == 0)
+        return 1;
+      else if((x <= -3) || (x >= 3))
+        return 0;
+      else
+        return 3 * std::sin(pi * x) * std::sin(pi * x / 3) / (pi * pi * x * x);
+    }
+
+  CLAW_FAIL("unknown filter.");
+  return 0;
+}
+
+/**
+ * \brief Resize a line of pixels.
+ * \param dest The resized line.
+ * \param src The line to resize.
+ * \param w The weights of the source pixels.
+ */
+void claw::graphic::resampler::resample_line(rgba_pixel* dest,
+                                             const rgba_pixel* src,
+                                             const weights& w) const
+{
+  // The pixels of a line are computed one by one, the AVX2 registers would
+  // not be filled with the few weights of a pixel.
+  if(m_implementation >= pixel_kernels::sse2)
+    resample_line_sse2(dest, src, w);
+  else
+    resample_line_scalar(dest, src, w);
+}
+
+/**
+ * \brief Resize a line of pixels with the SSE2 instructions.
+ * \param dest The resized line.
+ * \param src The line to resize.
+ * \param w The weights of the source pixels.
+ *
+ * The components of two source pixels are interleaved in 16 bits lanes, such
+ * that each multiplication-addition of pairs of lanes accumulates the
+ * contribution of both pixels to a component.
+ */
+void claw::graphic::resampler::resample_line_sse2(rgba_pixel* dest,
+                                                  const rgba_pixel* src,
+                                                  const weights& w)
+{
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+  const __m128i rounding(_mm_set1_epi32(1 << (precision_bits - 1)));
+
+  for(std::size_t i = 0; i != w.first.size(); ++i)
+    {
+      const rgba_pixel* const s = src + w.first[i];
+      const std::int16_t* const v = &w.values[i * w.taps];
+      const unsigned int count = w.count[i];
+      __m128i sum(rounding);
+      unsigned int k = 0;
+
+      for(; count - k >= 4; k += 4)
+        {
+          const __m128i p(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + k)));
+          const __m128i low(_mm_unpacklo_epi8(p, zero));
+          const __m128i high(_mm_unpackhi_epi8(p, zero));
+
+          sum = _mm_add_epi32(
+              sum,
+              _mm_madd_epi16(_mm_unpacklo_epi16(low, _mm_srli_si128(low, 8)),
+                             weight_pair_sse2(v[k], v[k + 1])));
+          sum = _mm_add_epi32(
+              sum,
+              _mm_madd_epi16(_mm_unpacklo_epi16(high, _mm_srli_si128(high, 8)),
+                             weight_pair_sse2(v[k + 2], v[k + 3])));
+        }
+
+      if(count - k >= 2)
+        {
+          const __m128i p(_mm_unpacklo_epi8(
+              _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + k)), zero));
+
+          sum = _mm_add_epi32(
+              sum, _mm_madd_epi16(_mm_unpacklo_epi16(p, _mm_srli_si128(p, 8)),
+                                  weight_pair_sse2(v[k], v[k + 1])));
+          k += 2;
+        }
+
+      if(k != count)
+        {
+          const __m128i p(
+              _mm_unpacklo_epi8(_mm_cvtsi32_si128(s[k].pixel), zero));
+
+          sum = _mm_add_epi32(
+              sum, _mm_madd_epi16(_mm_unpacklo_epi16(p, zero),
+                                  weight_pair_sse2(v[k], 0)));
+        }
+
+      sum = _mm_srai_epi32(sum, precision_bits);
+      sum = _mm_packs_epi32(sum, sum);
+      dest[i].pixel = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+    }
+#else
+  resample_line_scalar(dest, src, w);
+#endif
+}
+
+/**
+ * \brief Resize a line of pixels, one component at once.
+ * \param dest The resized line.
+ * \param src The line to resize.
+ * \param w The weights of the source pixels.
+ */
+void claw::graphic::resampler::resample_line_scalar(rgba_pixel* dest,
+                                                    const rgba_pixel* src,
+                                                    const weights& w)
+{
+  const int rounding = 1 << (precision_bits - 1);
+
+  for(std::size_t i = 0; i != w.first.size(); ++i)
+    {
+      const rgba_pixel* const s = src + w.first[i];
+      const std::int16_t* const v = &w.values[i * w.taps];
+      int red(rounding);
+      int green(rounding);
+      int blue(rounding);
+      int alpha(rounding);
+
+      for(unsigned int k = 0; k != w.count[i]; ++k)
+        {
+          red += s[k].components.red * v[k];
+          green += s[k].components.green * v[k];
+          blue += s[k].components.blue * v[k];
+          alpha += s[k].components.alpha * v[k];
+        }
+
+      dest[i].components.red = clamp_component(red);
+      dest[i].components.green = clamp_component(green);
+      dest[i].components.blue = clamp_component(blue);
+      dest[i].components.alpha = clamp_component(alpha);
+    }
+}
+
+/**
+ * \brief Compute a line of pixels as the weighted sum of other lines.
+ * \param dest The computed line.
+ * \param lines The lines to combine.
+ * \param w The weights of the lines.
+ * \param count The number of lines to combine.
+ * \param n The number of pixels in the lines.
+ */
+void claw::graphic::resampler::combine_lines(rgba_pixel* dest,
+                                             const rgba_pixel* const* lines,
+                                             const std::int16_t* w,
+                                             unsigned int count,
+                                             std::size_t n) const
+{
+  std::size_t i = 0;
+
+  if(m_implementation >= pixel_kernels::avx2)
+    i = combine_lines_avx2(dest, lines, w, count, i, n);
+
+  if(m_implementation >= pixel_kernels::sse2)
+    i = combine_lines_sse2(dest, lines, w, count, i, n);
+
+  combine_lines_scalar(dest, lines, w, count, i, n);
+}
+
+/**
+ * \brief Compute the blocks of four pixels of a line as the weighted sum of
+ *        other lines, with the SSE2 instructions.
+ * \param dest The computed line.
+ * \param lines The lines to combine.
+ * \param w The weights of the lines.
+ * \param count The number of lines to combine.
+ * \param first The index of the first pixel to compute.
+ * \param last The index past the last pixel to compute.
+ * \return The index of the first pixel not computed.
+ *
+ * The components of two lines are interleaved in 16 bits lanes, such that
+ * each multiplication-addition of pairs of lanes accumulates the
+ * contribution of both lines to a component.
+ */
+std::size_t claw::graphic::resampler::combine_lines_sse2(
+    rgba_pixel* dest, const rgba_pixel* const* lines, const std::int16_t* w,
+    unsigned int count, std::size_t first, std::size_t last)
+{
+  std::size_t x = first;
+
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+  const __m128i rounding(_mm_set1_epi32(1 << (precision_bits - 1)));
+
+  for(; last - x >= 4; x += 4)
+    {
+      __m128i sum[4] = { rounding, rounding, rounding, rounding };
+
+      for(unsigned int k = 0; k < count; k += 2)
+        {
+          // An odd last line is combined with itself with a null weight.
+          const unsigned int next = std::min(k + 1, count - 1);
+          const __m128i weight(
+              weight_pair_sse2(w[k], (next == k) ? 0 : w[next]));
+          const __m128i a(
+              _mm_loadu_si128(reinterpret_cast<const __m128i*>(lines[k] + x)));
+          const __m128i b(_mm_loadu_si128(
+              reinterpret_cast<const __m128i*>(lines[next] + x)));
+          const __m128i a_low(_mm_unpacklo_epi8(a, zero));
+          const __m128i a_high(_mm_unpackhi_epi8(a, zero));
+          const __m128i b_low(_mm_unpacklo_epi8(b, zero));
+          const __m128i b_high(_mm_unpackhi_epi8(b, zero));
+
+          sum[0] = _mm_add_epi32(
+              sum[0], _mm_madd_epi16(_mm_unpacklo_epi16(a_low, b_low), weight));
+          sum[1] = _mm_add_epi32(
+              sum[1], _mm_madd_epi16(_mm_unpackhi_epi16(a_low, b_low), weight));
+          sum[2] = _mm_add_epi32(
+              sum[2],
+              _mm_madd_epi16(_mm_unpacklo_epi16(a_high, b_high), weight));
+          sum[3] = _mm_add_epi32(
+              sum[3],
+              _mm_madd_epi16(_mm_unpackhi_epi16(a_high, b_high), weight));
+        }
+
+      const __m128i low(
+          _mm_packs_epi32(_mm_srai_epi32(sum[0], precision_bits),
+                          _mm_srai_epi32(sum[1], precision_bits)));
+      const __m128i high(
+          _mm_packs_epi32(_mm_srai_epi32(sum[2], precision_bits),
+                          _mm_srai_epi32(sum[3], precision_bits)));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x),
+                       _mm_packus_epi16(low, high));
+    }
+#endif
+
+  return x;
+}
+
+/**
+ * \brief Compute the blocks of eight pixels of a line as the weighted sum of
+ *        other lines, with the AVX2 instructions.
+ * \param dest The computed line.
+ * \param lines The lines to combine.
+ * \param w The weights of the lines.
+ * \param count The number of lines to combine.
+ * \param first The index of the first pixel to compute.
+ * \param last The index past the last pixel to compute.
+ * \return The index of the first pixel not computed.
+ *
+ * See combine_lines_sse2() for the details.
+ */
+#if defined(CLAW_RESAMPLER_AVX2)
+__attribute__((target("avx2")))
+#endif
+std::size_t claw::graphic::resampler::combine_lines_avx2(
+    rgba_pixel* dest, const rgba_pixel* const* lines, const std::int16_t* w,
+    unsigned int count, std::size_t first, std::size_t last)
+{
+  std::size_t x = first;
+
+#if defined(CLAW_RESAMPLER_AVX2)
+  const __m256i zero(_mm256_setzero_si256());
+  const __m256i rounding(_mm256_set1_epi32(1 << (precision_bits - 1)));
+
+  for(; last - x >= 8; x += 8)
+    {
+      __m256i sum[4] = { rounding, rounding, rounding, rounding };
+
+      for(unsigned int k = 0; k < count; k += 2)
+        {
+          const unsigned int next = std::min(k + 1, count - 1);
+          const __m256i weight(
+              weight_pair_avx2(w[k], (next == k) ? 0 : w[next]));
+          const __m256i a(_mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(lines[k] + x)));
+          const __m256i b(_mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(lines[next] + x)));
+          const __m256i a_low(_mm256_unpacklo_epi8(a, zero));
+          const __m256i a_high(_mm256_unpackhi_epi8(a, zero));
+          const __m256i b_low(_mm256_unpacklo_epi8(b, zero));
+          const __m256i b_high(_mm256_unpackhi_epi8(b, zero));
+
+          sum[0] = _mm256_add_epi32(
+              sum[0],
+              _mm256_madd_epi16(_mm256_unpacklo_epi16(a_low, b_low), weight));
+          sum[1] = _mm256_add_epi32(
+              sum[1],
+              _mm256_madd_epi16(_mm256_unpackhi_epi16(a_low, b_low), weight));
+          sum[2] = _mm256_add_epi32(
+              sum[2], _mm256_madd_epi16(_mm256_unpacklo_epi16(a_high, b_high),
+                                        weight));
+          sum[3] = _mm256_add_epi32(
+              sum[3], _mm256_madd_epi16(_mm256_unpackhi_epi16(a_high, b_high),
+                                        weight));
+        }
+
+      // The unpacking and the packing both work in 128 bits lanes, so the
+      // pixels are back in their order.
+      const __m256i low(
+          _mm256_packs_epi32(_mm256_srai_epi32(sum[0], precision_bits),
+                             _mm256_srai_epi32(sum[1], precision_bits)));
+      const __m256i high(
+          _mm256_packs_epi32(_mm256_srai_epi32(sum[2], precision_bits),
+                             _mm256_srai_epi32(sum[3], precision_bits)));
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + x),
+                          _mm256_packus_epi16(low, high));
+    }
+#endif
+
+  return x;
+}
+
+/**
+ * \brief Compute some pixels of a line as the weighted sum of other lines,
+ *        one component at once.
+ * \param dest The computed line.
+ * \param lines The lines to combine.
+ * \param w The weights of the lines.
+ * \param count The number of lines to combine.
+ * \param first The index of the first pixel to compute.
+ * \param last The index past the last pixel to compute.
+ */
+void claw::graphic::resampler::combine_lines_scalar(
+    rgba_pixel* dest, const rgba_pixel* const* lines, const std::int16_t* w,
+    unsigned int count, std::size_t first, std::size_t last)
+{
+  const int rounding = 1 << (precision_bits - 1);
+
+  for(std::size_t x = first; x != last; ++x)
+    {
+      int red(rounding);
+      int green(rounding);
+      int blue(rounding);
+      int alpha(rounding);
+
+      for(unsigned int k = 0; k != count; ++k)
+        {
+          const rgba_pixel& p = lines[k][x];
+
+          red += p.components.red * w[k];
+          green += p.components.green * w[k];
+          blue += p.components.blue * w[k];
+          alpha += p.components.alpha * w[k];
+        }
+
+      dest[x].components.red = clamp_component(red);
+      dest[x].components.green = clamp_component(green);
+      dest[x].components.blue = clamp_component(blue);
+      dest[x].components.alpha = clamp_component(alpha);
+    }
+}
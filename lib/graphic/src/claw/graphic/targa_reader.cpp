@@ -172,6 +172,18 @@ namespace claw
  */
 claw::graphic::targa::reader::reader(image& img)
   : m_image(img)
+  , m_buffer(m_own_buffer)
+{}
+
+/**
+ * \brief Constructor.
+ * \param img The image in which the data will be stored.
+ * \param buffer The storage of the input buffers, reused for each file read
+ *        by this reader. It must outlive this instance.
+ */
+claw::graphic::targa::reader::reader(image& img, std::vector<char>& buffer)
+  : m_image(img)
+  , m_buffer(buffer)
 {}
 
 /**
@@ -182,6 +194,23 @@ claw::graphic::targa::reader::reader(image& img)
  */
 claw::graphic::targa::reader::reader(image& img, std::istream& f)
   : m_image(img)
+  , m_buffer(m_own_buffer)
+{
+  load(f);
+}
+
+/**
+ * \brief Constructor.
+ * \param img The image in which the data will be stored.
+ * \param f The file from which we read the data.
+ * \param buffer The storage of the input buffers. It must outlive this
+ *        instance.
+ * \post img contains the data from \a f.
+ */
+claw::graphic::targa::reader::reader(image& img, std::istream& f,
+                                     std::vector<char>& buffer)
+  : m_image(img)
+  , m_buffer(buffer)
 {
   load(f);
 }
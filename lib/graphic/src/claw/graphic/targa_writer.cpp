@@ -39,18 +39,24 @@ namespace claw
   namespace graphic
   {
     /**
-     * \brief Write a pixel in the stream and set its value in the good order.
-     * \param p The pixel to write.
+     * \brief Store the bytes of a pixel in the order of the file.
+     * \param p The pixel to store.
+     * \param out Where the bytes are stored.
+     * \return The position after the last stored byte.
      *
      * \remark This method is specialized for the pixels of type
      *         claw::graphic::rgba_pixel_32.
      */
     template <>
-    void targa::writer::file_output_buffer<
-        claw::graphic::rgba_pixel_8>::order_pixel_bytes(const pixel_type& p)
+    char* targa::writer::file_output_buffer<claw::graphic::rgba_pixel_8>::
+        store_pixel_bytes(const pixel_type& p, char* out) const
     {
-      m_stream << p.components.blue << p.components.green << p.components.red
-               << p.components.alpha;
+      out[0] = p.components.blue;
+      out[1] = p.components.green;
+      out[2] = p.components.red;
+      out[3] = p.components.alpha;
+
+      return out + 4;
     }
   }
 }
@@ -62,7 +68,7 @@ namespace claw
  * \brief Constructor.
  * \param img The image to save.
  */
-claw::graphic::targa::writer::writer(const image& img)
+claw::graphic::targa::writer::writer(const const_image_view& img)
   : m_image(img)
 {}
 
@@ -72,8 +78,8 @@ claw::graphic::targa::writer::writer(const image& img)
  * \param f The file in which we save the data.
  * \param rle Tell if we must encode the data.
  */
-claw::graphic::targa::writer::writer(const image& img, std::ostream& f,
-                                     bool rle)
+claw::graphic::targa::writer::writer(const const_image_view& img,
+                                     std::ostream& f, bool rle)
   : m_image(img)
 {
   save(f, rle);
@@ -112,8 +118,9 @@ void claw::graphic::targa::writer::save_true_color(std::ostream& os) const
 {
   file_output_buffer<rgba_pixel_8> output_buffer(os);
 
-  for(const_iterator it = m_image.begin(); it != m_image.end(); ++it)
-    output_buffer.order_pixel_bytes(*it);
+  for(unsigned int y = 0; y != m_image.height(); ++y)
+    for(unsigned int x = 0; x != m_image.width(); ++x)
+      output_buffer.order_pixel_bytes(m_image[y][x]);
 }
 
 /**
@@ -125,6 +132,12 @@ void claw::graphic::targa::writer::save_rle_true_color(std::ostream& os) const
   rle32_encoder encoder;
   rle32_encoder::output_buffer_type output_buffer(os);
 
+  if(m_image.width() == 0)
+    return;
+
   for(unsigned int y = 0; y != m_image.height(); ++y)
-    encoder.encode(m_image[y].begin(), m_image[y].end(), output_buffer);
+    {
+      const rgba_pixel_8* const line = &m_image[y][0];
+      encoder.encode(line, line + m_image.width(), output_buffer);
+    }
 }
@@ -54,7 +54,7 @@ claw::graphic::xbm::writer::options::options(
  * \brief Constructor.
  * \param img The image in which the data will be stored.
  */
-claw::graphic::xbm::writer::writer(const image& img)
+claw::graphic::xbm::writer::writer(const const_image_view& img)
   : m_image(img)
 {}
 
@@ -64,8 +64,8 @@ claw::graphic::xbm::writer::writer(const image& img)
  * \param f The file in which we write the data.
  * \param opt Saving options.
  */
-claw::graphic::xbm::writer::writer(const image& img, std::ostream& f,
-                                   const options& opt)
+claw::graphic::xbm::writer::writer(const const_image_view& img,
+                                   std::ostream& f, const options& opt)
   : m_image(img)
 {
   save(f, opt);